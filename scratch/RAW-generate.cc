@@ -47,6 +47,7 @@ Add current RawConfig information into file RawConfiglog.txt
 #include <fstream>
 #include <sys/stat.h>
 #include "ns3/rps.h"
+#include "ns3/raw-group-optimizer.h"
 #include <utility> // std::pair
 #include <map>
 #include <iostream>
@@ -198,6 +199,11 @@ int main (int argc, char *argv[])
   uint32_t beaconinterval;
   string RAWConfigPath;
   uint32_t pageSliceLen, pageSliceCount;
+  bool optimize = false;
+  double trafficInterval = 1000;
+  uint32_t txDuration = 2000;
+  string trafficPath = "";
+  uint32_t payloadSize = 100;
     CommandLine cmd;
     cmd.AddValue ("NRawSta", "number of stations supporting RAW", NRawSta);
     cmd.AddValue ("NGroup", "number of RAW groups", NGroup);
@@ -207,6 +213,11 @@ int main (int argc, char *argv[])
     cmd.AddValue ("RAWConfigPath", "RAW Config file Path", RAWConfigPath);
     cmd.AddValue ("pageSliceCount", "RAW Config file Path", pageSliceCount);
     cmd.AddValue ("pageSliceLen", "RAW Config file Path", pageSliceLen);
+    cmd.AddValue ("Optimize", "choose the RAW groups with RawGroupOptimizer instead of splitting stations evenly", optimize);
+    cmd.AddValue ("TrafficInterval", "traffic interval of each station (ms), used with Optimize without TrafficPath", trafficInterval);
+    cmd.AddValue ("TrafficPath", "traffic file of the simulation (station index and traffic in Mbps per line), used with Optimize", trafficPath);
+    cmd.AddValue ("PayloadSize", "size of the packets of the traffic file (bytes)", payloadSize);
+    cmd.AddValue ("TxDuration", "duration of a frame exchange (us), used with Optimize", txDuration);
 
     cmd.Parse (argc,argv);
     
@@ -218,6 +229,54 @@ int main (int argc, char *argv[])
 
  
     
+  if (optimize)
+    {
+      RawGroupOptimizer optimizer;
+      optimizer.SetBeaconInterval (beaconinterval);
+      optimizer.SetTransmissionDuration (txDuration);
+      //load of every station, in packets per beacon interval
+      std::map<uint16_t, double> load;
+      for (uint16_t aid = 1; aid <= NRawSta; aid++)
+        {
+          load[aid] = beaconinterval / (trafficInterval * 1000);
+        }
+      if (trafficPath != "")
+        {
+          //same format as the TrafficPath of the simulation scripts, where
+          //station i associates with AID i+1
+          ifstream trafficfile (trafficPath);
+          if (!trafficfile.is_open ())
+            {
+              std::cerr << "Unable to open traffic file " << trafficPath << std::endl;
+              return 1;
+            }
+          uint16_t sta_id;
+          double sta_traffic;
+          while (trafficfile >> sta_id >> sta_traffic)
+            {
+              if (sta_id < NRawSta)
+                {
+                  load[sta_id + 1] = beaconinterval * sta_traffic / (payloadSize * 8);
+                }
+            }
+          trafficfile.close ();
+        }
+      for (std::map<uint16_t, double>::const_iterator it = load.begin (); it != load.end (); ++it)
+        {
+          optimizer.AddStation (it->first, it->second);
+        }
+      RPSVector rpsv = optimizer.Optimize ();
+      std::cout << "optimized RAW: " << optimizer.GetNGroups () << " groups, " << optimizer.GetExpectedSuccesses () << " packets per beacon\n";
+      ofstream newfile (RAWConfigPath, ios::out | ios::trunc);
+      RawGroupOptimizer::PrintRawConfig (newfile, rpsv);
+      newfile.close ();
+      for (RPSVector::RPSlist::iterator it = rpsv.rpsset.begin (); it != rpsv.rpsset.end (); ++it)
+        {
+          delete *it;
+        }
+      return 0;
+    }
+
   RAWGroupping (NRawSta, NGroup, NumSlot, trial, RAWConfigPath, beaconinterval, pageSliceCount, pageSliceLen);
     
   return 0;
@@ -0,0 +1,246 @@
+/*
+ * BufferedEventWriter.cc
+ *
+ * Output of the SimulationEventManager records to the nss file and the
+ * ahVisualizer, off the simulation thread.
+ */
+
+#include "BufferedEventWriter.h"
+#include "SimpleTCPClient.h"
+
+#include <iostream>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+
+// pending bytes after which the writer thread is woken up
+static const size_t FLUSH_THRESHOLD = 64 * 1024;
+// pending file bytes after which the simulation waits for the writer thread
+static const size_t MAX_PENDING_FILE = 4 * 1024 * 1024;
+// pending visualizer bytes after which the records are dropped
+static const size_t MAX_PENDING_SOCKET = 1024 * 1024;
+// longest time a record stays in the buffers
+static const std::chrono::milliseconds FLUSH_INTERVAL(500);
+// time between two attempts to connect to the visualizer
+static const std::chrono::seconds RECONNECT_INTERVAL(5);
+// time given to the visualizer to take the last records
+static const int LAST_SEND_TIMEOUT_MS = 1000;
+
+BufferedEventWriter::BufferedEventWriter(string hostname, int port, string filename, bool binary)
+	: hostname(hostname), port(port), filename(filename), binary(binary),
+	  nextConnectAttempt(std::chrono::steady_clock::now()) {
+
+	if(this->filename == "none")
+		this->filename = "";
+	if(this->hostname == "none")
+		this->hostname = "";
+
+	if(this->filename != "") {
+		// truncates the old file
+		file = fopen(this->filename.c_str(), binary ? "wb" : "w");
+		if(file == NULL)
+			std::cerr << "Unable to open " << this->filename << ": " << strerror(errno) << std::endl;
+	}
+
+	if(file != NULL || this->hostname != "")
+		writerThread = std::thread(&BufferedEventWriter::run, this);
+}
+
+void BufferedEventWriter::write(int64_t time, const vector<string>& fields) {
+	if(!writerThread.joinable())
+		return;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	if(file != NULL) {
+		spaceAvailable.wait(lock, [this] { return pendingFile.size() < MAX_PENDING_FILE; });
+		if(binary)
+			appendBinary(pendingFile, time, fields);
+		else
+			appendText(pendingFile, time, fields);
+	}
+	if(hostname != "") {
+		// dropped when the visualizer does not keep up
+		if(pendingSocket.size() < MAX_PENDING_SOCKET)
+			appendText(pendingSocket, time, fields);
+	}
+	if(pendingFile.size() >= FLUSH_THRESHOLD || pendingSocket.size() >= FLUSH_THRESHOLD)
+		dataAvailable.notify_one();
+}
+
+void BufferedEventWriter::run() {
+	string fileData;
+	string socketData;
+	string unsent;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	while(true) {
+		dataAvailable.wait_for(lock, FLUSH_INTERVAL, [this] {
+			return stopping || flushRequested
+					|| pendingFile.size() >= FLUSH_THRESHOLD || pendingSocket.size() >= FLUSH_THRESHOLD;
+		});
+		bool last = stopping;
+		flushRequested = false;
+		writing = true;
+		fileData.swap(pendingFile);
+		socketData.swap(pendingSocket);
+		lock.unlock();
+		spaceAvailable.notify_all();
+
+		if(!fileData.empty()) {
+			writeFile(fileData);
+			fflush(file);
+		}
+		fileData.clear();
+
+		if(unsent.size() + socketData.size() <= MAX_PENDING_SOCKET)
+			unsent.append(socketData);
+		socketData.clear();
+		if(!unsent.empty())
+			writeSocket(unsent, last);
+
+		lock.lock();
+		writing = false;
+		spaceAvailable.notify_all();
+		if(last && pendingFile.empty() && pendingSocket.empty())
+			break;
+	}
+}
+
+void BufferedEventWriter::flush() {
+	if(!writerThread.joinable())
+		return;
+
+	std::unique_lock<std::mutex> lock(mutex);
+	flushRequested = true;
+	dataAvailable.notify_one();
+	spaceAvailable.wait(lock, [this] { return pendingFile.empty() && pendingSocket.empty() && !writing; });
+}
+
+void BufferedEventWriter::writeFile(const string& data) {
+	if(fwrite(data.data(), 1, data.size(), file) != data.size())
+		std::cerr << "Writing " << filename << " failed: " << strerror(errno) << std::endl;
+}
+
+bool BufferedEventWriter::connectSocket() {
+	std::chrono::steady_clock::time_point now = std::chrono::steady_clock::now();
+	if(now < nextConnectAttempt)
+		return false;
+
+	socketDescriptor = stat_connect(hostname.c_str(), std::to_string(port).c_str());
+	if(socketDescriptor == -1) {
+		nextConnectAttempt = now + RECONNECT_INTERVAL;
+		return false;
+	}
+	fcntl(socketDescriptor, F_SETFL, fcntl(socketDescriptor, F_GETFL, 0) | O_NONBLOCK);
+	return true;
+}
+
+void BufferedEventWriter::writeSocket(string& data, bool last) {
+	if(socketDescriptor == -1 && !connectSocket()) {
+		data.clear();
+		return;
+	}
+
+	size_t pos = 0;
+	while(pos < data.size()) {
+		ssize_t sent = ::send(socketDescriptor, data.data() + pos, data.size() - pos, MSG_NOSIGNAL);
+		if(sent >= 0) {
+			pos += sent;
+		}
+		else if(errno == EINTR) {
+			continue;
+		}
+		else if(errno == EAGAIN || errno == EWOULDBLOCK) {
+			// the visualizer is slow: keep the rest for the next flush
+			struct pollfd p = { socketDescriptor, POLLOUT, 0 };
+			if(!last || poll(&p, 1, LAST_SEND_TIMEOUT_MS) <= 0)
+				break;
+		}
+		else {
+			std::cout << "Sending failed" << std::endl;
+			stat_close(socketDescriptor);
+			socketDescriptor = -1;
+			nextConnectAttempt = std::chrono::steady_clock::now() + RECONNECT_INTERVAL;
+			pos = data.size();
+		}
+	}
+	if(last)
+		data.clear();
+	else
+		data.erase(0, pos);
+}
+
+void BufferedEventWriter::appendText(string& buf, int64_t time, const vector<string>& fields) {
+	buf.append(std::to_string(time));
+	buf.push_back(';');
+	for(uint32_t i = 0; i < fields.size(); i++) {
+		buf.append(fields[i]);
+		if(i != fields.size() - 1)
+			buf.push_back(';');
+	}
+	buf.push_back('\n');
+}
+
+void BufferedEventWriter::appendVarint(string& buf, uint64_t value) {
+	while(value >= 0x80) {
+		buf.push_back(static_cast<char>((value & 0x7f) | 0x80));
+		value >>= 7;
+	}
+	buf.push_back(static_cast<char>(value));
+}
+
+void BufferedEventWriter::appendBinary(string& buf, int64_t time, const vector<string>& fields) {
+	appendVarint(buf, static_cast<uint64_t>(time));
+	appendVarint(buf, fields.size());
+	for(uint32_t i = 0; i < fields.size(); i++) {
+		const string& field = fields[i];
+		const char* begin = field.c_str();
+		char* end = NULL;
+
+		// integer, if printing it back gives the same text
+		if(!field.empty() && field.size() < 19 && field.find_first_not_of("-0123456789") == string::npos) {
+			errno = 0;
+			long long value = strtoll(begin, &end, 10);
+			if(errno == 0 && *end == '\0' && std::to_string(value) == field) {
+				buf.push_back(0);
+				appendVarint(buf, (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63));
+				continue;
+			}
+		}
+		// decimal, as printed by std::to_string
+		if(!field.empty() && field.find_first_not_of("-0123456789.") == string::npos) {
+			double value = strtod(begin, &end);
+			if(*end == '\0' && std::to_string(value) == field) {
+				uint64_t bits;
+				memcpy(&bits, &value, sizeof(bits));
+				buf.push_back(1);
+				for(int b = 0; b < 8; b++)
+					buf.push_back(static_cast<char>((bits >> (8 * b)) & 0xff));
+				continue;
+			}
+		}
+		buf.push_back(2);
+		appendVarint(buf, field.size());
+		buf.append(field);
+	}
+}
+
+BufferedEventWriter::~BufferedEventWriter() {
+	if(writerThread.joinable()) {
+		{
+			std::lock_guard<std::mutex> lock(mutex);
+			stopping = true;
+		}
+		dataAvailable.notify_one();
+		writerThread.join();
+	}
+	if(file != NULL)
+		fclose(file);
+	if(socketDescriptor != -1)
+		stat_close(socketDescriptor);
+}
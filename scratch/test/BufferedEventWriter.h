@@ -0,0 +1,84 @@
+/*
+ * BufferedEventWriter.h
+ *
+ * Output of the SimulationEventManager records to the nss file and the
+ * ahVisualizer, off the simulation thread.
+ */
+
+#ifndef SCRATCH_AHSIMULATION_BUFFEREDEVENTWRITER_H_
+#define SCRATCH_AHSIMULATION_BUFFEREDEVENTWRITER_H_
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+
+using namespace std;
+
+/*
+ * The records are encoded by the simulation thread into in-memory buffers,
+ * which a background thread writes to a single persistent file handle and
+ * to a non-blocking socket, either when enough data is pending or every
+ * flush interval.
+ *
+ * The file buffer is bounded: when the writer thread cannot keep up, the
+ * simulation waits for it, so that no record is lost. The visualizer is
+ * best effort: a visualizer which is absent, slow or gone never stalls the
+ * simulation, its records are dropped (and the connection retried later)
+ * instead.
+ *
+ * Binary records (optional, for the file only) are encoded as
+ *   varint(time ns) varint(number of fields) field*
+ * with every field a tag byte followed by
+ *   0: zigzag varint (integer field)
+ *   1: 8 byte little endian IEEE double (decimal field)
+ *   2: varint(length) bytes (any other field)
+ * so they carry exactly the fields of the text records.
+ */
+class BufferedEventWriter {
+
+private:
+	string hostname;
+	int port;
+	string filename;
+	bool binary;
+
+	FILE* file = NULL;
+	int socketDescriptor = -1;
+	std::chrono::steady_clock::time_point nextConnectAttempt;
+
+	std::mutex mutex;
+	std::condition_variable dataAvailable;
+	std::condition_variable spaceAvailable;
+	string pendingFile;
+	string pendingSocket;
+	bool stopping = false;
+	bool flushRequested = false;
+	bool writing = false;
+	std::thread writerThread;
+
+	void run();
+	void writeFile(const string& data);
+	void writeSocket(string& data, bool last);
+	bool connectSocket();
+
+	static void appendText(string& buf, int64_t time, const vector<string>& fields);
+	static void appendBinary(string& buf, int64_t time, const vector<string>& fields);
+	static void appendVarint(string& buf, uint64_t value);
+
+public:
+	BufferedEventWriter(string hostname, int port, string filename, bool binary);
+
+	// encode a record for the file and the visualizer
+	void write(int64_t time, const vector<string>& fields);
+	// wait until the records written so far are in the file and sent
+	void flush();
+
+	virtual ~BufferedEventWriter();
+};
+
+#endif /* SCRATCH_AHSIMULATION_BUFFEREDEVENTWRITER_H_ */
@@ -42,6 +42,7 @@ Configuration::Configuration(int argc, char *argv[]) {
     cmd.AddValue("interfererDevices", "files path of each stations", interfererDevices);
     cmd.AddValue("interfererPacketSize", "files path of each stations", interfererPacketSize);
     cmd.AddValue("mobilityFilename", "files path of each stations", mobilityFilename);
+    cmd.AddValue("NSSBinary", "Write the nss file with the compact binary encoding instead of text", NSSBinary);
 
 /*
     cmd.AddValue("SlotFormat", "format of NRawSlotCount, -1 will auto calculate based on raw slot num", SlotFormat);
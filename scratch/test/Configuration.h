@@ -75,6 +75,7 @@ struct Configuration {
 	string name = "test"; // empty string if no visualization TODO
 	string APPcapFile = "appcap"; // empty string if no visualization TODO
 	string NSSFile = "test.nss";
+	bool NSSBinary = false;
 
 	/*
 	 * Le's config params
@@ -0,0 +1,78 @@
+/*
+ * LatencySketch.cc
+ *
+ * Fixed memory, mergeable latency distribution for the percentile
+ * statistics of the nodes and RAW groups.
+ */
+
+#include "LatencySketch.h"
+#include <cmath>
+#include <algorithm>
+
+const double LatencySketch::ACCURACY = 0.01;
+
+static const double LOG_GAMMA = std::log((1 + LatencySketch::ACCURACY) / (1 - LatencySketch::ACCURACY));
+// 1 µs to 1000 s
+static const int NUMBER_OF_BUCKETS = static_cast<int>(std::ceil(std::log(1e9) / LOG_GAMMA)) + 1;
+
+int LatencySketch::getBucket(Time latency) {
+	double us = latency.GetNanoSeconds() / 1000.0;
+	if(us <= 1)
+		return 0;
+	int bucket = static_cast<int>(std::ceil(std::log(us) / LOG_GAMMA));
+	return std::min(bucket, NUMBER_OF_BUCKETS - 1);
+}
+
+Time LatencySketch::getBucketValue(int bucket) {
+	// the value with the same relative error to both bounds of the bucket
+	double gamma = std::exp(LOG_GAMMA);
+	double us = 2 * std::exp(bucket * LOG_GAMMA) / (gamma + 1);
+	return NanoSeconds(static_cast<int64_t>(std::round(us * 1000)));
+}
+
+void LatencySketch::add(Time latency) {
+	if(buckets.empty())
+		buckets.resize(NUMBER_OF_BUCKETS, 0);
+	buckets[getBucket(latency)]++;
+	if(count == 0 || latency < min)
+		min = latency;
+	if(count == 0 || latency > max)
+		max = latency;
+	count++;
+}
+
+void LatencySketch::merge(const LatencySketch& other) {
+	if(other.count == 0)
+		return;
+	if(buckets.empty())
+		buckets.resize(NUMBER_OF_BUCKETS, 0);
+	for(int i = 0; i < NUMBER_OF_BUCKETS; i++)
+		buckets[i] += other.buckets[i];
+	if(count == 0 || other.min < min)
+		min = other.min;
+	if(count == 0 || other.max > max)
+		max = other.max;
+	count += other.count;
+}
+
+uint64_t LatencySketch::getCount() const {
+	return count;
+}
+
+Time LatencySketch::getQuantile(double q) const {
+	if(count == 0)
+		return Time();
+
+	uint64_t rank = static_cast<uint64_t>(std::floor(std::min(std::max(q, 0.0), 1.0) * (count - 1)));
+	uint64_t seen = 0;
+	for(int i = 0; i < NUMBER_OF_BUCKETS; i++) {
+		seen += buckets[i];
+		if(seen > rank)
+			return std::min(std::max(getBucketValue(i), min), max);
+	}
+	return max;
+}
+
+Time LatencySketch::getMax() const {
+	return max;
+}
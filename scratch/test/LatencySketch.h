@@ -0,0 +1,52 @@
+/*
+ * LatencySketch.h
+ *
+ * Fixed memory, mergeable latency distribution for the percentile
+ * statistics of the nodes and RAW groups.
+ */
+
+#ifndef SCRATCH_AHSIMULATION_LATENCYSKETCH_H_
+#define SCRATCH_AHSIMULATION_LATENCYSKETCH_H_
+
+#include "ns3/nstime.h"
+#include <stdint.h>
+#include <vector>
+
+using namespace std;
+using namespace ns3;
+
+/*
+ * Histogram of latencies with logarithmically sized buckets: bucket i
+ * holds the latencies in ]gamma^(i-1), gamma^i] µs, with
+ * gamma = (1 + ACCURACY) / (1 - ACCURACY), so that any quantile is known
+ * within ACCURACY relative error whatever the number of samples.
+ *
+ * The buckets cover 1 µs to about 1000 s (latencies outside the range are
+ * counted in the first or last bucket) and are only allocated with the
+ * first sample, so the memory used is independent of the packet count.
+ * Sketches of different nodes are merged by adding their buckets.
+ */
+class LatencySketch {
+
+private:
+	vector<uint32_t> buckets;
+	uint64_t count = 0;
+	Time min;
+	Time max;
+
+	static int getBucket(Time latency);
+	static Time getBucketValue(int bucket);
+
+public:
+	static const double ACCURACY;
+
+	void add(Time latency);
+	void merge(const LatencySketch& other);
+
+	uint64_t getCount() const;
+	// q in [0, 1], 0 if there is no sample
+	Time getQuantile(double q) const;
+	Time getMax() const;
+};
+
+#endif /* SCRATCH_AHSIMULATION_LATENCYSKETCH_H_ */
@@ -420,6 +420,7 @@ void NodeEntry::OnTcpPacketReceivedAtAP(Ptr<const Packet> packet) {
 	if(seqTs.GetSeq() > 0) {
 		auto timeDiff = (Simulator::Now() - seqTs.GetTs());
 		stats->get(this->id).TotalPacketSentReceiveTime += timeDiff;
+		stats->get(this->id).DelaySketch.add(timeDiff);
 		stats->get(this->id).NumberOfSuccessfulPacketsWithSeqHeader++;
 		stats->get(this->id).TotalPacketPayloadSize += packet->GetSize();
 	}
@@ -595,6 +596,7 @@ void NodeEntry::OnUdpPacketReceivedAtAP(Ptr<const Packet> packet) {
 			cout << "++++++++++++++++++++++++++++++++++++++++++++++ RX at " << Simulator::Now() << "seq " << seqTs.GetSeq() << endl;
 		stats->get(this->id).NumberOfSuccessfulPackets++;
 		stats->get(this->id).TotalPacketSentReceiveTime += timeDiff;
+		stats->get(this->id).DelaySketch.add(timeDiff);
 		stats->get(this->id).latency = timeDiff;
 		//cout << "id = " << this->id << " ; latency = " << timeDiff << " ; seq =  " << seqTs.GetSeq() << endl;
 		stats->get(this->id).TotalPacketPayloadSize += packet->GetSize();
@@ -623,6 +625,7 @@ void NodeEntry::OnCoapPacketReceivedAtServer(Ptr<const Packet> packet) {
 		stats->get(this->id).NumberOfSuccessfulPacketsWithSeqHeader++;
 		stats->get(this->id).NumberOfSuccessfulPackets++;
 		stats->get(this->id).TotalPacketSentReceiveTime += timeDiff;
+		stats->get(this->id).DelaySketch.add(timeDiff);
 
 		uint32_t currentSequenceNumber = seqTs.GetSeq();
 		if (currentSequenceNumber == 0)
@@ -3,6 +3,7 @@
 
 #include "ns3/core-module.h"
 #include "ns3/drop-reason.h"
+#include "LatencySketch.h"
 #include <numeric>
 
 using namespace std;
@@ -68,6 +69,8 @@ public:
 
     Time TotalPacketSentReceiveTime = Time();
     Time latency = Time();
+    // distribution of TotalPacketSentReceiveTime, for the percentiles
+    LatencySketch DelaySketch;
 
     // for jitter RMS - cumulative sum of abs differences
     uint64_t jitterAcc = 0;
@@ -6,19 +6,12 @@
  */
 
 #include "SimulationEventManager.h"
-#include "SimpleTCPClient.h"
 
-SimulationEventManager::SimulationEventManager()
-	: hostname("localhost"), port(7707), filename("") {
+SimulationEventManager::SimulationEventManager() {
 }
 
-SimulationEventManager::SimulationEventManager(string hostname, int port, string filename)
-	: hostname(hostname), port(port), filename(filename) {
-
-	if(filename != "") {
-		//delete old file
-		std::remove(filename.c_str());
-	}
+SimulationEventManager::SimulationEventManager(string hostname, int port, string filename, bool binary)
+	: writer(std::make_shared<BufferedEventWriter>(hostname, port, filename, binary)) {
 }
 
 
@@ -177,41 +170,38 @@ void SimulationEventManager::onUpdateStatistics(Statistics& stats) {
 	}
 }
 
-void SimulationEventManager::send(vector<string> str) {
-
-	std::stringstream s;
-	s << Simulator::Now().GetNanoSeconds() << ";";
-	for(uint32_t i = 0; i < str.size(); i++) {
-		s << str[i] << ((i != str.size()-1) ? ";" : "");
+void SimulationEventManager::onUpdateLatencyStatistics(Statistics& stats, vector<NodeEntry*>& nodes) {
+	map<int, LatencySketch> groups;
+	for(int i = 0; i < stats.getNumberOfNodes() && i < (int)nodes.size(); i++) {
+		LatencySketch& sketch = stats.get(i).DelaySketch;
+		send({"latencystats", std::to_string(i),
+			std::to_string(sketch.getCount()),
+			std::to_string(sketch.getQuantile(0.5).GetMicroSeconds()),
+			std::to_string(sketch.getQuantile(0.9).GetMicroSeconds()),
+			std::to_string(sketch.getQuantile(0.99).GetMicroSeconds()),
+			std::to_string(sketch.getMax().GetMicroSeconds())
+		});
+		groups[nodes[i]->rawGroupNumber].merge(sketch);
 	}
-	s << "\n";
-
-	if(this->filename != "" && this->filename != "none") {
-		ofstream fileStream(filename,fstream::out|fstream::app);
-		if(fileStream.is_open())
-			fileStream << s.str();
-		// append to file
-		fileStream.close();
+	for(auto& group : groups) {
+		send({"grouplatencystats", std::to_string(group.first),
+			std::to_string(group.second.getCount()),
+			std::to_string(group.second.getQuantile(0.5).GetMicroSeconds()),
+			std::to_string(group.second.getQuantile(0.9).GetMicroSeconds()),
+			std::to_string(group.second.getQuantile(0.99).GetMicroSeconds()),
+			std::to_string(group.second.getMax().GetMicroSeconds())
+		});
 	}
+}
 
-	if(this->hostname != "" && this->hostname != "none") {
-
-		//int sockfd ;
-		if(socketDescriptor == -1) {
-			// std::cout << "Connecting to visualizer" << std::endl;
-			socketDescriptor = stat_connect(this->hostname.c_str(), std::to_string(this->port).c_str());
-			if(socketDescriptor == -1)
-				return;
-		}
-
-		bool success = stat_send(socketDescriptor, string(s.str()).c_str());
+void SimulationEventManager::send(const vector<string>& str) {
+	if(writer)
+		writer->write(Simulator::Now().GetNanoSeconds(), str);
+}
 
-		if(!success) {
-			std::cout << "Sending failed" << std::endl;
-			stat_close(socketDescriptor);
-			socketDescriptor = -1;
-		}
-	}
+void SimulationEventManager::flush() {
+	if(writer)
+		writer->flush();
 }
 
 void SimulationEventManager::onRawConfig (uint32_t rpsIndex, uint32_t rawIndex, RPS::RawAssignment raw)
@@ -327,6 +317,17 @@ void SimulationEventManager::onStatisticsHeader() {
 
 }
 
+void SimulationEventManager::onLatencyStatisticsHeader() {
+	// latencies in µs, STAIndex is the RAW group number in grouplatencystats
+	send({"latencystatsheader", "STAIndex",
+		"NumberOfLatencySamples",
+		"LatencyP50",
+		"LatencyP90",
+		"LatencyP99",
+		"LatencyMax"
+	});
+}
+
 SimulationEventManager::~SimulationEventManager() {
 
 }
@@ -15,23 +15,21 @@
 #include <fstream>
 #include <memory>
 #include "ns3/rps.h"
+#include "BufferedEventWriter.h"
 
 class SimulationEventManager {
 
 private:
 
-	string hostname;
-	int port;
-	string filename;
-
 	Configuration m_config; ///ami
-	int socketDescriptor = -1;
+	// shared by the copies of the manager, closed with the last one
+	std::shared_ptr<BufferedEventWriter> writer;
 
-	void send(vector<string> str);
+	void send(const vector<string>& str);
 
 public:
 	SimulationEventManager();
-	SimulationEventManager(string hostname, int port, string filename);
+	SimulationEventManager(string hostname, int port, string filename, bool binary = false);
 
     void onStartHeader();
 	void onStart(Configuration& config);
@@ -51,8 +49,15 @@ public:
 
 	void onUpdateStatistics(Statistics& stats);
 
+	void onLatencyStatisticsHeader();
+
+	// latency percentiles per node and per RAW group
+	void onUpdateLatencyStatistics(Statistics& stats, vector<NodeEntry*>& nodes);
+
 	void onRawConfig (uint32_t rpsIndex, uint32_t rawIndex, RPS::RawAssignment raw);
 
+	void flush();
+
 	virtual ~SimulationEventManager();
 };
 
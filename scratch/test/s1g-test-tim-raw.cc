@@ -77,48 +77,6 @@ uint32_t GetAssocNum() {
 	return AssocNum;
 }
 
-void PopulateArpCache() {
-	Ptr<ArpCache> arp = CreateObject<ArpCache>();
-	arp->SetAliveTimeout(Seconds(3600 * 24 * 365));
-	for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i) {
-		Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol>();
-		NS_ASSERT(ip != 0);
-		ObjectVectorValue interfaces;
-		ip->GetAttribute("InterfaceList", interfaces);
-		for (ObjectVectorValue::Iterator j = interfaces.Begin();
-				j != interfaces.End(); j++) {
-			Ptr<Ipv4Interface> ipIface =
-					(j->second)->GetObject<Ipv4Interface>();
-			NS_ASSERT(ipIface != 0);
-			Ptr<NetDevice> device = ipIface->GetDevice();
-			NS_ASSERT(device != 0);
-			Mac48Address addr = Mac48Address::ConvertFrom(device->GetAddress());
-			for (uint32_t k = 0; k < ipIface->GetNAddresses(); k++) {
-				Ipv4Address ipAddr = ipIface->GetAddress(k).GetLocal();
-				if (ipAddr == Ipv4Address::GetLoopback())
-					continue;
-				ArpCache::Entry * entry = arp->Add(ipAddr);
-				entry->MarkWaitReply(0);
-				entry->MarkAlive(addr);
-				std::cout << "Arp Cache: Adding the pair (" << addr << ","
-						<< ipAddr << ")" << std::endl;
-			}
-		}
-	}
-	for (NodeList::Iterator i = NodeList::Begin(); i != NodeList::End(); ++i) {
-		Ptr<Ipv4L3Protocol> ip = (*i)->GetObject<Ipv4L3Protocol>();
-		NS_ASSERT(ip != 0);
-		ObjectVectorValue interfaces;
-		ip->GetAttribute("InterfaceList", interfaces);
-		for (ObjectVectorValue::Iterator j = interfaces.Begin();
-				j != interfaces.End(); j++) {
-			Ptr<Ipv4Interface> ipIface =
-					(j->second)->GetObject<Ipv4Interface>();
-			ipIface->SetAttribute("ArpCache", PointerValue(arp));
-		}
-	}
-}
-
 uint16_t ngroup;
 uint16_t nslot;
 RPSVector configureRAW(RPSVector rpslist, string RAWConfigFile) {
@@ -283,6 +241,7 @@ bool check (uint16_t aid, uint32_t index)
 
 void sendStatistics(bool schedule) {
 	eventManager.onUpdateStatistics(stats);
+	eventManager.onUpdateLatencyStatistics(stats, nodes);
 	eventManager.onUpdateSlotStatistics(
 			transmissionsPerTIMGroupAndSlotFromAPSinceLastInterval,
 			transmissionsPerTIMGroupAndSlotFromSTASinceLastInterval);
@@ -386,6 +345,12 @@ void RawSlotTrace(uint8_t oldValue, uint8_t newValue) {
 void configureNodes(NodeContainer& wifiStaNode, NetDeviceContainer& staDevice) {
 	cout << "Configuring STA Node trace sources..." << endl;
 
+	// parsed once, then looked up for each station
+	Config::Path staMac("/NodeList/*/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac");
+	Config::Path phy("/NodeList/*/DeviceList/0/$ns3::WifiNetDevice/Phy");
+	Config::Path stationManager("/NodeList/*/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager");
+	Config::Path phyState("/NodeList/*/DeviceList/0/$ns3::WifiNetDevice/Phy/State");
+
 	for (uint32_t i = 0; i < config.Nsta; i++) {
 
 		cout << "Hooking up trace sources for STA " << i << endl;
@@ -397,88 +362,59 @@ void configureNodes(NodeContainer& wifiStaNode, NetDeviceContainer& staDevice) {
 		n->SetDeassociatedCallback([ = ] {onSTADeassociated(i);});
 
 		nodes.push_back(n);
+		Config::MatchContainer mac = staMac.LookupMatches(i);
+		Config::MatchContainer phyDevice = phy.LookupMatches(i);
+		Config::MatchContainer manager = stationManager.LookupMatches(i);
+		Config::MatchContainer state = phyState.LookupMatches(i);
+
 		// hook up Associated and Deassociated events
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/Assoc",
+		mac.Connect("Assoc",
 				MakeCallback(&NodeEntry::SetAssociation, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/DeAssoc",
+		mac.Connect("DeAssoc",
 				MakeCallback(&NodeEntry::UnsetAssociation, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/NrOfTransmissionsDuringRAWSlot",
+		mac.Connect("NrOfTransmissionsDuringRAWSlot",
 				MakeCallback(
 						&NodeEntry::OnNrOfTransmissionsDuringRAWSlotChanged,
 						n));	//not implem
 
 		//Config::Connect("/NodeList/" + std::to_string(i) + "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/S1gBeaconMissed", MakeCallback(&NodeEntry::OnS1gBeaconMissed, n));
 
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/PacketDropped",
+		mac.Connect("PacketDropped",
 				MakeCallback(&NodeEntry::OnMacPacketDropped, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/Collision",
+		mac.Connect("Collision",
 				MakeCallback(&NodeEntry::OnCollision, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/TransmissionWillCrossRAWBoundary",
+		mac.Connect("TransmissionWillCrossRAWBoundary",
 				MakeCallback(&NodeEntry::OnTransmissionWillCrossRAWBoundary,
 						n)); //?
 
 		// hook up TX
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyTxBegin",
+		phyDevice.Connect("PhyTxBegin",
 				MakeCallback(&NodeEntry::OnPhyTxBegin, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyTxEnd",
+		phyDevice.Connect("PhyTxEnd",
 				MakeCallback(&NodeEntry::OnPhyTxEnd, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyTxDropWithReason",
+		phyDevice.Connect("PhyTxDropWithReason",
 				MakeCallback(&NodeEntry::OnPhyTxDrop, n)); //?
 
 		// hook up RX
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyRxBegin",
+		phyDevice.Connect("PhyRxBegin",
 				MakeCallback(&NodeEntry::OnPhyRxBegin, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyRxEnd",
+		phyDevice.Connect("PhyRxEnd",
 				MakeCallback(&NodeEntry::OnPhyRxEnd, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/PhyRxDropWithReason",
+		phyDevice.Connect("PhyRxDropWithReason",
 				MakeCallback(&NodeEntry::OnPhyRxDrop, n));
 
 		// hook up MAC traces
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/MacTxRtsFailed",
+		manager.Connect("MacTxRtsFailed",
 				MakeCallback(&NodeEntry::OnMacTxRtsFailed, n)); //?
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/MacTxDataFailed",
+		manager.Connect("MacTxDataFailed",
 				MakeCallback(&NodeEntry::OnMacTxDataFailed, n));
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/MacTxFinalRtsFailed",
+		manager.Connect("MacTxFinalRtsFailed",
 				MakeCallback(&NodeEntry::OnMacTxFinalRtsFailed, n)); //?
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/RemoteStationManager/MacTxFinalDataFailed",
+		manager.Connect("MacTxFinalDataFailed",
 				MakeCallback(&NodeEntry::OnMacTxFinalDataFailed, n)); //?
 
 		// hook up PHY State change
-		Config::Connect(
-				"/NodeList/" + std::to_string(i)
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Phy/State/State",
+		state.Connect("State",
 				MakeCallback(&NodeEntry::OnPhyStateChange, n));
 
 	}
@@ -1235,7 +1171,7 @@ int main(int argc, char *argv[]) {
 
 	stats = Statistics(config.Nsta);
 	eventManager = SimulationEventManager(config.visualizerIP,
-			config.visualizerPort, config.NSSFile);
+			config.visualizerPort, config.NSSFile, config.NSSBinary);
 	uint32_t totalRawGroups(0);
 	for (int i = 0; i < config.rps.rpsset.size(); i++) {
 		int nRaw = config.rps.rpsset[i]->GetNumberOfRawGroups();
@@ -1460,28 +1396,20 @@ int main(int argc, char *argv[]) {
 
 	// trace association
 	std::cout << "Configuring trace sources..." << std::endl;
+	Config::Path staMac("/NodeList/*/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac");
 	for (uint16_t kk = 0; kk < config.Nsta; kk++) {
-		std::ostringstream STA;
-		STA << kk;
-		std::string strSTA = STA.str();
-
 		assoc_record *m_assocrecord = new assoc_record;
 		m_assocrecord->setstaid(kk);
-		Config::Connect(
-				"/NodeList/" + strSTA
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/Assoc",
-				MakeCallback(&assoc_record::SetAssoc, m_assocrecord));
-		Config::Connect(
-				"/NodeList/" + strSTA
-						+ "/DeviceList/0/$ns3::WifiNetDevice/Mac/$ns3::RegularWifiMac/$ns3::StaWifiMac/DeAssoc",
-				MakeCallback(&assoc_record::UnsetAssoc, m_assocrecord));
+		Config::MatchContainer mac = staMac.LookupMatches(kk);
+		mac.Connect("Assoc", MakeCallback(&assoc_record::SetAssoc, m_assocrecord));
+		mac.Connect("DeAssoc", MakeCallback(&assoc_record::UnsetAssoc, m_assocrecord));
 		assoc_vector.push_back(m_assocrecord);
 	}
 
-	std::cout << "Populating routing tables..." << std::endl;
-	Ipv4GlobalRoutingHelper::PopulateRoutingTables();
-	std::cout << "Populating ARP cache..." << std::endl;
-	PopulateArpCache();
+	// single subnet: the interface routes and one neighbor table shared by
+	// all the nodes replace the global routing tables and the ARP caches
+	std::cout << "Populating neighbor table..." << std::endl;
+	ArpNeighborTableHelper::InstallAll();
 
 	// configure tracing for associations & other metrics
 	std::cout << "Configuring trace sinks for nodes..." << std::endl;
@@ -1517,15 +1445,9 @@ int main(int argc, char *argv[]) {
 	}
 
 	/*Print of the state of the stations*/
+	Config::Path yansPhyState("/NodeList/*/DeviceList/*/Phy/$ns3::YansWifiPhy/State");
 	for (uint32_t i = 0; i < config.Nsta; i++) {
-		std::ostringstream STA;
-		STA << i;
-		std::string strSTA = STA.str();
-
-		Config::Connect(
-				"/NodeList/" + strSTA
-						+ "/DeviceList/*/Phy/$ns3::YansWifiPhy/State/State",
-				MakeCallback(&PhyStateTrace));
+		yansPhyState.LookupMatches(i).Connect("State", MakeCallback(&PhyStateTrace));
 	}
 
 	eventManager.onStartHeader();
@@ -1542,11 +1464,13 @@ int main(int argc, char *argv[]) {
 
 	eventManager.onAPNodeCreated(apposition.x, apposition.y);
 	eventManager.onStatisticsHeader();
+	eventManager.onLatencyStatisticsHeader();
 
 	sendStatistics(true);
 
 	Simulator::Stop(Seconds(config.simulationTime + config.CoolDownPeriod)); // allow up to a minute after the client & server apps are finished to process the queue
 	Simulator::Run();
+	eventManager.flush();
 
 	// Visualizer throughput
 	int pay = 0, totalSuccessfulPackets = 0, totalSentPackets = 0, totalPacketsEchoed = 0;
@@ -28,6 +28,7 @@
 #include "ns3/socket-factory.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/event-trace.h"
 #include "udp-client.h"
 #include "seq-ts-header.h"
 #include <cstdlib>
@@ -39,6 +40,10 @@ NS_LOG_COMPONENT_DEFINE ("UdpClient");
 
 NS_OBJECT_ENSURE_REGISTERED (UdpClient);
 
+/// Event trace type, see EventTrace
+static const uint16_t g_txEvent =
+  EventTrace::Register ("UdpClient", "Tx", "uid:u size:u seq:u");
+
 TypeId
 UdpClient::GetTypeId (void)
 {
@@ -176,6 +181,7 @@ UdpClient::Send (void)
     {
       ++m_sent;
       this->m_packetSent(p);
+      NS_EVENT_TRACE (g_txEvent, GetNode ()->GetId (), p->GetUid (), m_size, m_sent - 1);
       NS_LOG_INFO ("TraceDelay TX " << m_size << " bytes to "
                                     << peerAddressStringStream.str () << " Uid: "
                                     << p->GetUid () << " Time: "
@@ -28,6 +28,7 @@
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
 #include "ns3/trace-source-accessor.h"
+#include "ns3/event-trace.h"
 #include "udp-echo-client.h"
 #include "seq-ts-header.h"
 
@@ -37,6 +38,12 @@ NS_LOG_COMPONENT_DEFINE ("UdpEchoClientApplication");
 
 NS_OBJECT_ENSURE_REGISTERED (UdpEchoClient);
 
+/// Event trace types, see EventTrace
+static const uint16_t g_sentEvent =
+  EventTrace::Register ("UdpEchoClientApplication", "Sent", "uid:u size:u");
+static const uint16_t g_receivedEvent =
+  EventTrace::Register ("UdpEchoClientApplication", "Received", "uid:u size:u");
+
 TypeId
 UdpEchoClient::GetTypeId (void)
 {
@@ -330,6 +337,7 @@ UdpEchoClient::Send (void)
   m_socket->Send (p);
 
   ++m_sent;
+  NS_EVENT_TRACE (g_sentEvent, GetNode ()->GetId (), p->GetUid (), m_size);
 
   if (Ipv4Address::IsMatchingType (m_peerAddress))
     {
@@ -363,6 +371,7 @@ UdpEchoClient::HandleRead (Ptr<Socket> socket)
   while ((packet = socket->RecvFrom (from)))
     {
 	  m_packetReceived (packet, from);
+      NS_EVENT_TRACE (g_receivedEvent, GetNode ()->GetId (), packet->GetUid (), packet->GetSize ());
       if (InetSocketAddress::IsMatchingType (from))
         {
     	  Ipv4InterfaceAddress iAddr = (GetNode()->GetObject<Ipv4>())->GetAddress(1,0);
@@ -27,6 +27,8 @@
 #include "log.h"
 
 #include <sstream>
+#include <algorithm>
+#include <map>
 
 /**
  * \file
@@ -166,6 +168,13 @@ public:
    * \returns \c true if the index matches the Config Path.
    */
   bool Matches (uint32_t i) const;
+  /**
+   * Test if the Config Path matches a single index.
+   *
+   * \param [out] i The index.
+   * \returns \c true if the Config Path matches only \p i.
+   */
+  bool GetSingle (uint32_t *i) const;
 private:
   /**
    * Convert a string to an \c uint32_t.
@@ -177,6 +186,8 @@ private:
   bool StringToUint32 (std::string str, uint32_t *value) const;
   /** The Config path element. */
   std::string m_element;
+  /** The ranges of indices which match, as [first, last]. */
+  std::vector<std::pair<uint32_t, uint32_t> > m_ranges;
 };
 
 
@@ -184,68 +195,66 @@ ArrayMatcher::ArrayMatcher (std::string element)
   : m_element (element)
 {
   NS_LOG_FUNCTION (this << element);
-}
-bool
-ArrayMatcher::Matches (uint32_t i) const
-{
-  NS_LOG_FUNCTION (this << i);
-  if (m_element == "*")
+  // the alternatives: *, [min-max] or an index
+  std::string::size_type start = 0;
+  while (true)
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches *");
-      return true;
-    }
-  std::string::size_type tmp;
-  tmp = m_element.find ("|");
-  if (tmp != std::string::npos)
-    {
-      std::string left = m_element.substr (0, tmp-0);
-      std::string right = m_element.substr (tmp+1, m_element.size () - (tmp + 1));
-      ArrayMatcher matcher = ArrayMatcher (left);
-      if (matcher.Matches (i))
+      std::string::size_type bar = element.find ("|", start);
+      std::string alternative = element.substr (start, bar == std::string::npos ? std::string::npos : bar - start);
+      std::string::size_type leftBracket = alternative.find ("[");
+      std::string::size_type rightBracket = alternative.find ("]");
+      std::string::size_type dash = alternative.find ("-");
+      uint32_t min;
+      uint32_t max;
+      if (alternative == "*")
         {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<left);
-          return true;
+          m_ranges.push_back (std::make_pair (0, 0xffffffff));
         }
-      matcher = ArrayMatcher (right);
-      if (matcher.Matches (i))
+      else if (leftBracket == 0 && rightBracket == alternative.size () - 1 &&
+               dash > leftBracket && dash < rightBracket)
         {
-          NS_LOG_DEBUG ("Array "<<i<<" matches "<<right);
-          return true;
+          std::string lowerBound = alternative.substr (leftBracket + 1, dash - (leftBracket + 1));
+          std::string upperBound = alternative.substr (dash + 1, rightBracket - (dash + 1));
+          if (StringToUint32 (lowerBound, &min) && StringToUint32 (upperBound, &max))
+            {
+              m_ranges.push_back (std::make_pair (min, max));
+            }
         }
-      NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
-      return false;
+      else if (StringToUint32 (alternative, &min))
+        {
+          m_ranges.push_back (std::make_pair (min, min));
+        }
+      if (bar == std::string::npos)
+        {
+          break;
+        }
+      start = bar + 1;
     }
-  std::string::size_type leftBracket = m_element.find ("[");
-  std::string::size_type rightBracket = m_element.find ("]");
-  std::string::size_type dash = m_element.find ("-");
-  if (leftBracket == 0 && rightBracket == m_element.size () - 1 &&
-      dash > leftBracket && dash < rightBracket)
+}
+bool
+ArrayMatcher::Matches (uint32_t i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  for (std::vector<std::pair<uint32_t, uint32_t> >::const_iterator j = m_ranges.begin (); j != m_ranges.end (); j++)
     {
-      std::string lowerBound = m_element.substr (leftBracket + 1, dash - (leftBracket + 1));
-      std::string upperBound = m_element.substr (dash + 1, rightBracket - (dash + 1));
-      uint32_t min;
-      uint32_t max;
-      if (StringToUint32 (lowerBound, &min) && 
-          StringToUint32 (upperBound, &max) &&
-          i >= min && i <= max)
+      if (i >= j->first && i <= j->second)
         {
           NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
           return true;
         }
-      else
-        {
-          NS_LOG_DEBUG ("Array "<<i<<" does not "<<m_element);
-          return false;
-        }
     }
-  uint32_t value;
-  if (StringToUint32 (m_element, &value) &&
-      i == value)
+  NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
+  return false;
+}
+bool
+ArrayMatcher::GetSingle (uint32_t *i) const
+{
+  NS_LOG_FUNCTION (this << i);
+  if (m_ranges.size () == 1 && m_ranges[0].first == m_ranges[0].second)
     {
-      NS_LOG_DEBUG ("Array "<<i<<" matches "<<m_element);
+      *i = m_ranges[0].first;
       return true;
     }
-  NS_LOG_DEBUG ("Array "<<i<<" does not match "<<m_element);
   return false;
 }
 
@@ -259,6 +268,101 @@ ArrayMatcher::StringToUint32 (std::string str, uint32_t *value) const
   return !iss.bad () && !iss.fail ();
 }
 
+/** An attribute of an object type a path item goes through. */
+struct PathAttribute
+{
+  std::string name;                              //!< The attribute name.
+  const AttributeAccessor *accessor;             //!< Its accessor.
+  bool isPointer;                                //!< Whether it is a pointer, else a container.
+  const ObjectPtrContainerAccessor *container;   //!< The accessor of a container, 0 if unknown.
+};
+
+/**
+ * Get the pointer and container attributes of an object type which match
+ * a path item, in the order they are searched.
+ *
+ * The attributes of the types never change once registered, so they are
+ * looked up once per type and item.
+ *
+ * \param [in] tid The type of the object.
+ * \param [in] item The path item, an attribute name or *.
+ * \returns The matching attributes.
+ */
+static const std::vector<PathAttribute> &
+GetPathAttributes (TypeId tid, const std::string &item)
+{
+  typedef std::map<std::pair<uint16_t, std::string>, std::vector<PathAttribute> > Cache;
+  static Cache cache;
+  std::pair<Cache::iterator, bool> entry =
+    cache.insert (std::make_pair (std::make_pair (tid.GetUid (), item), std::vector<PathAttribute> ()));
+  std::vector<PathAttribute> &attributes = entry.first->second;
+  if (!entry.second)
+    {
+      return attributes;
+    }
+  TypeId nextTid = tid;
+  do
+    {
+      tid = nextTid;
+      for (uint32_t i = 0; i < tid.GetAttributeN (); i++)
+        {
+          struct TypeId::AttributeInformation info = tid.GetAttribute (i);
+          if (info.name != item && item != "*")
+            {
+              continue;
+            }
+          PathAttribute attribute;
+          attribute.name = info.name;
+          attribute.accessor = PeekPointer (info.accessor);
+          attribute.container = dynamic_cast<const ObjectPtrContainerAccessor *> (attribute.accessor);
+          if (dynamic_cast<const PointerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.isPointer = true;
+              attributes.push_back (attribute);
+            }
+          else if (dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker)) != 0)
+            {
+              attribute.isPointer = false;
+              attributes.push_back (attribute);
+            }
+          // this could be anything else and we don't know what to do with it.
+          // So, we just ignore it.
+        }
+      nextTid = tid.GetParent ();
+    } while (nextTid != tid);
+  return attributes;
+}
+
+/**
+ * Split a Config path into its items.
+ *
+ * \param [in] path The Config path.
+ * \param [out] canonical The path with a leading and a trailing slash.
+ * \param [out] items The items between the slashes.
+ */
+static void
+SplitPath (std::string path, std::string *canonical, std::vector<std::string> *items)
+{
+  // ensure that we start and end with a '/'
+  if (path.find ("/") != 0)
+    {
+      path = "/" + path;
+    }
+  if (path.find_last_of ("/") != path.size () - 1)
+    {
+      path = path + "/";
+    }
+  *canonical = path;
+  items->clear ();
+  std::string::size_type start = 1;
+  while (start < path.size ())
+    {
+      std::string::size_type next = path.find ("/", start);
+      items->push_back (path.substr (start, next - start));
+      start = next + 1;
+    }
+}
+
 /**
  * Abstract class to parse Config paths into object references.
  */
@@ -266,11 +370,11 @@ class Resolver
 {
 public:
   /**
-   * Construct from a base Config path.
+   * Construct from the items of a Config path.
    *
-   * \param [in] path The Config path.
+   * \param [in] items The items between the slashes of the Config path.
    */
-  Resolver (std::string path);
+  Resolver (const std::vector<std::string> &items);
   /** Destructor. */
   virtual ~Resolver ();
 
@@ -284,23 +388,22 @@ public:
   void Resolve (Ptr<Object> root);
   
 private:
-  /** Ensure the Config path starts and ends with a '/'. */
-  void Canonicalize (void);
   /**
    * Parse the next element in the Config path.
    *
-   * \param [in] path The remaining portion of the Config path.
+   * \param [in] pos The position of the next item of the Config path.
    * \param [in] root The object corresponding to the current positon
    *                  in the Config path.
    */
-  void DoResolve (std::string path, Ptr<Object> root);
+  void DoResolve (uint32_t pos, Ptr<Object> root);
   /**
    * Parse an index on the Config path.
    *
-   * \param [in] path The remaining Config path.
-   * \param [in,out] vector The resulting list of matching objects.
+   * \param [in] pos The position of the index item of the Config path.
+   * \param [in] root The object holding the container.
+   * \param [in] attribute The container attribute.
    */
-  void DoArrayResolve (std::string path, const ObjectPtrContainerValue &vector);
+  void DoArrayResolve (uint32_t pos, Ptr<Object> root, const PathAttribute &attribute);
   /**
    * Handle one object found on the path.
    *
@@ -323,46 +426,26 @@ private:
 
   /** Current list of path tokens. */
   std::vector<std::string> m_workStack;
-  /** The Config path. */
-  std::string m_path;
+  /** The items of the Config path. */
+  const std::vector<std::string> &m_items;
 };
 
-Resolver::Resolver (std::string path)
-  : m_path (path)
+Resolver::Resolver (const std::vector<std::string> &items)
+  : m_items (items)
 {
-  NS_LOG_FUNCTION (this << path);
-  Canonicalize ();
+  NS_LOG_FUNCTION (this << &items);
 }
 Resolver::~Resolver ()
 {
   NS_LOG_FUNCTION (this);
 }
-void
-Resolver::Canonicalize (void)
-{
-  NS_LOG_FUNCTION (this);
-
-  // ensure that we start and end with a '/'
-  std::string::size_type tmp = m_path.find ("/");
-  if (tmp != 0)
-    {
-      // no slash at start
-      m_path = "/" + m_path;
-    }
-  tmp = m_path.find_last_of ("/");
-  if (tmp != (m_path.size () - 1))
-    {
-      // no slash at end
-      m_path = m_path + "/";
-    }
-}
 
 void 
 Resolver::Resolve (Ptr<Object> root)
 {
   NS_LOG_FUNCTION (this << root);
 
-  DoResolve (m_path, root);
+  DoResolve (0, root);
 }
 
 std::string
@@ -388,13 +471,11 @@ Resolver::DoResolveOne (Ptr<Object> object)
 }
 
 void
-Resolver::DoResolve (std::string path, Ptr<Object> root)
+Resolver::DoResolve (uint32_t pos, Ptr<Object> root)
 {
-  NS_LOG_FUNCTION (this << path << root);
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
+  NS_LOG_FUNCTION (this << pos << root);
 
-  if (next == std::string::npos)
+  if (pos == m_items.size ())
     {
       //
       // If root is zero, we're beginning to see if we can use the object name 
@@ -410,8 +491,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
         }
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  const std::string &item = m_items[pos];
 
   //
   // If root is zero, we're beginning to see if we can use the object name 
@@ -422,11 +502,10 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
   //
   if (root == 0)
     {
-      std::string::size_type offset = path.find ("/Names");
-      if (offset == 0)
+      if (item.compare (0, 5, "Names") == 0)
         {
           m_workStack.push_back (item);
-          DoResolve (pathLeft, root);
+          DoResolve (pos + 1, root);
           m_workStack.pop_back ();
           return;
         }
@@ -443,7 +522,7 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
     {
       NS_LOG_DEBUG ("Name system resolved item = " << item << " to " << namedObject);
       m_workStack.push_back (item);
-      DoResolve (pathLeft, namedObject);
+      DoResolve (pos + 1, namedObject);
       m_workStack.pop_back ();
       return;
     }
@@ -473,69 +552,42 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
           return;
         }
       m_workStack.push_back (item);
-      DoResolve (pathLeft, object);
+      DoResolve (pos + 1, object);
       m_workStack.pop_back ();
     }
   else 
     {
       // this is a normal attribute.
-      TypeId tid;
-      TypeId nextTid = root->GetInstanceTypeId ();
-      bool foundMatch = false;
-      
-      do
+      const std::vector<PathAttribute> &attributes = GetPathAttributes (root->GetInstanceTypeId (), item);
+      for (std::vector<PathAttribute>::const_iterator i = attributes.begin (); i != attributes.end (); i++)
         {
-          tid = nextTid;
-          
-          for (uint32_t i = 0; i < tid.GetAttributeN(); i++)
+          if (i->isPointer)
             {
-              struct TypeId::AttributeInformation info;
-              info = tid.GetAttribute(i);
-              if (info.name != item && item != "*")
+              NS_LOG_DEBUG ("GetAttribute(ptr)="<<i->name<<" on path="<<GetResolvedPath ());
+              PointerValue ptr;
+              i->accessor->Get (PeekPointer (root), ptr);
+              Ptr<Object> object = ptr.Get<Object> ();
+              if (object == 0)
                 {
+                  NS_LOG_ERROR ("Requested object name=\""<<item<<
+                                "\" exists on path=\""<<GetResolvedPath ()<<"\""
+                                " but is null.");
                   continue;
                 }
-              // attempt to cast to a pointer checker.
-              const PointerChecker *ptr = dynamic_cast<const PointerChecker *> (PeekPointer (info.checker));
-              if (ptr != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(ptr)="<<info.name<<" on path="<<GetResolvedPath ());
-                  PointerValue ptr;
-                  root->GetAttribute (info.name, ptr);
-                  Ptr<Object> object = ptr.Get<Object> ();
-                  if (object == 0)
-                    {
-                      NS_LOG_ERROR ("Requested object name=\""<<item<<
-                                    "\" exists on path=\""<<GetResolvedPath ()<<"\""
-                                    " but is null.");
-                      continue;
-                    }
-                  foundMatch = true;
-                  m_workStack.push_back (info.name);
-                  DoResolve (pathLeft, object);
-                  m_workStack.pop_back ();
-                }
-              // attempt to cast to an object vector.
-              const ObjectPtrContainerChecker *vectorChecker = 
-                dynamic_cast<const ObjectPtrContainerChecker *> (PeekPointer (info.checker));
-              if (vectorChecker != 0)
-                {
-                  NS_LOG_DEBUG ("GetAttribute(vector)="<<info.name<<" on path="<<GetResolvedPath () << pathLeft);
-                  foundMatch = true;
-                  ObjectPtrContainerValue vector;
-                  root->GetAttribute (info.name, vector);
-                  m_workStack.push_back (info.name);
-                  DoArrayResolve (pathLeft, vector);
-                  m_workStack.pop_back ();
-                }
-              // this could be anything else and we don't know what to do with it.
-              // So, we just ignore it.
+              m_workStack.push_back (i->name);
+              DoResolve (pos + 1, object);
+              m_workStack.pop_back ();
             }
-
-          nextTid = tid.GetParent ();
-        } while (nextTid != tid);
+          else
+            {
+              NS_LOG_DEBUG ("GetAttribute(vector)="<<i->name<<" on path="<<GetResolvedPath ());
+              m_workStack.push_back (i->name);
+              DoArrayResolve (pos + 1, root, *i);
+              m_workStack.pop_back ();
+            }
+        }
       
-      if (!foundMatch)
+      if (attributes.empty ())
         {
           NS_LOG_DEBUG ("Requested item="<<item<<" does not exist on path="<<GetResolvedPath ());
           return;
@@ -544,20 +596,37 @@ Resolver::DoResolve (std::string path, Ptr<Object> root)
 }
 
 void 
-Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &container)
+Resolver::DoArrayResolve (uint32_t pos, Ptr<Object> root, const PathAttribute &attribute)
 {
-  NS_LOG_FUNCTION(this << path << &container);
-  NS_ASSERT (path != "");
-  NS_ASSERT ((path.find ("/")) == 0);
-  std::string::size_type next = path.find ("/", 1);
-  if (next == std::string::npos)
+  NS_LOG_FUNCTION (this << pos << root << attribute.name);
+  if (pos == m_items.size ())
     {
       return;
     }
-  std::string item = path.substr (1, next-1);
-  std::string pathLeft = path.substr (next, path.size ()-next);
+  const std::string &item = m_items[pos];
 
   ArrayMatcher matcher = ArrayMatcher (item);
+  uint32_t single;
+  uint32_t n;
+  if (matcher.GetSingle (&single) && attribute.container != 0 &&
+      attribute.container->GetN (PeekPointer (root), &n) && single < n)
+    {
+      // the indices of most containers are the positions
+      uint32_t index;
+      Ptr<Object> object = attribute.container->GetItem (PeekPointer (root), single, &index);
+      if (index == single)
+        {
+          std::ostringstream oss;
+          oss << index;
+          m_workStack.push_back (oss.str ());
+          DoResolve (pos + 1, object);
+          m_workStack.pop_back ();
+          return;
+        }
+    }
+
+  ObjectPtrContainerValue container;
+  attribute.accessor->Get (PeekPointer (root), container);
   ObjectPtrContainerValue::Iterator it;
   for (it = container.Begin (); it != container.End (); ++it)
     {
@@ -566,7 +635,7 @@ Resolver::DoArrayResolve (std::string path, const ObjectPtrContainerValue &conta
           std::ostringstream oss;
           oss << (*it).first;
           m_workStack.push_back (oss.str ());
-          DoResolve (pathLeft, (*it).second);
+          DoResolve (pos + 1, (*it).second);
           m_workStack.pop_back ();
         }
     }
@@ -588,6 +657,14 @@ public:
   void Disconnect (std::string path, const CallbackBase &cb);
   /** \copydoc Config::LookupMatches() */
   Config::MatchContainer LookupMatches (std::string path);
+  /**
+   * Look up the objects which match a split Config path.
+   *
+   * \param [in] items The items of the Config path.
+   * \param [in] path The Config path, for the returned container.
+   * \returns A container with all the objects which match the path.
+   */
+  Config::MatchContainer LookupMatches (const std::vector<std::string> &items, std::string path);
 
   /** \copydoc Config::RegisterRootNamespaceObject() */
   void RegisterRootNamespaceObject (Ptr<Object> obj);
@@ -681,11 +758,21 @@ Config::MatchContainer
 ConfigImpl::LookupMatches (std::string path)
 {
   NS_LOG_FUNCTION (this << path);
+  std::string canonical;
+  std::vector<std::string> items;
+  SplitPath (path, &canonical, &items);
+  return LookupMatches (items, path);
+}
+
+Config::MatchContainer 
+ConfigImpl::LookupMatches (const std::vector<std::string> &items, std::string path)
+{
+  NS_LOG_FUNCTION (this << &items << path);
   class LookupMatchesResolver : public Resolver 
   {
   public:
-    LookupMatchesResolver (std::string path)
-      : Resolver (path)
+    LookupMatchesResolver (const std::vector<std::string> &items)
+      : Resolver (items)
     {}
     virtual void DoOne (Ptr<Object> object, std::string path) {
       m_objects.push_back (object);
@@ -693,7 +780,7 @@ ConfigImpl::LookupMatches (std::string path)
     }
     std::vector<Ptr<Object> > m_objects;
     std::vector<std::string> m_contexts;
-  } resolver = LookupMatchesResolver (path);
+  } resolver = LookupMatchesResolver (items);
   for (Roots::const_iterator i = m_roots.begin (); i != m_roots.end (); i++)
     {
       resolver.Resolve (*i);
@@ -849,6 +936,41 @@ Config::MatchContainer LookupMatches (std::string path)
   return ConfigImpl::Get ()->LookupMatches (path);
 }
 
+Path::Path (std::string path)
+{
+  NS_LOG_FUNCTION (this << path);
+  SplitPath (path, &m_path, &m_items);
+  m_wildcard = std::find (m_items.begin (), m_items.end (), "*") - m_items.begin ();
+}
+std::string
+Path::GetPath (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_path;
+}
+MatchContainer
+Path::LookupMatches (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return ConfigImpl::Get ()->LookupMatches (m_items, m_path);
+}
+MatchContainer
+Path::LookupMatches (uint32_t index) const
+{
+  NS_LOG_FUNCTION (this << index);
+  NS_ASSERT_MSG (m_wildcard < m_items.size (), "No * item in " << m_path);
+  std::vector<std::string> items = m_items;
+  std::ostringstream oss;
+  oss << index;
+  items[m_wildcard] = oss.str ();
+  std::string path = "/";
+  for (std::vector<std::string>::const_iterator i = items.begin (); i != items.end (); i++)
+    {
+      path += *i + "/";
+    }
+  return ConfigImpl::Get ()->LookupMatches (items, path);
+}
+
 void RegisterRootNamespaceObject (Ptr<Object> obj)
 {
   NS_LOG_FUNCTION (obj);
@@ -258,6 +258,49 @@ private:
  */
 MatchContainer LookupMatches (std::string path);
 
+/**
+ * \ingroup config
+ * \brief A path to match objects, parsed once to be looked up many times.
+ *
+ * The functions taking a path string parse it again on every call. A Path
+ * keeps the parsed path; it can be looked up as it is or with its first
+ * \c * item bound to an index. Setting up a different sink for each of N
+ * nodes thus takes a single Path with \c * as the NodeList index, looked
+ * up for every node index in turn: each lookup walks down a single node
+ * rather than matching the index against the whole NodeList.
+ *
+ * The attributes a path item goes through are looked up once per object
+ * type, whatever the path, and an index which selects a single object of a
+ * container gets it without copying the container.
+ */
+class Path
+{
+public:
+  /**
+   * \param [in] path The path to match objects, as for LookupMatches.
+   */
+  Path (std::string path);
+
+  /**
+   * \returns The path, with a leading and a trailing slash.
+   */
+  std::string GetPath (void) const;
+  /**
+   * \returns A container with all the objects which match the path.
+   */
+  MatchContainer LookupMatches (void) const;
+  /**
+   * \param [in] index The index the first \c * item of the path stands for.
+   * \returns A container with all the objects which match the path.
+   */
+  MatchContainer LookupMatches (uint32_t index) const;
+
+private:
+  std::string m_path;                //!< The canonical path.
+  std::vector<std::string> m_items;  //!< The items between the slashes.
+  uint32_t m_wildcard;               //!< The first * item, or the item count.
+};
+
 /**
  * \ingroup config
  * \param [in] obj A new root object
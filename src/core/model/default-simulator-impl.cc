@@ -28,6 +28,7 @@
 #include "assert.h"
 #include "log.h"
 
+#include <algorithm>
 #include <cmath>
 
 
@@ -71,7 +72,7 @@ DefaultSimulatorImpl::DefaultSimulatorImpl ()
   m_currentTs = 0;
   m_currentContext = 0xffffffff;
   m_unscheduledEvents = 0;
-  m_eventsWithContextEmpty = true;
+  m_eventsWithContext = 0;
   m_main = SystemThread::Self();
 }
 
@@ -158,34 +159,48 @@ DefaultSimulatorImpl::IsFinished (void) const
   return m_events->IsEmpty () || m_stop;
 }
 
+bool
+DefaultSimulatorImpl::EarlierEventWithContext (const EventWithContext *a, const EventWithContext *b)
+{
+  return a->timestamp < b->timestamp;
+}
+
 void
 DefaultSimulatorImpl::ProcessEventsWithContext (void)
 {
-  if (m_eventsWithContextEmpty)
+  if (m_eventsWithContext.load (std::memory_order_relaxed) == 0)
     {
       return;
     }
 
-  // swap queues
-  EventsWithContext eventsWithContext;
-  {
-    CriticalSection cs (m_eventsWithContextMutex);
-    m_eventsWithContext.swap(eventsWithContext);
-    m_eventsWithContextEmpty = true;
-  }
-  while (!eventsWithContext.empty ())
+  // take them all, most recent first
+  EventWithContext *top = m_eventsWithContext.exchange (0, std::memory_order_acquire);
+  for (EventWithContext *event = top; event != 0; event = event->next)
+    {
+      m_eventsWithContextBatch.push_back (event);
+    }
+  // in time order, in the order they were pushed for a given time
+  std::reverse (m_eventsWithContextBatch.begin (), m_eventsWithContextBatch.end ());
+  if (m_eventsWithContextBatch.size () > 1)
+    {
+      std::stable_sort (m_eventsWithContextBatch.begin (), m_eventsWithContextBatch.end (),
+                        &DefaultSimulatorImpl::EarlierEventWithContext);
+    }
+  for (std::vector<EventWithContext *>::const_iterator i = m_eventsWithContextBatch.begin ();
+       i != m_eventsWithContextBatch.end (); i++)
     {
-       EventWithContext event = eventsWithContext.front ();
-       eventsWithContext.pop_front ();
+       EventWithContext *event = *i;
        Scheduler::Event ev;
-       ev.impl = event.event;
-       ev.key.m_ts = m_currentTs + event.timestamp;
-       ev.key.m_context = event.context;
+       ev.impl = event->event;
+       ev.key.m_ts = m_currentTs + event->timestamp;
+       ev.key.m_context = event->context;
        ev.key.m_uid = m_uid;
        m_uid++;
        m_unscheduledEvents++;
        m_events->Insert (ev);
+       delete event;
     }
+  m_eventsWithContextBatch.clear ();
 }
 
 void
@@ -264,16 +279,17 @@ DefaultSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay,
     }
   else
     {
-      EventWithContext ev;
-      ev.context = context;
+      EventWithContext *ev = new EventWithContext;
+      ev->context = context;
       // Current time added in ProcessEventsWithContext()
-      ev.timestamp = delay.GetTimeStep ();
-      ev.event = event;
-      {
-        CriticalSection cs (m_eventsWithContextMutex);
-        m_eventsWithContext.push_back(ev);
-        m_eventsWithContextEmpty = false;
-      }
+      ev->timestamp = delay.GetTimeStep ();
+      ev->event = event;
+      ev->next = m_eventsWithContext.load (std::memory_order_relaxed);
+      while (!m_eventsWithContext.compare_exchange_weak (ev->next, ev,
+                                                         std::memory_order_release,
+                                                         std::memory_order_relaxed))
+        {
+        }
     }
 }
 
@@ -25,11 +25,12 @@
 #include "scheduler.h"
 #include "event-impl.h"
 #include "system-thread.h"
-#include "ns3/system-mutex.h"
 
 #include "ptr.h"
 
+#include <atomic>
 #include <list>
+#include <vector>
 
 /**
  * \file
@@ -94,18 +95,24 @@ private:
     uint64_t timestamp;
     /** The event implementation. */
     EventImpl *event;
+    /** The event pushed before this one. */
+    EventWithContext *next;
   };
-  /** Container type for the events from a different context. */
-  typedef std::list<struct EventWithContext> EventsWithContext;
-  /** The container of events from a different context. */
-  EventsWithContext m_eventsWithContext;
   /**
-   * Flag \c true if all events with context have been moved to the
-   * primary event queue.
+   * Compare the delays of the events from a different context.
+   * \param a an event
+   * \param b another event
+   * \return \c true if \p a expires before \p b
    */
-  bool m_eventsWithContextEmpty;
-  /** Mutex to control access to the list of events with context. */
-  SystemMutex m_eventsWithContextMutex;
+  static bool EarlierEventWithContext (const EventWithContext *a, const EventWithContext *b);
+  /**
+   * The events from a different context, as a lock-free stack: the other
+   * threads push their events with a compare and swap on the top and the
+   * main thread takes them all at once.
+   */
+  std::atomic<EventWithContext *> m_eventsWithContext;
+  /** The events taken from the stack, kept to reuse its memory. */
+  std::vector<EventWithContext *> m_eventsWithContextBatch;
 
   /** Container type for the events to run at Simulator::Destroy() */
   typedef std::list<EventId> DestroyEvents;
@@ -20,6 +20,8 @@
 
 #include "event-impl.h"
 #include "log.h"
+#include "assert.h"
+#include "memory-pool.h"
 
 /**
  * \file
@@ -31,6 +33,24 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("EventImpl");
 
+void *
+EventImpl::operator new (std::size_t size)
+{
+  return MemoryPool::Allocate (size);
+}
+
+void
+EventImpl::operator delete (void *p, std::size_t size)
+{
+  MemoryPool::Deallocate (p, size);
+}
+
+uint64_t
+EventImpl::GetNSystemAllocations (void)
+{
+  return MemoryPool::GetNSystemAllocations ();
+}
+
 EventImpl::~EventImpl ()
 {
   NS_LOG_FUNCTION (this);
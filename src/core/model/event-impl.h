@@ -21,7 +21,9 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <cstddef>
 #include "simple-ref-count.h"
+#include "memory-pool.h"
 
 /**
  * \file
@@ -40,6 +42,9 @@ namespace ns3 {
  * when it reaches the time associated to this event. Most subclasses
  * are usually created by one of the many Simulator::Schedule
  * methods.
+ *
+ * The memory of the events is recycled: events up to MAX_POOLED_SIZE
+ * bytes are allocated from the MemoryPool.
  */
 class EventImpl : public SimpleRefCount<EventImpl>
 {
@@ -66,6 +71,30 @@ public:
    */
   bool IsCancelled (void);
 
+  /**
+   * Allocate the memory of an event from the MemoryPool.
+   *
+   * \param [in] size The size of the event.
+   * \returns The memory of the event.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * Give the memory of an event back to the MemoryPool.
+   *
+   * \param [in] p The memory of the event.
+   * \param [in] size The size of the event.
+   */
+  static void operator delete (void *p, std::size_t size);
+  /**
+   * \returns The number of times the MemoryPool, which also serves other
+   *          objects than events, obtained memory from the system
+   *          allocator.
+   */
+  static uint64_t GetNSystemAllocations (void);
+
+  /** Largest event allocated from the free lists, in bytes. */
+  static const std::size_t MAX_POOLED_SIZE = MemoryPool::MAX_SIZE;
+
 protected:
   /**
    * Implementation for Invoke().
@@ -0,0 +1,556 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "event-trace.h"
+#include "simulator.h"
+#include "abort.h"
+#include "log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+/**
+ * \file
+ * \ingroup tracing
+ * Implementation of the binary event trace, ns3::EventTrace and
+ * ns3::EventTraceReader.
+ *
+ * The file starts with a header: the magic "NS3EVTR", the format version,
+ * a byte order mark, the record size and the time resolution, all 32 bit
+ * integers in the byte order of the writer. Then come chunks of two kinds,
+ * starting with a tag byte:
+ *  - 'T', an event type: its id and component id (16 bit), then the
+ *    component name, the event name and the fields, as strings of a 16 bit
+ *    length and the characters;
+ *  - 'R', a block of records: the number of records (32 bit), then the
+ *    records as EventTrace::Record.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("EventTrace");
+
+namespace {
+
+/** The magic bytes at the start of a file. */
+const char MAGIC[8] = { 'N', 'S', '3', 'E', 'V', 'T', 'R', '\0' };
+/** The version of the format. */
+const uint32_t FORMAT_VERSION = 1;
+/** The byte order mark. */
+const uint32_t BYTE_ORDER_MARK = 0x01020304;
+/** The number of records of a block. */
+const uint32_t BLOCK_RECORDS = 4096;
+/** The number of blocks shared by the threads and the writer. */
+const uint32_t MAX_BLOCKS = 16;
+
+/** A block of records, filled by a single thread. */
+struct Block
+{
+  EventTrace::Record records[BLOCK_RECORDS]; //!< The records.
+  uint32_t size;                             //!< The number of records.
+  bool inUse;                                //!< Whether a thread fills it.
+};
+
+/** The event types and the state of the open file. */
+struct State
+{
+  State ()
+    : file (0),
+      stopping (false),
+      nWrittenTypes (0),
+      generation (0)
+  {
+  }
+  /**
+   * Close the file, if a program opened it and exits without closing it,
+   * so that the writer thread is joined before it is destroyed.
+   */
+  ~State ()
+  {
+    Close ();
+  }
+
+  /** Write the pending blocks, stop the writer and close the file. */
+  void Close (void);
+
+  std::mutex mutex;                   //!< Protects all the fields but generation.
+  std::condition_variable queued;     //!< Notified when a block is queued, or on close.
+  std::condition_variable available;  //!< Notified when a block is free again.
+
+  std::vector<EventTrace::Type> types;  //!< The event types, by id.
+
+  FILE *file;                   //!< The open file.
+  std::string filename;         //!< Its name.
+  std::thread writer;           //!< The thread writing the blocks.
+  bool stopping;                //!< Whether the file is being closed.
+  uint32_t nWrittenTypes;       //!< The types written to the file.
+  std::vector<Block *> blocks;  //!< All the blocks.
+  std::vector<Block *> free;    //!< The blocks no thread fills.
+  std::deque<Block *> full;     //!< The blocks to write, in order.
+  std::atomic<uint32_t> generation; //!< Incremented by Open.
+};
+
+State &
+GetState (void)
+{
+  static State state;
+  return state;
+}
+
+/** The block the current thread fills. */
+thread_local Block *t_block = 0;
+/** The generation of t_block. */
+thread_local uint32_t t_generation = 0;
+
+/**
+ * \param [in] file The file.
+ * \param [in] data The bytes.
+ * \param [in] size The number of bytes.
+ */
+void
+WriteBytes (FILE *file, const void *data, size_t size)
+{
+  if (fwrite (data, 1, size, file) != size)
+    {
+      NS_LOG_ERROR ("Writing the event trace failed");
+    }
+}
+
+/**
+ * \param [in] file The file.
+ * \param [in] s The string.
+ */
+void
+WriteString (FILE *file, const std::string &s)
+{
+  uint16_t size = s.size ();
+  WriteBytes (file, &size, sizeof (size));
+  WriteBytes (file, s.data (), size);
+}
+
+/**
+ * \param [in] file The file.
+ * \param [in] type The event type.
+ */
+void
+WriteType (FILE *file, const EventTrace::Type &type)
+{
+  std::ostringstream fields;
+  for (uint32_t i = 0; i < type.fields.size (); i++)
+    {
+      fields << (i == 0 ? "" : " ") << type.fields[i].name << ":" << type.fields[i].kind;
+    }
+  WriteBytes (file, "T", 1);
+  WriteBytes (file, &type.id, sizeof (type.id));
+  WriteBytes (file, &type.component, sizeof (type.component));
+  WriteString (file, type.componentName);
+  WriteString (file, type.name);
+  WriteString (file, fields.str ());
+}
+
+/**
+ * Write the blocks queued until the file is closed.
+ *
+ * \param [in] s The state.
+ */
+void
+RunWriter (State *s)
+{
+  State &state = *s;
+  std::vector<EventTrace::Type> types;
+  std::vector<uint16_t> components;
+  std::unique_lock<std::mutex> lock (state.mutex);
+  while (true)
+    {
+      state.queued.wait (lock, [&state] { return state.stopping || !state.full.empty (); });
+      std::vector<EventTrace::Type> newTypes (state.types.begin () + state.nWrittenTypes,
+                                              state.types.end ());
+      state.nWrittenTypes = state.types.size ();
+      if (state.full.empty ())
+        {
+          lock.unlock ();
+          for (uint32_t i = 0; i < newTypes.size (); i++)
+            {
+              WriteType (state.file, newTypes[i]);
+            }
+          break;
+        }
+      Block *block = state.full.front ();
+      state.full.pop_front ();
+      lock.unlock ();
+
+      for (uint32_t i = 0; i < newTypes.size (); i++)
+        {
+          WriteType (state.file, newTypes[i]);
+          components.push_back (newTypes[i].component);
+        }
+      // the component is looked up here rather than by the writing threads
+      for (uint32_t i = 0; i < block->size; i++)
+        {
+          block->records[i].component = components[block->records[i].type];
+        }
+      WriteBytes (state.file, "R", 1);
+      WriteBytes (state.file, &block->size, sizeof (block->size));
+      WriteBytes (state.file, block->records, block->size * sizeof (EventTrace::Record));
+
+      lock.lock ();
+      block->size = 0;
+      state.free.push_back (block);
+      state.available.notify_all ();
+    }
+}
+
+/**
+ * \return A block for the current thread.
+ */
+Block *
+AcquireBlock (void)
+{
+  State &state = GetState ();
+  std::unique_lock<std::mutex> lock (state.mutex);
+  Block *block;
+  if (state.free.empty () && state.blocks.size () < MAX_BLOCKS)
+    {
+      block = new Block;
+      block->size = 0;
+      state.blocks.push_back (block);
+    }
+  else
+    {
+      // the writer thread does not keep up
+      state.available.wait (lock, [&state] { return !state.free.empty (); });
+      block = state.free.back ();
+      state.free.pop_back ();
+    }
+  block->inUse = true;
+  t_block = block;
+  t_generation = state.generation.load (std::memory_order_relaxed);
+  return block;
+}
+
+/**
+ * Queue a full block of the current thread.
+ */
+void
+QueueBlock (void)
+{
+  State &state = GetState ();
+  std::unique_lock<std::mutex> lock (state.mutex);
+  t_block->inUse = false;
+  state.full.push_back (t_block);
+  t_block = 0;
+  state.queued.notify_one ();
+}
+
+void
+State::Close (void)
+{
+  if (file == 0)
+    {
+      return;
+    }
+  {
+    std::unique_lock<std::mutex> lock (mutex);
+    // the blocks the threads were filling
+    for (std::vector<Block *>::iterator i = blocks.begin (); i != blocks.end (); i++)
+      {
+        if ((*i)->inUse)
+          {
+            (*i)->inUse = false;
+            full.push_back (*i);
+          }
+      }
+    stopping = true;
+    queued.notify_one ();
+  }
+  writer.join ();
+  if (std::fclose (file) != 0)
+    {
+      NS_LOG_ERROR ("Closing the event trace " << filename << " failed");
+    }
+  file = 0;
+  for (std::vector<Block *>::iterator i = blocks.begin (); i != blocks.end (); i++)
+    {
+      delete *i;
+    }
+  blocks.clear ();
+  free.clear ();
+  // the threads drop their block on their next record
+  generation++;
+}
+
+} // anonymous namespace
+
+std::atomic<bool> EventTrace::m_enabled (false);
+
+uint16_t
+EventTrace::Register (std::string component, std::string event, std::string fields)
+{
+  NS_LOG_FUNCTION (component << event << fields);
+  State &state = GetState ();
+  std::unique_lock<std::mutex> lock (state.mutex);
+  Type type;
+  type.id = state.types.size ();
+  type.component = 0;
+  type.componentName = component;
+  type.name = event;
+  bool newComponent = true;
+  for (std::vector<Type>::const_iterator i = state.types.begin (); i != state.types.end (); i++)
+    {
+      if (i->componentName == component)
+        {
+          if (i->name == event)
+            {
+              return i->id;
+            }
+          type.component = i->component;
+          newComponent = false;
+        }
+      else if (newComponent)
+        {
+          type.component = std::max<uint16_t> (type.component, i->component + 1);
+        }
+    }
+  NS_ABORT_MSG_IF (state.types.size () == 0xffff, "Too many event types");
+
+  std::istringstream is (fields);
+  std::string spec;
+  while (is >> spec)
+    {
+      std::string::size_type colon = spec.find (':');
+      NS_ABORT_MSG_IF (colon == std::string::npos || colon + 2 != spec.size ()
+                       || std::string ("iud").find (spec[colon + 1]) == std::string::npos,
+                       "Invalid field \"" << spec << "\" of event " << component << "/" << event);
+      Field field;
+      field.name = spec.substr (0, colon);
+      field.kind = spec[colon + 1];
+      type.fields.push_back (field);
+    }
+  NS_ABORT_MSG_IF (type.fields.size () > MAX_FIELDS,
+                   "Too many fields for event " << component << "/" << event);
+  state.types.push_back (type);
+  return type.id;
+}
+
+void
+EventTrace::Open (std::string filename)
+{
+  NS_LOG_FUNCTION (filename);
+  Close ();
+  State &state = GetState ();
+  state.file = std::fopen (filename.c_str (), "wb");
+  NS_ABORT_MSG_IF (state.file == 0, "Unable to open event trace " << filename);
+  state.filename = filename;
+
+  WriteBytes (state.file, MAGIC, sizeof (MAGIC));
+  uint32_t header[4] = { FORMAT_VERSION, BYTE_ORDER_MARK, sizeof (Record),
+                         static_cast<uint32_t> (Time::GetResolution ()) };
+  WriteBytes (state.file, header, sizeof (header));
+
+  state.stopping = false;
+  state.nWrittenTypes = 0;
+  state.generation++;
+  state.writer = std::thread (&RunWriter, &state);
+  m_enabled = true;
+}
+
+void
+EventTrace::Close (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  m_enabled = false;
+  GetState ().Close ();
+}
+
+void
+EventTrace::Write (uint16_t type, uint32_t node,
+                   EventTraceField f0, EventTraceField f1,
+                   EventTraceField f2, EventTraceField f3)
+{
+  Block *block = t_block;
+  if (block == 0 || t_generation != GetState ().generation.load (std::memory_order_relaxed))
+    {
+      block = AcquireBlock ();
+    }
+  Record &record = block->records[block->size];
+  record.time = Simulator::Now ().GetTimeStep ();
+  record.component = 0;
+  record.type = type;
+  record.node = node;
+  record.fields[0] = f0.GetBits ();
+  record.fields[1] = f1.GetBits ();
+  record.fields[2] = f2.GetBits ();
+  record.fields[3] = f3.GetBits ();
+  if (++block->size == BLOCK_RECORDS)
+    {
+      QueueBlock ();
+    }
+}
+
+
+EventTraceReader::EventTraceReader ()
+  : m_file (0),
+    m_resolution (Time::NS),
+    m_remaining (0)
+{
+}
+
+EventTraceReader::~EventTraceReader ()
+{
+  if (m_file != 0)
+    {
+      std::fclose (m_file);
+    }
+}
+
+bool
+EventTraceReader::Open (std::string filename)
+{
+  NS_LOG_FUNCTION (this << filename);
+  if (m_file != 0)
+    {
+      std::fclose (m_file);
+    }
+  m_types.clear ();
+  m_remaining = 0;
+  m_file = std::fopen (filename.c_str (), "rb");
+  if (m_file == 0)
+    {
+      return false;
+    }
+  char magic[sizeof (MAGIC)];
+  uint32_t header[4];
+  if (fread (magic, sizeof (magic), 1, m_file) != 1
+      || std::memcmp (magic, MAGIC, sizeof (MAGIC)) != 0
+      || fread (header, sizeof (header), 1, m_file) != 1
+      || header[0] != FORMAT_VERSION || header[1] != BYTE_ORDER_MARK
+      || header[2] != sizeof (EventTrace::Record) || header[3] >= static_cast<uint32_t> (Time::LAST))
+    {
+      NS_LOG_WARN (filename << " is not an event trace of this version and byte order");
+      std::fclose (m_file);
+      m_file = 0;
+      return false;
+    }
+  m_resolution = static_cast<Time::Unit> (header[3]);
+  return true;
+}
+
+bool
+EventTraceReader::ReadChunk (void)
+{
+  char tag;
+  if (fread (&tag, 1, 1, m_file) != 1)
+    {
+      return false;
+    }
+  if (tag == 'R')
+    {
+      return fread (&m_remaining, sizeof (m_remaining), 1, m_file) == 1;
+    }
+  if (tag != 'T')
+    {
+      NS_LOG_WARN ("Invalid chunk " << tag);
+      return false;
+    }
+  EventTrace::Type type;
+  std::string strings[3];
+  if (fread (&type.id, sizeof (type.id), 1, m_file) != 1
+      || fread (&type.component, sizeof (type.component), 1, m_file) != 1)
+    {
+      return false;
+    }
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      uint16_t size;
+      if (fread (&size, sizeof (size), 1, m_file) != 1)
+        {
+          return false;
+        }
+      strings[i].resize (size);
+      if (size > 0 && fread (&strings[i][0], size, 1, m_file) != 1)
+        {
+          return false;
+        }
+    }
+  type.componentName = strings[0];
+  type.name = strings[1];
+  std::istringstream is (strings[2]);
+  std::string spec;
+  while (is >> spec)
+    {
+      EventTrace::Field field;
+      field.name = spec.substr (0, spec.size () - 2);
+      field.kind = spec[spec.size () - 1];
+      type.fields.push_back (field);
+    }
+  m_types[type.id] = type;
+  return true;
+}
+
+bool
+EventTraceReader::Read (EventTrace::Record &record)
+{
+  if (m_file == 0)
+    {
+      return false;
+    }
+  while (m_remaining == 0)
+    {
+      if (!ReadChunk ())
+        {
+          return false;
+        }
+    }
+  if (fread (&record, sizeof (record), 1, m_file) != 1)
+    {
+      NS_LOG_WARN ("Truncated event trace");
+      m_remaining = 0;
+      return false;
+    }
+  m_remaining--;
+  return true;
+}
+
+Time::Unit
+EventTraceReader::GetResolution (void) const
+{
+  return m_resolution;
+}
+
+const EventTrace::Type *
+EventTraceReader::GetType (uint16_t id) const
+{
+  std::map<uint16_t, EventTrace::Type>::const_iterator i = m_types.find (id);
+  return i == m_types.end () ? 0 : &i->second;
+}
+
+std::vector<const EventTrace::Type *>
+EventTraceReader::GetTypes (void) const
+{
+  std::vector<const EventTrace::Type *> types;
+  for (std::map<uint16_t, EventTrace::Type>::const_iterator i = m_types.begin (); i != m_types.end (); i++)
+    {
+      types.push_back (&i->second);
+    }
+  return types;
+}
+
+} // namespace ns3
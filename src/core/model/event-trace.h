@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef EVENT_TRACE_H
+#define EVENT_TRACE_H
+
+#include "nstime.h"
+
+#include <stdint.h>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup tracing
+ * Declaration of the binary event trace, ns3::EventTrace and
+ * ns3::EventTraceReader.
+ */
+
+/**
+ * \ingroup tracing
+ *
+ * Write an event trace record if an event trace file is open. The fields
+ * are not evaluated otherwise.
+ *
+ * \param [in] type The event type, as returned by EventTrace::Register.
+ * \param [in] ... The node id, then the values of the fields of the
+ *                 event type.
+ */
+#define NS_EVENT_TRACE(type, ...)                                       \
+  do                                                                    \
+    {                                                                   \
+      if (ns3::EventTrace::IsEnabled ())                                \
+        {                                                               \
+          ns3::EventTrace::Write (type, __VA_ARGS__);                   \
+        }                                                               \
+    }                                                                   \
+  while (false)
+
+namespace ns3 {
+
+/**
+ * \ingroup tracing
+ *
+ * The value of a field of an event trace record: the bits of an integer
+ * or of a double, interpreted according to the event type.
+ */
+class EventTraceField
+{
+public:
+  /** An absent field. */
+  EventTraceField ()
+    : m_bits (0)
+  {
+  }
+  /**
+   * \param [in] value The value, stored as a 64 bit integer.
+   */
+  template <typename T>
+  EventTraceField (T value,
+                   typename std::enable_if<std::is_integral<T>::value || std::is_enum<T>::value>::type * = 0)
+    : m_bits (static_cast<uint64_t> (static_cast<int64_t> (value)))
+  {
+  }
+  /**
+   * \param [in] value The value, stored as a double.
+   */
+  EventTraceField (double value)
+  {
+    std::memcpy (&m_bits, &value, sizeof (m_bits));
+  }
+  /** \return The bits of the value. */
+  uint64_t GetBits (void) const
+  {
+    return m_bits;
+  }
+
+private:
+  uint64_t m_bits; //!< The bits of the value.
+};
+
+/**
+ * \ingroup tracing
+ *
+ * Binary trace of structured events, for the measurement runs which need
+ * every packet event without the cost of formatting log lines.
+ *
+ * The modules register their event types once, with the name of the
+ * component, the name of the event and the names and kinds of up to
+ * MAX_FIELDS numeric fields, e.g.
+ * \code
+ *   static const uint16_t g_txEvent =
+ *     EventTrace::Register ("LoraPacketTracker", "Tx", "uid:u size:u");
+ *   ...
+ *   NS_EVENT_TRACE (g_txEvent, edId, packet->GetUid (), packet->GetSize ());
+ * \endcode
+ * The kinds are \c i (signed integer), \c u (unsigned integer) and \c d
+ * (double).
+ *
+ * When a trace file is open, every record is a fixed size copy of the
+ * current time, the event type, the node and the fields, appended to a
+ * block of records owned by the calling thread: no formatting, lock or
+ * allocation on the path of the simulation. Full blocks are handed to a
+ * writer thread which writes them to the file as they are, while the
+ * thread fills another block of a small pool; the simulation only waits
+ * for the writer when the pool is exhausted. The event types are written
+ * to the file before the first block which may use them.
+ *
+ * The records of a thread are in the order they were written; those of
+ * several threads are interleaved by block. EventTraceReader reads the
+ * file back and \c utils/decode-event-trace converts it to CSV or to one
+ * binary file per column.
+ */
+class EventTrace
+{
+public:
+  /** The maximum number of fields of an event type. */
+  static const uint32_t MAX_FIELDS = 4;
+
+  /** A record, as stored in the file. */
+  struct Record
+  {
+    int64_t time;               //!< The time, in time steps.
+    uint16_t component;         //!< The component id.
+    uint16_t type;              //!< The event type id.
+    uint32_t node;              //!< The node id.
+    uint64_t fields[MAX_FIELDS]; //!< The bits of the fields.
+  };
+
+  /** A field of an event type. */
+  struct Field
+  {
+    std::string name;  //!< The name.
+    char kind;         //!< 'i', 'u' or 'd'.
+  };
+
+  /** An event type. */
+  struct Type
+  {
+    uint16_t id;                //!< The event type id.
+    uint16_t component;         //!< The component id.
+    std::string componentName;  //!< The component name.
+    std::string name;           //!< The event name.
+    std::vector<Field> fields;  //!< The fields.
+  };
+
+  /**
+   * Register an event type. Registering the same component and event
+   * again returns the same id.
+   *
+   * \param [in] component The component name.
+   * \param [in] event The event name.
+   * \param [in] fields The fields, as space separated name:kind pairs.
+   * \return The event type id.
+   */
+  static uint16_t Register (std::string component, std::string event, std::string fields);
+
+  /**
+   * Start writing the records to a file, which is truncated.
+   * \param [in] filename The file name.
+   */
+  static void Open (std::string filename);
+  /**
+   * Write the pending records and close the file. The other threads
+   * writing records must be done. A file still open when the program
+   * exits is closed then.
+   */
+  static void Close (void);
+  /** \return \c true if a file is open. */
+  static bool IsEnabled (void)
+  {
+    return m_enabled.load (std::memory_order_relaxed);
+  }
+
+  /**
+   * Write a record at the current time. Use NS_EVENT_TRACE rather than
+   * calling this directly.
+   *
+   * \param [in] type The event type id.
+   * \param [in] node The node id.
+   * \param [in] f0 The first field.
+   * \param [in] f1 The second field.
+   * \param [in] f2 The third field.
+   * \param [in] f3 The fourth field.
+   */
+  static void Write (uint16_t type, uint32_t node,
+                     EventTraceField f0 = EventTraceField (),
+                     EventTraceField f1 = EventTraceField (),
+                     EventTraceField f2 = EventTraceField (),
+                     EventTraceField f3 = EventTraceField ());
+
+private:
+  static std::atomic<bool> m_enabled; //!< Whether a file is open.
+};
+
+/**
+ * \ingroup tracing
+ *
+ * Reader of the files written by EventTrace.
+ */
+class EventTraceReader
+{
+public:
+  EventTraceReader ();
+  ~EventTraceReader ();
+
+  /**
+   * \param [in] filename The file name.
+   * \return \c false if the file cannot be read or is not an event trace.
+   */
+  bool Open (std::string filename);
+  /**
+   * Read the next record.
+   * \param [out] record The record.
+   * \return \c false at the end of the file, or if it is truncated.
+   */
+  bool Read (EventTrace::Record &record);
+
+  /** \return The unit of the record times. */
+  Time::Unit GetResolution (void) const;
+  /**
+   * \param [in] id The event type id.
+   * \return The event type, or 0 if it has not been read yet.
+   */
+  const EventTrace::Type * GetType (uint16_t id) const;
+  /** \return The event types read so far. */
+  std::vector<const EventTrace::Type *> GetTypes (void) const;
+
+private:
+  /**
+   * Read the next chunk header, and the chunk if it is an event type.
+   * \return \c false at the end of the file.
+   */
+  bool ReadChunk (void);
+
+  FILE *m_file;                //!< The file.
+  Time::Unit m_resolution;     //!< The unit of the times.
+  uint32_t m_remaining;        //!< The records left in the current block.
+  std::map<uint16_t, EventTrace::Type> m_types; //!< The event types.
+};
+
+} // namespace ns3
+
+#endif /* EVENT_TRACE_H */
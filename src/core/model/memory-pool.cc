@@ -0,0 +1,278 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "memory-pool.h"
+#include <new>
+#include <atomic>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::MemoryPool implementation.
+ */
+
+namespace ns3 {
+
+namespace {
+
+/** Number of free lists, one per multiple of GRANULE. */
+const std::size_t N_SIZE_CLASSES = MemoryPool::MAX_SIZE / MemoryPool::GRANULE;
+/** Number of blocks of a slab. */
+const uint32_t SLAB_BLOCKS = 64;
+/** Number of blocks a thread keeps in a list before giving a batch back. */
+const uint32_t MAX_THREAD_BLOCKS = 4 * MemoryPool::BATCH;
+
+/** A free block. */
+struct FreeBlock
+{
+  FreeBlock *next;       //!< Next free block of the list or the batch.
+  FreeBlock *nextBatch;  //!< In the depot, the first block of the next batch.
+};
+
+/** A slab of blocks. */
+struct Slab
+{
+  Slab *next; //!< Previously allocated slab.
+};
+
+/**
+ * The batches of free blocks of a size class given back by the threads.
+ *
+ * Only trivially destructible members, so that blocks can still be given
+ * back while the static objects are destroyed.
+ */
+struct Depot
+{
+  std::atomic_flag lock;  //!< Spin lock of the batches.
+  FreeBlock *batches;     //!< The first block of the first batch.
+};
+
+/** The depots, one per size class. */
+Depot g_depots[N_SIZE_CLASSES] = {};
+/** All the slabs, of all the threads, so that they stay reachable. */
+std::atomic<Slab *> g_slabs (0);
+/** Number of allocations from the system allocator. */
+std::atomic<uint64_t> g_nSystemAllocations (0);
+
+/** The free lists of the calling thread. */
+thread_local FreeBlock *g_freeLists[N_SIZE_CLASSES];
+/** The number of blocks of the free lists of the calling thread. */
+thread_local uint32_t g_nFree[N_SIZE_CLASSES];
+/** Whether the calling thread has given back its blocks on exit. */
+thread_local bool g_exited = false;
+
+/**
+ * Put a chain of blocks in the depot.
+ *
+ * \param [in] sizeClass The size class of the blocks.
+ * \param [in] first The first block of the chain.
+ */
+void
+PutBatch (std::size_t sizeClass, FreeBlock *first)
+{
+  Depot &depot = g_depots[sizeClass];
+  while (depot.lock.test_and_set (std::memory_order_acquire))
+    {
+    }
+  first->nextBatch = depot.batches;
+  depot.batches = first;
+  depot.lock.clear (std::memory_order_release);
+}
+
+/**
+ * Take a chain of blocks from the depot.
+ *
+ * \param [in] sizeClass The size class of the blocks.
+ * \returns The first block of the chain, 0 if the depot is empty.
+ */
+FreeBlock *
+TakeBatch (std::size_t sizeClass)
+{
+  Depot &depot = g_depots[sizeClass];
+  while (depot.lock.test_and_set (std::memory_order_acquire))
+    {
+    }
+  FreeBlock *first = depot.batches;
+  if (first != 0)
+    {
+      depot.batches = first->nextBatch;
+    }
+  depot.lock.clear (std::memory_order_release);
+  return first;
+}
+
+/** Gives the blocks of a thread back to the depot when the thread exits. */
+struct ThreadExit
+{
+  ThreadExit ()
+  {
+  }
+  ~ThreadExit ()
+  {
+    for (std::size_t i = 0; i < N_SIZE_CLASSES; i++)
+      {
+        if (g_freeLists[i] != 0)
+          {
+            PutBatch (i, g_freeLists[i]);
+            g_freeLists[i] = 0;
+            g_nFree[i] = 0;
+          }
+      }
+    g_exited = true;
+  }
+};
+
+/**
+ * Constructed when a free list of a thread gets its first blocks,
+ * destroyed when the thread exits.
+ */
+thread_local ThreadExit g_threadExit;
+
+/**
+ * Refill an empty free list of the calling thread, from the depot or
+ * else with a new slab.
+ *
+ * \param [in] sizeClass The size class of the list.
+ */
+void
+Refill (std::size_t sizeClass)
+{
+  // registers the exit hook of the thread
+  (void) &g_threadExit;
+  FreeBlock *head = TakeBatch (sizeClass);
+  if (head != 0)
+    {
+      uint32_t n = 0;
+      for (FreeBlock *block = head; block != 0; block = block->next)
+        {
+          n++;
+        }
+      g_freeLists[sizeClass] = head;
+      g_nFree[sizeClass] = n;
+      return;
+    }
+  std::size_t blockSize = (sizeClass + 1) * MemoryPool::GRANULE;
+  // the header keeps the blocks aligned as by the system allocator
+  char *memory = static_cast<char *> (::operator new (MemoryPool::GRANULE + SLAB_BLOCKS * blockSize));
+  g_nSystemAllocations.fetch_add (1, std::memory_order_relaxed);
+  Slab *slab = reinterpret_cast<Slab *> (memory);
+  slab->next = g_slabs.load (std::memory_order_relaxed);
+  while (!g_slabs.compare_exchange_weak (slab->next, slab))
+    {
+    }
+  for (uint32_t i = SLAB_BLOCKS; i > 0; i--)
+    {
+      FreeBlock *block = reinterpret_cast<FreeBlock *> (memory + MemoryPool::GRANULE + (i - 1) * blockSize);
+      block->next = head;
+      head = block;
+    }
+  g_freeLists[sizeClass] = head;
+  g_nFree[sizeClass] = SLAB_BLOCKS;
+}
+
+/**
+ * Give a batch of the blocks of a free list of the calling thread back
+ * to the depot.
+ *
+ * \param [in] sizeClass The size class of the list.
+ */
+void
+Drain (std::size_t sizeClass)
+{
+  FreeBlock *first = g_freeLists[sizeClass];
+  FreeBlock *last = first;
+  for (uint32_t i = 1; i < MemoryPool::BATCH; i++)
+    {
+      last = last->next;
+    }
+  g_freeLists[sizeClass] = last->next;
+  g_nFree[sizeClass] -= MemoryPool::BATCH;
+  last->next = 0;
+  PutBatch (sizeClass, first);
+}
+
+/**
+ * \param [in] size The size of a block.
+ * \returns The index of the free list of this size.
+ */
+inline std::size_t
+GetSizeClass (std::size_t size)
+{
+  return (size - 1) / MemoryPool::GRANULE;
+}
+
+} // anonymous namespace
+
+void *
+MemoryPool::Allocate (std::size_t size)
+{
+  if (size > MAX_SIZE || size == 0)
+    {
+      g_nSystemAllocations.fetch_add (1, std::memory_order_relaxed);
+      return ::operator new (size);
+    }
+  std::size_t sizeClass = GetSizeClass (size);
+  if (g_freeLists[sizeClass] == 0)
+    {
+      Refill (sizeClass);
+    }
+  FreeBlock *block = g_freeLists[sizeClass];
+  g_freeLists[sizeClass] = block->next;
+  g_nFree[sizeClass]--;
+  return block;
+}
+
+void
+MemoryPool::Deallocate (void *p, std::size_t size)
+{
+  if (p == 0)
+    {
+      return;
+    }
+  if (size > MAX_SIZE || size == 0)
+    {
+      ::operator delete (p);
+      return;
+    }
+  std::size_t sizeClass = GetSizeClass (size);
+  FreeBlock *block = static_cast<FreeBlock *> (p);
+  if (g_exited)
+    {
+      // the free lists of the thread are gone
+      block->next = 0;
+      PutBatch (sizeClass, block);
+      return;
+    }
+  if (g_freeLists[sizeClass] == 0)
+    {
+      // registers the exit hook of a thread which only frees blocks
+      (void) &g_threadExit;
+    }
+  block->next = g_freeLists[sizeClass];
+  g_freeLists[sizeClass] = block;
+  if (++g_nFree[sizeClass] > MAX_THREAD_BLOCKS)
+    {
+      Drain (sizeClass);
+    }
+}
+
+uint64_t
+MemoryPool::GetNSystemAllocations (void)
+{
+  return g_nSystemAllocations.load (std::memory_order_relaxed);
+}
+
+} // namespace ns3
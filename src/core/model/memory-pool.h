@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MEMORY_POOL_H
+#define MEMORY_POOL_H
+
+#include <stdint.h>
+#include <cstddef>
+
+/**
+ * \file
+ * \ingroup core
+ * ns3::MemoryPool declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup core
+ * \brief Allocator of small objects which are created and freed at a
+ * high rate, such as events and packets.
+ *
+ * Blocks up to MAX_SIZE bytes are allocated from free lists, one per
+ * multiple of GRANULE bytes. Every thread has its own free lists, so
+ * that allocating and freeing a block needs no locking. The free lists
+ * of a thread are refilled by batches of blocks from a global depot, or
+ * from the system allocator by slabs when the depot is empty.
+ *
+ * A thread gives blocks back to the depot when one of its lists holds
+ * more than a few batches, as when it frees the blocks allocated by
+ * another thread. When the thread exits, it gives back all its blocks.
+ * The blocks are thus reused by the other threads, and by the threads
+ * started later. The slabs are never returned to the system.
+ *
+ * Larger blocks are allocated by the system allocator.
+ *
+ * A class uses the pool through its operator new and operator delete:
+ *
+ * \code
+ *   static void * operator new (std::size_t size)
+ *   {
+ *     return MemoryPool::Allocate (size);
+ *   }
+ *   static void operator delete (void *p, std::size_t size)
+ *   {
+ *     MemoryPool::Deallocate (p, size);
+ *   }
+ * \endcode
+ */
+class MemoryPool
+{
+public:
+  /**
+   * Allocate a block.
+   *
+   * \param [in] size The size of the block, in bytes.
+   * \returns The block, aligned as by the system allocator.
+   */
+  static void * Allocate (std::size_t size);
+  /**
+   * Free a block.
+   *
+   * \param [in] p The block, as returned by Allocate, or 0.
+   * \param [in] size The size given to Allocate.
+   */
+  static void Deallocate (void *p, std::size_t size);
+  /**
+   * \returns The number of times memory was obtained from the system
+   *          allocator, by all the threads: slab refills, and blocks
+   *          larger than MAX_SIZE.
+   */
+  static uint64_t GetNSystemAllocations (void);
+
+  /** Largest block allocated from the free lists, in bytes. */
+  static const std::size_t MAX_SIZE = 256;
+  /** Size granularity of the free lists, in bytes. */
+  static const std::size_t GRANULE = 16;
+  /** Number of blocks moved at once between a thread and the depot. */
+  static const uint32_t BATCH = 64;
+};
+
+} // namespace ns3
+
+#endif /* MEMORY_POOL_H */
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef OBJECT_HANDLE_H
+#define OBJECT_HANDLE_H
+
+#include "object.h"
+#include "ptr.h"
+
+/**
+ * \file
+ * \ingroup object
+ * ns3::ObjectHandle template declaration and implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup object
+ *
+ * Typed reference to an Object of an aggregate, looked up once.
+ *
+ * The handle keeps the aggregate and looks up the Object of type T the
+ * first time it is asked for it. Objects are never removed from an
+ * aggregate before it is deleted, so the Object found is kept for the
+ * lifetime of the aggregate. A failed lookup is made again on the next
+ * call, since T can be aggregated later, e.g. a MobilityModel installed
+ * after the devices of a Node.
+ *
+ * The handle holds no reference, so that an Object of the aggregate can
+ * keep a handle on the aggregate without a reference cycle: it must not
+ * outlive the aggregate.
+ *
+ * \tparam T The type of the Object looked up.
+ */
+template <typename T>
+class ObjectHandle
+{
+public:
+  /** A handle on no aggregate. */
+  ObjectHandle ();
+  /**
+   * \param [in] aggregate An Object of the aggregate.
+   */
+  explicit ObjectHandle (Ptr<const Object> aggregate);
+
+  /**
+   * \return The Object of type T of the aggregate, 0 if there is none.
+   */
+  Ptr<T> Get (void) const;
+  /**
+   * \return Whether the handle has an aggregate.
+   */
+  bool IsBound (void) const;
+
+private:
+  const Object *m_aggregate; //!< An Object of the aggregate
+  mutable T *m_object;       //!< The Object found, 0 until then
+};
+
+} // namespace ns3
+
+
+/*************************************************************************
+ *   The ObjectHandle implementation.
+ *************************************************************************/
+
+namespace ns3 {
+
+template <typename T>
+ObjectHandle<T>::ObjectHandle ()
+  : m_aggregate (0),
+    m_object (0)
+{
+}
+
+template <typename T>
+ObjectHandle<T>::ObjectHandle (Ptr<const Object> aggregate)
+  : m_aggregate (PeekPointer (aggregate)),
+    m_object (0)
+{
+}
+
+template <typename T>
+Ptr<T>
+ObjectHandle<T>::Get (void) const
+{
+  if (m_object == 0 && m_aggregate != 0)
+    {
+      m_object = PeekPointer (m_aggregate->GetObject<T> ());
+    }
+  return Ptr<T> (m_object);
+}
+
+template <typename T>
+bool
+ObjectHandle<T>::IsBound (void) const
+{
+  return m_aggregate != 0;
+}
+
+} // namespace ns3
+
+#endif /* OBJECT_HANDLE_H */
@@ -103,6 +103,7 @@ Object::Object ()
   NS_LOG_FUNCTION (this);
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  ClearCache (m_aggregates);
 }
 Object::~Object () 
 {
@@ -120,6 +121,7 @@ Object::~Object ()
           m_aggregates->n--;
         }
     }
+  ClearCache (m_aggregates);
   // finally, if all objects have been removed from the list,
   // delete the aggregate list
   if (m_aggregates->n == 0)
@@ -137,6 +139,7 @@ Object::Object (const Object &o)
 {
   m_aggregates->n = 1;
   m_aggregates->buffer[0] = this;
+  ClearCache (m_aggregates);
 }
 void
 Object::Construct (const AttributeConstructionList &attributes)
@@ -152,6 +155,34 @@ Object::DoGetObject (TypeId tid) const
   NS_ASSERT (CheckLoose ());
 
   uint32_t n = m_aggregates->n;
+#ifndef NS3_PARALLEL_LPS
+  // with several logical processes, the aggregate may be looked up from
+  // several threads: it is then left as it is
+  uint16_t uid = tid.GetUid ();
+  uint32_t slot = uid % AGGREGATE_CACHE_SIZE;
+  if (m_aggregates->cacheUid[slot] == uid)
+    {
+      Object *current = m_aggregates->cacheObject[slot];
+      if (current == 0)
+        {
+          return 0;
+        }
+      // keep the array sorted as without the cache
+      for (uint32_t i = 0; i < n; i++)
+        {
+          if (m_aggregates->buffer[i] == current)
+            {
+              current->m_getObjectCount++;
+              UpdateSortedArray (m_aggregates, i);
+              break;
+            }
+        }
+      return const_cast<Object *> (current);
+    }
+
+  m_aggregates->cacheUid[slot] = uid;
+  m_aggregates->cacheObject[slot] = 0;
+#endif
   TypeId objectTid = Object::GetTypeId ();
   for (uint32_t i = 0; i < n; i++)
     {
@@ -168,12 +199,14 @@ Object::DoGetObject (TypeId tid) const
           // we are likely to perform the same lookup later so, we make sure
           // that the aggregate array is sorted by the number of accesses
           // to each object.
-
+#ifndef NS3_PARALLEL_LPS
           // first, increment the access count
           current->m_getObjectCount++;
           // then, update the sort
           UpdateSortedArray (m_aggregates, i);
           // finally, return the match
+          m_aggregates->cacheObject[slot] = current;
+#endif
           return const_cast<Object *> (current);
         }
     }
@@ -230,6 +263,11 @@ restart:
     }
 }
 void
+Object::ClearCache (struct Aggregates *aggregates)
+{
+  std::memset (aggregates->cacheUid, 0, sizeof (aggregates->cacheUid));
+}
+void
 Object::UpdateSortedArray (struct Aggregates *aggregates, uint32_t j) const
 {
   NS_LOG_FUNCTION (this << aggregates << j);
@@ -264,6 +302,7 @@ Object::AggregateObject (Ptr<Object> o)
   struct Aggregates *aggregates = 
     (struct Aggregates *)std::malloc (sizeof(struct Aggregates)+(total-1)*sizeof(Object*));
   aggregates->n = total;
+  ClearCache (aggregates);
 
   // copy our buffer to the new buffer
   std::memcpy (&aggregates->buffer[0], 
@@ -333,6 +372,8 @@ Object::SetTypeId (TypeId tid)
   NS_LOG_FUNCTION (this << tid);
   NS_ASSERT (Check ());
   m_tid = tid;
+  // the lookups made with the former type are wrong
+  ClearCache (m_aggregates);
 }
 
 void
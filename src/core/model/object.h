@@ -316,6 +316,8 @@ private:
   friend class AggregateIterator;
   friend struct ObjectDeleter;
 
+  /** The number of entries of the lookup cache of the aggregates. */
+  static const uint32_t AGGREGATE_CACHE_SIZE = 8;
   /**
    * The list of Objects aggregated to this one.
    *
@@ -331,9 +333,22 @@ private:
   struct Aggregates {
     /** The number of entries in \c buffer. */
     uint32_t n;
+    /**
+     * Direct-mapped cache of the lookups, indexed by the TypeId uid
+     * modulo AGGREGATE_CACHE_SIZE: the uid looked up, 0 for none.
+     */
+    uint16_t cacheUid[AGGREGATE_CACHE_SIZE];
+    /** The Objects found for \c cacheUid, 0 if there is none. */
+    Object *cacheObject[AGGREGATE_CACHE_SIZE];
     /** The array of Objects. */
     Object *buffer[1];
   };
+  /**
+   * Forget the lookups made in a list of aggregates, when it changes.
+   *
+   * \param [in,out] aggregates The list of aggregated Objects.
+   */
+  static void ClearCache (struct Aggregates *aggregates);
 
   /**
    * Find an Object of TypeId tid in the aggregates of this Object.
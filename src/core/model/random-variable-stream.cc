@@ -137,6 +137,16 @@ RandomVariableStream::Peek(void) const
   return m_rng;
 }
 
+void
+RandomVariableStream::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      values[i] = GetValue ();
+    }
+}
+
 NS_OBJECT_ENSURE_REGISTERED(UniformRandomVariable);
 
 TypeId 
@@ -195,6 +205,22 @@ UniformRandomVariable::GetInteger (uint32_t min, uint32_t max)
   return static_cast<uint32_t> ( GetValue ((double) (min), (double) (max) + 1.0) );
 }
 
+void
+UniformRandomVariable::GetValues (double *values, uint32_t n, double min, double max)
+{
+  NS_LOG_FUNCTION (this << values << n << min << max);
+  Peek ()->RandU01 (values, n);
+  for (uint32_t i = 0; i < n; i++)
+    {
+      double v = min + values[i] * (max - min);
+      if (IsAntithetic ())
+        {
+          v = min + (max - v);
+        }
+      values[i] = v;
+    }
+}
+
 double 
 UniformRandomVariable::GetValue (void)
 {
@@ -207,6 +233,12 @@ UniformRandomVariable::GetInteger (void)
   NS_LOG_FUNCTION (this);
   return (uint32_t)GetValue (m_min, m_max + 1);
 }
+void
+UniformRandomVariable::GetValues (double *values, uint32_t n)
+{
+  NS_LOG_FUNCTION (this << values << n);
+  GetValues (values, n, m_min, m_max);
+}
 
 NS_OBJECT_ENSURE_REGISTERED(ConstantRandomVariable);
 
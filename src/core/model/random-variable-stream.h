@@ -149,6 +149,19 @@ public:
    */
   virtual uint32_t GetInteger (void) = 0;
 
+  /**
+   * \brief Get the next random values drawn from the distribution.
+   *
+   * The values are the ones \p n calls to GetValue (void) would return,
+   * in the same order, so filling a buffer with GetValues keeps the
+   * stream reproducible; the distributions which can draw a batch
+   * faster than value by value override it.
+   *
+   * \param [out] values The random values.
+   * \param [in] n The number of values.
+   */
+  virtual void GetValues (double *values, uint32_t n);
+
 protected:
   /**
    * \brief Get the pointer to the underlying RNG stream.
@@ -280,6 +293,17 @@ public:
    */
   uint32_t GetInteger (uint32_t min, uint32_t max);
 
+  /**
+   * \brief Get the next random values, as doubles in the specified range
+   * \f$[min, max)\f$: the values of \p n calls to GetValue (min, max).
+   *
+   * \param [out] values The random values.
+   * \param [in] n The number of values.
+   * \param [in] min Low end of the range (included).
+   * \param [in] max High end of the range (excluded).
+   */
+  void GetValues (double *values, uint32_t n, double min, double max);
+
   // Inherited from RandomVariableStream
   /**
    * \brief Get the next random value as a double drawn from the distribution.
@@ -293,6 +317,7 @@ public:
    * \note The upper limit is included in the output range.
    */
   virtual uint32_t GetInteger (void);
+  virtual void GetValues (double *values, uint32_t n);
   
 private:
   /** The lower bound on values that can be returned by this RNG stream. */
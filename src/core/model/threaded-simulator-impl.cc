@@ -0,0 +1,685 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "threaded-simulator-impl.h"
+#include "simulator.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "uinteger.h"
+
+#include "ptr.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup simulator
+ * Implementation of class ns3::ThreadedSimulatorImpl.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("ThreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (ThreadedSimulatorImpl);
+
+thread_local ThreadedSimulatorImpl::LogicalProcess *ThreadedSimulatorImpl::m_currentLp = 0;
+
+TypeId
+ThreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ThreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<ThreadedSimulatorImpl> ()
+    .AddAttribute ("Threads",
+                   "The number of threads running the logical processes.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&ThreadedSimulatorImpl::m_nThreads),
+                   MakeUintegerChecker<uint32_t> (1))
+    .AddAttribute ("LogicalProcesses",
+                   "The number of partitions of the contexts, "
+                   "0 for one per thread.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&ThreadedSimulatorImpl::m_nLps),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Lookahead",
+                   "The minimum delay of the events scheduled for a context "
+                   "of another logical process, which is the length of the "
+                   "time windows.",
+                   TimeValue (NanoSeconds (1)),
+                   MakeTimeAccessor (&ThreadedSimulatorImpl::SetLookahead,
+                                     &ThreadedSimulatorImpl::GetLookahead),
+                   MakeTimeChecker (TimeStep (0)))
+  ;
+  return tid;
+}
+
+ThreadedSimulatorImpl::ThreadedSimulatorImpl ()
+  : m_nThreads (1),
+    m_nLps (0),
+    m_lookahead (1),
+    m_stopTs (~0ULL),
+    m_stop (false),
+    m_running (false),
+    m_windowStart (0),
+    m_windowEnd (0),
+    m_nWindows (0),
+    m_currentTs (0),
+    m_window (0),
+    m_nDone (0),
+    m_quit (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ThreadedSimulatorImpl::~ThreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ThreadedSimulatorImpl::NotifyConstructionCompleted (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_nLps == 0)
+    {
+      m_nLps = m_nThreads;
+    }
+  for (uint32_t i = 0; i < m_nLps; i++)
+    {
+      LogicalProcess *lp = new LogicalProcess ();
+      // uids are allocated from 4.
+      // uid 0 is "invalid" events
+      // uid 1 is "now" events
+      // uid 2 is "destroy" events
+      lp->uid = 4;
+      lp->currentUid = 0;
+      lp->currentTs = 0;
+      lp->currentContext = 0xffffffff;
+      m_lps.push_back (lp);
+    }
+  SimulatorImpl::NotifyConstructionCompleted ();
+}
+
+void
+ThreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); i++)
+    {
+      LogicalProcess *lp = *i;
+      while (lp->events != 0 && !lp->events->IsEmpty ())
+        {
+          Scheduler::Event next = lp->events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      for (std::vector<RemoteEvent>::iterator j = lp->outbox.begin (); j != lp->outbox.end (); j++)
+        {
+          j->event.impl->Unref ();
+        }
+      delete lp;
+    }
+  m_lps.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+ThreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (true)
+    {
+      Ptr<EventImpl> ev;
+      {
+        std::lock_guard<std::mutex> lock (m_destroyMutex);
+        if (m_destroyEvents.empty ())
+          {
+            break;
+          }
+        ev = m_destroyEvents.front ().PeekEventImpl ();
+        m_destroyEvents.pop_front ();
+      }
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+ThreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  NS_ASSERT (!m_running);
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); i++)
+    {
+      LogicalProcess *lp = *i;
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      if (lp->events != 0)
+        {
+          while (!lp->events->IsEmpty ())
+            {
+              Scheduler::Event next = lp->events->RemoveNext ();
+              scheduler->Insert (next);
+            }
+        }
+      lp->events = scheduler;
+    }
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+ThreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+void
+ThreadedSimulatorImpl::SetLogicalProcess (uint32_t context, uint32_t lp)
+{
+  NS_LOG_FUNCTION (this << context << lp);
+  NS_ASSERT_MSG (!m_running, "The partition is fixed while the simulation runs");
+  NS_ASSERT_MSG (lp < m_nLps, "There are only " << m_nLps << " logical processes");
+  m_partition[context] = lp;
+}
+
+uint32_t
+ThreadedSimulatorImpl::GetLogicalProcess (uint32_t context) const
+{
+  if (!m_partition.empty ())
+    {
+      std::map<uint32_t, uint32_t>::const_iterator i = m_partition.find (context);
+      if (i != m_partition.end ())
+        {
+          return i->second;
+        }
+    }
+  if (context == 0xffffffff)
+    {
+      return 0;
+    }
+  return context % m_nLps;
+}
+
+uint64_t
+ThreadedSimulatorImpl::GetNWindows (void) const
+{
+  return m_nWindows;
+}
+
+void
+ThreadedSimulatorImpl::SetLookahead (Time lookahead)
+{
+  NS_LOG_FUNCTION (this << lookahead);
+  NS_ASSERT_MSG (!m_running, "The lookahead is fixed while the simulation runs");
+  m_lookaheadTime = lookahead;
+  // a window holds at least one time step
+  m_lookahead = std::max<uint64_t> (lookahead.GetTimeStep (), 1);
+}
+
+Time
+ThreadedSimulatorImpl::GetLookahead (void) const
+{
+  return m_lookaheadTime;
+}
+
+bool
+ThreadedSimulatorImpl::IsRemote (const EventId &id) const
+{
+  // outside of the windows, the main thread owns all the logical processes
+  return m_currentLp != 0
+         && id.PeekEventImpl () != 0
+         && m_lps[GetLogicalProcess (id.GetContext ())] != m_currentLp;
+}
+
+void
+ThreadedSimulatorImpl::DeferCancel (const EventId &id, bool remove)
+{
+  if (id.GetTs () < m_windowStart)
+    {
+      // run or cancelled in a previous window
+      return;
+    }
+  if (id.GetTs () < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("Event of context " << id.GetContext () << " at " << id.GetTs ()
+                      << " cancelled from another logical process in the window which runs it; "
+                      << "the lookahead is " << m_lookahead);
+    }
+  RemoteCancel cancel;
+  cancel.id = id;
+  cancel.remove = remove;
+  m_currentLp->cancels.push_back (cancel);
+}
+
+void
+ThreadedSimulatorImpl::Insert (LogicalProcess *lp, Scheduler::Event &ev)
+{
+  ev.key.m_uid = lp->uid;
+  lp->uid++;
+  lp->events->Insert (ev);
+}
+
+void
+ThreadedSimulatorImpl::MergeOutboxes (void)
+{
+  // in the order of the senders, whatever thread ran them
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); i++)
+    {
+      std::vector<RemoteEvent> &outbox = (*i)->outbox;
+      for (std::vector<RemoteEvent>::iterator j = outbox.begin (); j != outbox.end (); j++)
+        {
+          Insert (m_lps[j->lp], j->event);
+        }
+      outbox.clear ();
+    }
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); i++)
+    {
+      std::vector<RemoteCancel> &cancels = (*i)->cancels;
+      for (std::vector<RemoteCancel>::iterator j = cancels.begin (); j != cancels.end (); j++)
+        {
+          if (j->remove)
+            {
+              Remove (j->id);
+            }
+          else
+            {
+              Cancel (j->id);
+            }
+        }
+      cancels.clear ();
+    }
+}
+
+uint64_t
+ThreadedSimulatorImpl::GetNextTs (void) const
+{
+  uint64_t next = ~0ULL;
+  for (std::vector<LogicalProcess *>::const_iterator i = m_lps.begin (); i != m_lps.end (); i++)
+    {
+      if (!(*i)->events->IsEmpty ())
+        {
+          next = std::min (next, (*i)->events->PeekNext ().key.m_ts);
+        }
+    }
+  return next;
+}
+
+bool
+ThreadedSimulatorImpl::IsFinished (void) const
+{
+  return m_stop || GetNextTs () == ~0ULL;
+}
+
+void
+ThreadedSimulatorImpl::RunWindow (uint32_t thread)
+{
+  for (uint32_t i = thread; i < m_nLps; i += m_nThreads)
+    {
+      LogicalProcess *lp = m_lps[i];
+      m_currentLp = lp;
+      while (!lp->events->IsEmpty ()
+             && lp->events->PeekNext ().key.m_ts < m_windowEnd)
+        {
+          Scheduler::Event next = lp->events->RemoveNext ();
+          NS_ASSERT (next.key.m_ts >= lp->currentTs);
+          lp->currentTs = next.key.m_ts;
+          lp->currentContext = next.key.m_context;
+          lp->currentUid = next.key.m_uid;
+          next.impl->Invoke ();
+          next.impl->Unref ();
+        }
+      m_currentLp = 0;
+    }
+}
+
+void
+ThreadedSimulatorImpl::Work (uint32_t thread)
+{
+  uint64_t window = 0;
+  while (true)
+    {
+      {
+        std::unique_lock<std::mutex> lock (m_barrierMutex);
+        m_windowStarted.wait (lock, [&] { return m_quit || m_window != window; });
+        if (m_quit)
+          {
+            return;
+          }
+        window = m_window;
+      }
+      RunWindow (thread);
+      {
+        std::lock_guard<std::mutex> lock (m_barrierMutex);
+        m_nDone++;
+      }
+      m_windowDone.notify_one ();
+    }
+}
+
+void
+ThreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT_MSG (m_currentLp == 0, "Simulator::Run called from an event");
+  m_stop = false;
+  m_running = true;
+  m_window = 0;
+  m_quit = false;
+  for (uint32_t thread = 1; thread < m_nThreads; thread++)
+    {
+      m_workers.push_back (std::thread (&ThreadedSimulatorImpl::Work, this, thread));
+    }
+
+  uint64_t stopTs;
+  while (true)
+    {
+      MergeOutboxes ();
+      uint64_t next = GetNextTs ();
+      stopTs = m_stopTs;
+      if (next >= stopTs || next == ~0ULL)
+        {
+          break;
+        }
+      m_windowStart = next;
+      m_windowEnd = std::min (next + std::min<uint64_t> (m_lookahead, ~0ULL - next), stopTs);
+      m_nWindows++;
+      {
+        std::lock_guard<std::mutex> lock (m_barrierMutex);
+        m_window++;
+        m_nDone = 0;
+      }
+      m_windowStarted.notify_all ();
+      RunWindow (0);
+      std::unique_lock<std::mutex> lock (m_barrierMutex);
+      m_windowDone.wait (lock, [this] { return m_nDone == m_nThreads - 1; });
+    }
+
+  {
+    std::lock_guard<std::mutex> lock (m_barrierMutex);
+    m_quit = true;
+  }
+  m_windowStarted.notify_all ();
+  for (std::vector<std::thread>::iterator i = m_workers.begin (); i != m_workers.end (); i++)
+    {
+      i->join ();
+    }
+  m_workers.clear ();
+  m_running = false;
+
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); i++)
+    {
+      m_currentTs = std::max (m_currentTs, (*i)->currentTs);
+    }
+  if (stopTs != ~0ULL)
+    {
+      // the run ends at the stop time, as with a stop event
+      m_stop = true;
+      m_currentTs = std::max (m_currentTs, stopTs);
+      m_stopTs = ~0ULL;
+    }
+  for (std::vector<LogicalProcess *>::iterator i = m_lps.begin (); i != m_lps.end (); i++)
+    {
+      if ((*i)->currentTs != m_currentTs)
+        {
+          // none of the pending events has run at the new time
+          (*i)->currentTs = m_currentTs;
+          (*i)->currentUid = 0;
+        }
+    }
+}
+
+void
+ThreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  Stop (TimeStep (0));
+}
+
+void
+ThreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  uint64_t ts = Now ().GetTimeStep () + delay.GetTimeStep ();
+  if (m_currentLp != 0)
+    {
+      // the other logical processes may be past it already
+      ts = std::max (ts, m_windowEnd);
+    }
+  uint64_t stopTs = m_stopTs;
+  while (ts < stopTs && !m_stopTs.compare_exchange_weak (stopTs, ts))
+    {
+    }
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+ThreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (m_currentLp != 0 || !m_running, "Simulator::Schedule Thread-unsafe invocation!");
+
+  LogicalProcess *lp = m_currentLp;
+  Scheduler::Event ev;
+  ev.impl = event;
+  if (lp == 0)
+    {
+      lp = m_lps[GetLogicalProcess (0xffffffff)];
+      ev.key.m_ts = m_currentTs;
+      ev.key.m_context = 0xffffffff;
+    }
+  else
+    {
+      ev.key.m_ts = lp->currentTs;
+      ev.key.m_context = lp->currentContext;
+    }
+  Time tAbsolute = delay + TimeStep (ev.key.m_ts);
+  NS_ASSERT (tAbsolute.IsPositive ());
+  NS_ASSERT (tAbsolute >= TimeStep (ev.key.m_ts));
+  ev.key.m_ts = (uint64_t) tAbsolute.GetTimeStep ();
+  Insert (lp, ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+ThreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (m_currentLp != 0 || !m_running, "Simulator::ScheduleWithContext Thread-unsafe invocation!");
+
+  uint32_t target = GetLogicalProcess (context);
+  LogicalProcess *lp = m_currentLp;
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = (uint64_t) (delay + (lp == 0 ? TimeStep (m_currentTs) : TimeStep (lp->currentTs))).GetTimeStep ();
+  ev.key.m_context = context;
+  if (lp == 0 || m_lps[target] == lp)
+    {
+      Insert (m_lps[target], ev);
+    }
+  else
+    {
+      if (ev.key.m_ts < m_windowEnd)
+        {
+          NS_FATAL_ERROR ("Event for context " << context << " scheduled with a delay of "
+                          << delay.GetTimeStep () << " while the lookahead is " << m_lookahead);
+        }
+      RemoteEvent remote;
+      remote.lp = target;
+      remote.event = ev;
+      lp->outbox.push_back (remote);
+    }
+}
+
+EventId
+ThreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return Schedule (TimeStep (0), event);
+}
+
+EventId
+ThreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  std::lock_guard<std::mutex> lock (m_destroyMutex);
+  EventId id (Ptr<EventImpl> (event, false), Now ().GetTimeStep (), 0xffffffff, 2);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+ThreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  return TimeStep (m_currentLp == 0 ? m_currentTs : m_currentLp->currentTs);
+}
+
+Time
+ThreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs ()) - Now ();
+    }
+}
+
+void
+ThreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      std::lock_guard<std::mutex> lock (m_destroyMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsRemote (id))
+    {
+      DeferCancel (id, true);
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  LogicalProcess *lp = m_lps[GetLogicalProcess (id.GetContext ())];
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  lp->events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+}
+
+void
+ThreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (id.GetUid () != 2 && IsRemote (id))
+    {
+      DeferCancel (id, false);
+      return;
+    }
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+ThreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      std::lock_guard<std::mutex> lock (m_destroyMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  if (id.PeekEventImpl () == 0)
+    {
+      return true;
+    }
+  if (IsRemote (id))
+    {
+      if (id.GetTs () < m_windowStart)
+        {
+          return true;
+        }
+      // the other logical process may run or cancel it meanwhile
+      NS_FATAL_ERROR ("State of an event of context " << id.GetContext ()
+                      << " asked from another logical process");
+    }
+  const LogicalProcess *lp = m_lps[GetLogicalProcess (id.GetContext ())];
+  if (id.GetTs () < lp->currentTs
+      || (id.GetTs () == lp->currentTs
+          && id.GetUid () <= lp->currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+ThreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+ThreadedSimulatorImpl::GetContext (void) const
+{
+  return m_currentLp == 0 ? 0xffffffff : m_currentLp->currentContext;
+}
+
+} // namespace ns3
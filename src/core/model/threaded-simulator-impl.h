@@ -0,0 +1,262 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef THREADED_SIMULATOR_IMPL_H
+#define THREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "nstime.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup simulator
+ * Declaration of class ns3::ThreadedSimulatorImpl.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * Conservative parallel simulator implementation running on the threads
+ * of a single process.
+ *
+ * The execution contexts (the node ids) are partitioned into logical
+ * processes, each with its own event list, clock and event uids. A pool
+ * of worker threads runs the logical processes in time windows: the
+ * window starts at the earliest pending event of all the logical processes
+ * and lasts Lookahead, and every thread runs the events of its logical
+ * processes which fall in the window before waiting for the others at a
+ * barrier. An event scheduled with ScheduleWithContext for a context of
+ * another logical process is kept aside until the barrier, so its delay
+ * must be at least Lookahead: this is the minimum delay of the messages
+ * between two partitions, e.g. the propagation delay between the closest
+ * nodes of two partitions.
+ *
+ * The events sent to other logical processes are merged at the barrier in
+ * the order of the sending logical processes, so the results do not
+ * depend on the number of threads, but only on the partition.
+ *
+ * By default, context c belongs to logical process c % LogicalProcesses
+ * and the events without context to logical process 0; SetLogicalProcess
+ * overrides the partition of a context before its first event.
+ *
+ * The events which fall at or after the stop time are not run. Stop
+ * called from an event with a delay shorter than the remaining time of
+ * the window takes effect at the end of the window.
+ *
+ * An event of another logical process can be cancelled or removed if it
+ * falls at or after the end of the window: this takes effect at the end
+ * of the window. Its state, IsExpired or GetDelayLeft, is only known in
+ * its own logical process, once the window which could run it is over.
+ *
+ * The models run concurrently must not share any state between
+ * partitions besides the events they exchange through
+ * ScheduleWithContext. The reference counts and the packet buffers are
+ * only safe to share between threads in a build configured with
+ * --enable-parallel-lps, and a packet sent to another partition must
+ * then be a Packet::CreateFullCopy, since its copies share their data.
+ * The packet metadata cannot be enabled with more than one thread.
+ */
+class ThreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  ThreadedSimulatorImpl ();
+  /** Destructor. */
+  ~ThreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (Time const &delay);
+  virtual EventId Schedule (Time const &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+
+  /**
+   * Assign a context to a logical process.
+   *
+   * \param context the context
+   * \param lp the logical process, smaller than LogicalProcesses
+   */
+  void SetLogicalProcess (uint32_t context, uint32_t lp);
+  /**
+   * \param context the context
+   * \return the logical process of the context
+   */
+  uint32_t GetLogicalProcess (uint32_t context) const;
+  /**
+   * \return the number of time windows run so far
+   */
+  uint64_t GetNWindows (void) const;
+  /**
+   * \param lookahead the minimum delay of the events scheduled for a
+   * context of another logical process
+   */
+  void SetLookahead (Time lookahead);
+  /**
+   * \return the minimum delay of the events scheduled for a context of
+   * another logical process
+   */
+  Time GetLookahead (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** An event sent to another logical process. */
+  struct RemoteEvent
+  {
+    uint32_t lp;            //!< The destination logical process.
+    Scheduler::Event event; //!< The event, without uid.
+  };
+
+  /** A cancel or a remove of an event of another logical process. */
+  struct RemoteCancel
+  {
+    EventId id;  //!< The event.
+    bool remove; //!< Whether the event is removed rather than cancelled.
+  };
+
+  /** The events and the clock of a partition. */
+  struct LogicalProcess
+  {
+    Ptr<Scheduler> events;           //!< The event list.
+    uint64_t currentTs;              //!< Timestamp of the current event.
+    uint32_t currentUid;             //!< Unique id of the current event.
+    uint32_t currentContext;         //!< Context of the current event.
+    uint32_t uid;                    //!< Next event unique id.
+    std::vector<RemoteEvent> outbox; //!< Events for the other logical processes.
+    std::vector<RemoteCancel> cancels; //!< Events of the other logical processes to cancel.
+  };
+
+  /** Create the logical processes, once the attributes are set. */
+  virtual void NotifyConstructionCompleted (void);
+  /**
+   * Insert an event in a logical process.
+   * \param lp the logical process
+   * \param ev the event, whose uid is set
+   */
+  void Insert (LogicalProcess *lp, Scheduler::Event &ev);
+  /**
+   * Move the events of the outboxes to their logical process, then
+   * cancel the events cancelled from other logical processes.
+   */
+  void MergeOutboxes (void);
+  /**
+   * \param id an event
+   * \return whether the event belongs to another logical process than
+   * the one of the calling thread
+   */
+  bool IsRemote (const EventId &id) const;
+  /**
+   * Cancel or remove an event of another logical process at the end of
+   * the window.
+   * \param id the event
+   * \param remove whether to remove the event rather than cancel it
+   */
+  void DeferCancel (const EventId &id, bool remove);
+  /**
+   * \return the timestamp of the earliest event of all the logical
+   * processes, or ~0 if there is none.
+   */
+  uint64_t GetNextTs (void) const;
+  /**
+   * Run the events of the logical processes of a thread in the current
+   * window.
+   * \param thread the thread index
+   */
+  void RunWindow (uint32_t thread);
+  /**
+   * Body of the worker threads.
+   * \param thread the thread index, from 1
+   */
+  void Work (uint32_t thread);
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Protects the destroy events. */
+  mutable std::mutex m_destroyMutex;
+
+  uint32_t m_nThreads;     //!< The number of threads.
+  uint32_t m_nLps;         //!< The number of logical processes.
+  Time m_lookaheadTime;    //!< The Lookahead attribute.
+  uint64_t m_lookahead;    //!< The window length, at least one time step.
+  ObjectFactory m_schedulerFactory; //!< Creates the event lists.
+  std::vector<LogicalProcess *> m_lps;         //!< The logical processes.
+  std::map<uint32_t, uint32_t> m_partition;    //!< Assigned contexts.
+
+  /** Time the run ends at, ~0 if Stop was not called. */
+  std::atomic<uint64_t> m_stopTs;
+  /** Flag calling for the end of the run. */
+  bool m_stop;
+  /** Whether Run is running the events. */
+  bool m_running;
+  /** Start of the current window. */
+  uint64_t m_windowStart;
+  /** End of the current window, excluded. */
+  uint64_t m_windowEnd;
+  /** Number of windows run. */
+  uint64_t m_nWindows;
+  /** Timestamp outside the time windows. */
+  uint64_t m_currentTs;
+
+  std::vector<std::thread> m_workers; //!< Threads 1 to m_nThreads - 1.
+  std::mutex m_barrierMutex;          //!< Protects the barrier state.
+  std::condition_variable m_windowStarted; //!< Signals the workers.
+  std::condition_variable m_windowDone;    //!< Signals the main thread.
+  uint64_t m_window;                  //!< Index of the window to run.
+  uint32_t m_nDone;                   //!< Workers done with the window.
+  bool m_quit;                        //!< Whether the workers must exit.
+
+  /** The logical process run by the calling thread, if any. */
+  static thread_local LogicalProcess *m_currentLp;
+};
+
+} // namespace ns3
+
+#endif /* THREADED_SIMULATOR_IMPL_H */
@@ -0,0 +1,313 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "timing-wheel-scheduler.h"
+#include "event-impl.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "log.h"
+#include <algorithm>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Implementation of ns3::TimingWheelScheduler class.
+ */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TimingWheelScheduler");
+
+NS_OBJECT_ENSURE_REGISTERED (TimingWheelScheduler);
+
+namespace {
+
+/**
+ * \ingroup scheduler
+ * Heap order of the events: the earliest event is at the top.
+ *
+ * \param [in] a The first event.
+ * \param [in] b The second event.
+ * \returns \c true if \c a is after \c b
+ */
+bool
+IsLater (const Scheduler::Event &a, const Scheduler::Event &b)
+{
+  return b.key < a.key;
+}
+
+} // anonymous namespace
+
+TypeId
+TimingWheelScheduler::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TimingWheelScheduler")
+    .SetParent<Scheduler> ()
+    .SetGroupName ("Core")
+    .AddConstructor<TimingWheelScheduler> ()
+    .AddAttribute ("BucketWidth",
+                   "The duration covered by a bucket of the wheel, "
+                   "rounded down to a power of two time steps.",
+                   TimeValue (NanoSeconds (8192)),
+                   MakeTimeAccessor (&TimingWheelScheduler::SetBucketWidth,
+                                     &TimingWheelScheduler::GetBucketWidth),
+                   MakeTimeChecker ())
+    .AddAttribute ("NBuckets",
+                   "The number of buckets of the wheel, "
+                   "rounded up to a power of two.",
+                   UintegerValue (8192),
+                   MakeUintegerAccessor (&TimingWheelScheduler::SetNBuckets,
+                                         &TimingWheelScheduler::GetNBuckets),
+                   MakeUintegerChecker<uint32_t> (1))
+  ;
+  return tid;
+}
+
+TimingWheelScheduler::TimingWheelScheduler ()
+  : m_currentSlot (0),
+    m_nWheelEvents (0),
+    m_widthShift (13)
+{
+  NS_LOG_FUNCTION (this);
+  SetNBuckets (8192);
+}
+
+TimingWheelScheduler::~TimingWheelScheduler ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TimingWheelScheduler::SetBucketWidth (Time width)
+{
+  NS_LOG_FUNCTION (this << width);
+  NS_ASSERT_MSG (IsEmpty (), "the bucket width cannot change while events are scheduled");
+  uint64_t steps = std::max<int64_t> (width.GetTimeStep (), 1);
+  m_widthShift = 0;
+  while (steps > 1)
+    {
+      steps >>= 1;
+      m_widthShift++;
+    }
+}
+
+Time
+TimingWheelScheduler::GetBucketWidth (void) const
+{
+  return TimeStep (static_cast<uint64_t> (1) << m_widthShift);
+}
+
+void
+TimingWheelScheduler::SetNBuckets (uint32_t nBuckets)
+{
+  NS_LOG_FUNCTION (this << nBuckets);
+  NS_ASSERT_MSG (IsEmpty (), "the number of buckets cannot change while events are scheduled");
+  uint32_t n = 1;
+  while (n < nBuckets)
+    {
+      n <<= 1;
+    }
+  m_buckets.assign (n, Bucket ());
+  m_nonEmpty.assign ((n + 63) / 64, 0);
+}
+
+uint32_t
+TimingWheelScheduler::GetNBuckets (void) const
+{
+  return m_buckets.size ();
+}
+
+uint64_t
+TimingWheelScheduler::GetSlot (uint64_t ts) const
+{
+  return ts >> m_widthShift;
+}
+
+void
+TimingWheelScheduler::Insert (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  uint64_t slot = GetSlot (ev.key.m_ts);
+  if (IsEmpty ())
+    {
+      m_currentSlot = slot;
+    }
+  if (slot <= m_currentSlot)
+    {
+      m_current.push_back (ev);
+      std::push_heap (m_current.begin (), m_current.end (), IsLater);
+    }
+  else if (slot - m_currentSlot < m_buckets.size ())
+    {
+      InsertInWheel (ev);
+    }
+  else
+    {
+      m_overflow.push_back (ev);
+      std::push_heap (m_overflow.begin (), m_overflow.end (), IsLater);
+    }
+}
+
+void
+TimingWheelScheduler::InsertInWheel (const Scheduler::Event &ev)
+{
+  uint32_t index = GetSlot (ev.key.m_ts) & (m_buckets.size () - 1);
+  m_buckets[index].push_back (ev);
+  m_nonEmpty[index / 64] |= static_cast<uint64_t> (1) << (index % 64);
+  m_nWheelEvents++;
+}
+
+bool
+TimingWheelScheduler::IsEmpty (void) const
+{
+  //the current bucket only gets empty when all the others are
+  return m_current.empty ();
+}
+
+Scheduler::Event
+TimingWheelScheduler::PeekNext (void) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  return m_current.front ();
+}
+
+Scheduler::Event
+TimingWheelScheduler::RemoveNext (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (!IsEmpty ());
+  std::pop_heap (m_current.begin (), m_current.end (), IsLater);
+  Scheduler::Event next = m_current.back ();
+  m_current.pop_back ();
+  if (m_current.empty ())
+    {
+      Turn ();
+    }
+  return next;
+}
+
+void
+TimingWheelScheduler::Remove (const Scheduler::Event &ev)
+{
+  NS_LOG_FUNCTION (this << ev.impl << ev.key.m_ts << ev.key.m_uid);
+  NS_ASSERT (!IsEmpty ());
+  uint64_t slot = GetSlot (ev.key.m_ts);
+  bool found;
+  if (slot <= m_currentSlot)
+    {
+      found = Remove (m_current, ev, true);
+      if (m_current.empty ())
+        {
+          Turn ();
+        }
+    }
+  else if (slot - m_currentSlot < m_buckets.size ())
+    {
+      uint32_t index = slot & (m_buckets.size () - 1);
+      found = Remove (m_buckets[index], ev, false);
+      m_nWheelEvents--;
+      if (m_buckets[index].empty ())
+        {
+          m_nonEmpty[index / 64] &= ~(static_cast<uint64_t> (1) << (index % 64));
+        }
+    }
+  else
+    {
+      found = Remove (m_overflow, ev, true);
+    }
+  NS_ASSERT_MSG (found, "event not scheduled");
+}
+
+bool
+TimingWheelScheduler::Remove (std::vector<Scheduler::Event> &events,
+                              const Scheduler::Event &ev, bool isHeap)
+{
+  for (std::vector<Scheduler::Event>::iterator i = events.begin (); i != events.end (); ++i)
+    {
+      if (i->key.m_uid == ev.key.m_uid)
+        {
+          *i = events.back ();
+          events.pop_back ();
+          if (isHeap)
+            {
+              std::make_heap (events.begin (), events.end (), IsLater);
+            }
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+TimingWheelScheduler::Turn (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (m_current.empty ());
+  uint32_t mask = m_buckets.size () - 1;
+  if (m_nWheelEvents > 0)
+    {
+      //first non-empty bucket after the current one, around the wheel
+      uint32_t start = (m_currentSlot + 1) & mask;
+      uint32_t word = start / 64;
+      uint64_t bits = m_nonEmpty[word] & (~static_cast<uint64_t> (0) << (start % 64));
+      while (bits == 0)
+        {
+          word = (word + 1) % m_nonEmpty.size ();
+          bits = m_nonEmpty[word];
+        }
+      uint32_t index = word * 64;
+      while ((bits & 1) == 0)
+        {
+          bits >>= 1;
+          index++;
+        }
+      m_currentSlot += 1 + ((index - start) & mask);
+    }
+  else if (!m_overflow.empty ())
+    {
+      m_currentSlot = GetSlot (m_overflow.front ().key.m_ts);
+    }
+  else
+    {
+      return;
+    }
+
+  uint32_t index = m_currentSlot & mask;
+  m_current.swap (m_buckets[index]);
+  m_nWheelEvents -= m_current.size ();
+  m_nonEmpty[index / 64] &= ~(static_cast<uint64_t> (1) << (index % 64));
+
+  //the overflow events which are now within the wheel
+  while (!m_overflow.empty ()
+         && GetSlot (m_overflow.front ().key.m_ts) - m_currentSlot < m_buckets.size ())
+    {
+      std::pop_heap (m_overflow.begin (), m_overflow.end (), IsLater);
+      if (GetSlot (m_overflow.back ().key.m_ts) == m_currentSlot)
+        {
+          m_current.push_back (m_overflow.back ());
+        }
+      else
+        {
+          InsertInWheel (m_overflow.back ());
+        }
+      m_overflow.pop_back ();
+    }
+  std::make_heap (m_current.begin (), m_current.end (), IsLater);
+}
+
+} // namespace ns3
@@ -0,0 +1,156 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef TIMING_WHEEL_SCHEDULER_H
+#define TIMING_WHEEL_SCHEDULER_H
+
+#include "scheduler.h"
+#include "nstime.h"
+#include <stdint.h>
+#include <vector>
+
+/**
+ * \file
+ * \ingroup scheduler
+ * Declaration of ns3::TimingWheelScheduler class.
+ */
+
+namespace ns3 {
+
+class EventImpl;
+
+/**
+ * \ingroup scheduler
+ * \brief a timing wheel event scheduler with a heap for distant events
+ *
+ * The near future is divided in NBuckets buckets of BucketWidth each,
+ * starting with the bucket of the next event: the wheel. An event
+ * scheduled within the wheel is appended, unsorted, to its bucket; an
+ * event scheduled beyond the wheel goes to an overflow heap. Only the
+ * bucket of the next event, the current bucket, is kept sorted, as a
+ * binary heap. When the current bucket is exhausted, the wheel turns to
+ * the next non-empty bucket (found through a bitmap of the non-empty
+ * buckets) and the overflow events which entered the wheel are moved to
+ * their buckets.
+ *
+ * This suits event sets made of many near-future events (PHY and backoff
+ * events, a few microseconds ahead) mixed with long-horizon periodic
+ * ones (beacons, application periods, duty-cycle waits): the former cost
+ * O(1) to insert and O(log n) to remove, with n the number of events of
+ * their bucket, the latter O(log m) with m the number of events beyond
+ * the wheel, whatever the spread of the event times.
+ *
+ * The events are ordered exactly as by the other schedulers, by time
+ * then by uid, so the simulation results do not depend on the scheduler.
+ * The bucket width is rounded down, and the number of buckets up, to a
+ * power of two; both can only be set while the scheduler is empty.
+ */
+class TimingWheelScheduler : public Scheduler
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  TimingWheelScheduler ();
+  /** Destructor. */
+  virtual ~TimingWheelScheduler ();
+
+  // Inherited
+  virtual void Insert (const Scheduler::Event &ev);
+  virtual bool IsEmpty (void) const;
+  virtual Scheduler::Event PeekNext (void) const;
+  virtual Scheduler::Event RemoveNext (void);
+  virtual void Remove (const Scheduler::Event &ev);
+
+private:
+  /**
+   * Set the duration of a bucket.
+   *
+   * \param [in] width The bucket width.
+   */
+  void SetBucketWidth (Time width);
+  /**
+   * \returns The bucket width.
+   */
+  Time GetBucketWidth (void) const;
+  /**
+   * Set the number of buckets of the wheel.
+   *
+   * \param [in] nBuckets The number of buckets.
+   */
+  void SetNBuckets (uint32_t nBuckets);
+  /**
+   * \returns The number of buckets of the wheel.
+   */
+  uint32_t GetNBuckets (void) const;
+
+  /**
+   * \param [in] ts The event time stamp.
+   * \returns The index of the time slot of a bucket width holding ts.
+   */
+  uint64_t GetSlot (uint64_t ts) const;
+  /**
+   * Insert an event in its bucket of the wheel.
+   *
+   * \param [in] ev The event, within the wheel and after the current bucket.
+   */
+  void InsertInWheel (const Scheduler::Event &ev);
+  /**
+   * Move to the current bucket the events of the next non-empty bucket
+   * of the wheel or, if the wheel is empty, of the overflow heap.
+   */
+  void Turn (void);
+
+  /** Binary heap of events, the earliest first. */
+  typedef std::vector<Scheduler::Event> Heap;
+  /** Unsorted list of events. */
+  typedef std::vector<Scheduler::Event> Bucket;
+
+  /**
+   * Remove an event from a container.
+   *
+   * \param [in,out] events The container.
+   * \param [in] ev The event to remove.
+   * \param [in] isHeap Whether the container is a heap.
+   * \returns \c true if the event was found.
+   */
+  static bool Remove (std::vector<Scheduler::Event> &events,
+                      const Scheduler::Event &ev, bool isHeap);
+
+  /** Events of the current bucket, and the late ones. */
+  Heap m_current;
+  /** The buckets of the wheel, indexed by slot modulo the number of buckets. */
+  std::vector<Bucket> m_buckets;
+  /** One bit per bucket of the wheel, set if the bucket is not empty. */
+  std::vector<uint64_t> m_nonEmpty;
+  /** Events beyond the wheel. */
+  Heap m_overflow;
+  /** Time slot of the current bucket. */
+  uint64_t m_currentSlot;
+  /** Number of events in the buckets of the wheel. */
+  uint32_t m_nWheelEvents;
+  /** Log2 of the bucket width, in time steps. */
+  uint32_t m_widthShift;
+};
+
+} // namespace ns3
+
+#endif /* TIMING_WHEEL_SCHEDULER_H */
@@ -24,6 +24,33 @@
 #include <list>
 #include "callback.h"
 
+/**
+ * \ingroup tracing
+ * Fire a TracedCallback of a trace group, if a Callback is connected.
+ *
+ * The arguments are only evaluated when the trace is fired, so that the
+ * packet copies and the values computed for a trace cost nothing when
+ * nobody listens to it.
+ *
+ * A trace group is a macro defined to \c true by the module of the trace,
+ * or to \c false when the group is listed in the --disable-trace-groups
+ * option of waf configure: the trace and its arguments are then compiled
+ * out, and the Callbacks connected to the trace source are never invoked.
+ *
+ * \param [in] group The trace group.
+ * \param [in] trace The TracedCallback.
+ * \param [in] ... The arguments of the trace.
+ */
+#define NS_TRACE(group, trace, ...)                                     \
+  do                                                                    \
+    {                                                                   \
+      if ((group) && !(trace).IsEmpty ())                               \
+        {                                                               \
+          (trace) (__VA_ARGS__);                                        \
+        }                                                               \
+    }                                                                   \
+  while (false)
+
 /**
  * \file
  * \ingroup tracing
@@ -209,6 +236,14 @@ public:
   void operator() (T1 a1, T2 a2, T3 a3, T4 a4, T5 a5, T6 a6, T7 a7, T8 a8) const;
   /**@}*/
 
+  /**
+   * Check whether the chain is empty, to skip computing the arguments
+   * of a trace nobody listens to, see NS_TRACE.
+   *
+   * \return \c true if no Callback is connected.
+   */
+  bool IsEmpty (void) const;
+
   /**
    *  TracedCallback signature for POD.
    *
@@ -432,6 +467,16 @@ TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::operator() (T1 a1, T2 a2, T3 a3, T4 a4,
     }
 }
 
+template<typename T1, typename T2,
+         typename T3, typename T4,
+         typename T5, typename T6,
+         typename T7, typename T8>
+bool
+TracedCallback<T1,T2,T3,T4,T5,T6,T7,T8>::IsEmpty (void) const
+{
+  return m_callbackList.empty ();
+}
+
 } // namespace ns3
 
 #endif /* TRACED_CALLBACK_H */
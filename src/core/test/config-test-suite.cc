@@ -721,6 +721,110 @@ SearchAttributesOfParentObjectsTestCase::DoRun (void)
 
 }
 
+// ===========================================================================
+// Test for the ability to look up a Config::Path, with and without its
+// first * item bound to an index, with the same results as the path string.
+// ===========================================================================
+class PathConfigTestCase : public TestCase
+{
+public:
+  PathConfigTestCase ();
+  virtual ~PathConfigTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Check that two containers hold the same objects with the same contexts.
+   *
+   * \param [in] found The objects found by a Config::Path.
+   * \param [in] expected The objects found by the path string.
+   * \param [in] n The expected number of objects.
+   */
+  void CheckMatches (Config::MatchContainer found, Config::MatchContainer expected, uint32_t n);
+};
+
+PathConfigTestCase::PathConfigTestCase ()
+  : TestCase ("Check that Config::Path finds the objects the path string finds")
+{
+}
+
+void
+PathConfigTestCase::CheckMatches (Config::MatchContainer found, Config::MatchContainer expected, uint32_t n)
+{
+  NS_TEST_ASSERT_MSG_EQ (found.GetN (), n, "Unexpected number of matches");
+  NS_TEST_ASSERT_MSG_EQ (expected.GetN (), n, "Unexpected number of matches of the path string");
+  for (uint32_t i = 0; i < n; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (found.Get (i), expected.Get (i), "Unexpected object");
+      NS_TEST_ASSERT_MSG_EQ (found.GetMatchedPath (i), expected.GetMatchedPath (i), "Unexpected context");
+    }
+}
+
+void
+PathConfigTestCase::DoRun (void)
+{
+  Ptr<ConfigTestObject> root = CreateObject<ConfigTestObject> ();
+  Config::RegisterRootNamespaceObject (root);
+  Ptr<ConfigTestObject> a = CreateObject<ConfigTestObject> ();
+  root->SetNodeA (a);
+
+  //
+  // Add four objects to the NodesA vector, each with a NodeB.
+  //
+  std::vector<Ptr<ConfigTestObject> > nodesB;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Ptr<ConfigTestObject> node = CreateObject<ConfigTestObject> ();
+      Ptr<ConfigTestObject> b = CreateObject<ConfigTestObject> ();
+      node->SetNodeB (b);
+      a->AddNodeA (node);
+      nodesB.push_back (b);
+    }
+
+  Config::Path path ("NodeA/NodesA/*/NodeB");
+  NS_TEST_ASSERT_MSG_EQ (path.GetPath (), "/NodeA/NodesA/*/NodeB/", "Path not canonicalized");
+  CheckMatches (path.LookupMatches (), Config::LookupMatches ("/NodeA/NodesA/*/NodeB"), 4);
+
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      std::ostringstream oss;
+      oss << "/NodeA/NodesA/" << i << "/NodeB";
+      Config::MatchContainer matches = path.LookupMatches (i);
+      CheckMatches (matches, Config::LookupMatches (oss.str ()), 1);
+      NS_TEST_ASSERT_MSG_EQ (matches.Get (0), nodesB[i], "Unexpected object at index " << i);
+      NS_TEST_ASSERT_MSG_EQ (matches.GetMatchedPath (0), oss.str () + "/", "Unexpected context at index " << i);
+    }
+  NS_TEST_ASSERT_MSG_EQ (path.LookupMatches (4).GetN (), 0, "Match past the end of the vector");
+
+  //
+  // Indices which select a single object in other forms than its decimal
+  // index still give the decimal index in the context.
+  //
+  const char *single[] = {"[2-2]", "02", "[02-2]"};
+  for (uint32_t i = 0; i < sizeof (single) / sizeof (single[0]); i++)
+    {
+      std::string item = single[i];
+      Config::MatchContainer matches = Config::LookupMatches ("/NodeA/NodesA/" + item + "/NodeB");
+      NS_TEST_ASSERT_MSG_EQ (matches.GetN (), 1, "Unexpected number of matches of " << item);
+      NS_TEST_ASSERT_MSG_EQ (matches.Get (0), nodesB[2], "Unexpected object for " << item);
+      NS_TEST_ASSERT_MSG_EQ (matches.GetMatchedPath (0), "/NodeA/NodesA/2/NodeB/", "Unexpected context for " << item);
+      CheckMatches (Config::Path ("/NodeA/NodesA/" + item + "/NodeB").LookupMatches (), matches, 1);
+    }
+
+  Config::Path alternatives ("/NodeA/NodesA/[0-1]|3/NodeB/");
+  CheckMatches (alternatives.LookupMatches (), Config::LookupMatches ("/NodeA/NodesA/[0-1]|3/NodeB"), 3);
+
+  //
+  // The * item of an attribute name is not an index but is bound all the same.
+  //
+  Config::Path attributes ("/*/NodesA/2");
+  CheckMatches (attributes.LookupMatches (), Config::LookupMatches ("/*/NodesA/2"), 1);
+  NS_TEST_ASSERT_MSG_EQ (attributes.LookupMatches (0).GetN (), 0, "Unexpected match of attribute 0");
+
+  Config::UnregisterRootNamespaceObject (root);
+}
+
 // ===========================================================================
 // The Test Suite that glues all of the Test Cases together.
 // ===========================================================================
@@ -737,6 +841,7 @@ ConfigTestSuite::ConfigTestSuite ()
   AddTestCase (new UnderRootNamespaceConfigTestCase, TestCase::QUICK);
   AddTestCase (new ObjectVectorConfigTestCase, TestCase::QUICK);
   AddTestCase (new SearchAttributesOfParentObjectsTestCase, TestCase::QUICK);
+  AddTestCase (new PathConfigTestCase, TestCase::QUICK);
 }
 
 static ConfigTestSuite configTestSuite;
@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/event-impl.h"
+#include "ns3/make-event.h"
+#include "ns3/system-wall-clock-ms.h"
+#include <iostream>
+#include <vector>
+
+using namespace ns3;
+
+// ===========================================================================
+// Recycling of the memory of the events
+// ===========================================================================
+
+struct LargeArgument
+{
+  uint8_t bytes[EventImpl::MAX_POOLED_SIZE];
+};
+
+class EventImplPoolTestCase : public TestCase
+{
+public:
+  EventImplPoolTestCase ();
+  virtual ~EventImplPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+  void Small (void);
+  void Large (LargeArgument argument);
+};
+
+EventImplPoolTestCase::EventImplPoolTestCase ()
+  : TestCase ("Check that the memory of the events is recycled")
+{
+}
+
+EventImplPoolTestCase::~EventImplPoolTestCase ()
+{
+}
+
+void
+EventImplPoolTestCase::Small (void)
+{
+}
+
+void
+EventImplPoolTestCase::Large (LargeArgument argument)
+{
+}
+
+void
+EventImplPoolTestCase::DoRun (void)
+{
+  //an event freed is the next one allocated of its size
+  EventImpl *event = MakeEvent (&EventImplPoolTestCase::Small, this);
+  event->Unref ();
+  EventImpl *reused = MakeEvent (&EventImplPoolTestCase::Small, this);
+  NS_TEST_ASSERT_MSG_EQ (reused, event, "memory of the event not reused");
+
+  //no allocation from the system while events are recycled
+  uint64_t nAllocations = EventImpl::GetNSystemAllocations ();
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      reused->Unref ();
+      reused = MakeEvent (&EventImplPoolTestCase::Small, this);
+    }
+  reused->Unref ();
+  NS_TEST_ASSERT_MSG_EQ (EventImpl::GetNSystemAllocations (), nAllocations, "events not recycled");
+
+  //events of the same size are allocated from slabs
+  std::vector<EventImpl *> events;
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      events.push_back (MakeEvent (&EventImplPoolTestCase::Small, this));
+    }
+  NS_TEST_ASSERT_MSG_LT (EventImpl::GetNSystemAllocations () - nAllocations, 100, "events not allocated by slabs");
+  for (uint32_t i = 0; i < events.size (); i++)
+    {
+      events[i]->Unref ();
+    }
+
+  //large events bypass the free lists
+  LargeArgument argument;
+  nAllocations = EventImpl::GetNSystemAllocations ();
+  EventImpl *large = MakeEvent (&EventImplPoolTestCase::Large, this, argument);
+  NS_TEST_ASSERT_MSG_EQ (EventImpl::GetNSystemAllocations () - nAllocations, 1, "large event not allocated by the system");
+  large->Invoke ();
+  large->Unref ();
+}
+
+// ===========================================================================
+// Number of allocations and run time of the events of a channel fan-out
+// ===========================================================================
+
+class EventImplPoolBenchmarkTestCase : public TestCase
+{
+public:
+  EventImplPoolBenchmarkTestCase (uint32_t nEvents);
+  virtual ~EventImplPoolBenchmarkTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Send a frame to all the receivers of the channel, and schedule the
+   * next frame.
+   */
+  void Send (uint32_t sender);
+  /**
+   * Receive a frame.
+   */
+  void Receive (uint32_t sender, uint32_t receiver, double rxPower);
+
+  uint32_t m_nEvents;    //!< number of events to run
+  uint32_t m_nReceived;  //!< number of frames received
+};
+
+EventImplPoolBenchmarkTestCase::EventImplPoolBenchmarkTestCase (uint32_t nEvents)
+  : TestCase ("Count the system allocations of the events of a channel fan-out"),
+    m_nEvents (nEvents),
+    m_nReceived (0)
+{
+}
+
+EventImplPoolBenchmarkTestCase::~EventImplPoolBenchmarkTestCase ()
+{
+}
+
+static const uint32_t N_SENDERS = 10;
+static const uint32_t N_RECEIVERS = 100;
+
+void
+EventImplPoolBenchmarkTestCase::Send (uint32_t sender)
+{
+  for (uint32_t i = 0; i < N_RECEIVERS; i++)
+    {
+      Simulator::ScheduleWithContext (i, NanoSeconds (10 + i), &EventImplPoolBenchmarkTestCase::Receive,
+                                      this, sender, i, -80.0);
+    }
+  if (m_nReceived < m_nEvents)
+    {
+      Simulator::Schedule (MicroSeconds (1), &EventImplPoolBenchmarkTestCase::Send, this, sender);
+    }
+}
+
+void
+EventImplPoolBenchmarkTestCase::Receive (uint32_t sender, uint32_t receiver, double rxPower)
+{
+  m_nReceived++;
+}
+
+void
+EventImplPoolBenchmarkTestCase::DoRun (void)
+{
+  uint64_t nAllocations = EventImpl::GetNSystemAllocations ();
+  SystemWallClockMs clock;
+  clock.Start ();
+  for (uint32_t i = 0; i < N_SENDERS; i++)
+    {
+      Simulator::Schedule (NanoSeconds (i), &EventImplPoolBenchmarkTestCase::Send, this, i);
+    }
+  Simulator::Run ();
+  int64_t ms = clock.End ();
+  Simulator::Destroy ();
+  nAllocations = EventImpl::GetNSystemAllocations () - nAllocations;
+
+  std::cout << GetName () << ": " << m_nReceived << " events received, "
+            << nAllocations << " system allocations, "
+            << ms << " ms" << std::endl;
+  //without the pool, every event is a system allocation
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (m_nReceived, m_nEvents, "not all the events were run");
+  NS_TEST_ASSERT_MSG_LT (nAllocations, m_nReceived / 100, "events not recycled");
+}
+
+class EventImplPoolTestSuite : public TestSuite
+{
+public:
+  EventImplPoolTestSuite ();
+};
+
+EventImplPoolTestSuite::EventImplPoolTestSuite ()
+  : TestSuite ("event-impl-pool", UNIT)
+{
+  AddTestCase (new EventImplPoolTestCase, TestCase::QUICK);
+}
+
+static EventImplPoolTestSuite eventImplPoolTestSuite;
+
+class EventImplPoolBenchmarkTestSuite : public TestSuite
+{
+public:
+  EventImplPoolBenchmarkTestSuite ();
+};
+
+EventImplPoolBenchmarkTestSuite::EventImplPoolBenchmarkTestSuite ()
+  : TestSuite ("event-impl-pool-benchmark", PERFORMANCE)
+{
+  AddTestCase (new EventImplPoolBenchmarkTestCase (10000000), TestCase::TAKES_FOREVER);
+}
+
+static EventImplPoolBenchmarkTestSuite eventImplPoolBenchmarkTestSuite;
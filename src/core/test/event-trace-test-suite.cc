@@ -0,0 +1,203 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/event-trace.h"
+
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Records written from events and from other threads, read back.
+ */
+class EventTraceRoundTripTestCase : public TestCase
+{
+public:
+  EventTraceRoundTripTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * \param node The node.
+   * \param i The index of the record.
+   */
+  void Send (uint32_t node, uint32_t i);
+  /**
+   * \param thread The thread index.
+   */
+  void Produce (uint32_t thread);
+  /**
+   * \param i The index of the record.
+   * \return The count argument, which is only evaluated when tracing.
+   */
+  uint32_t Count (uint32_t i);
+
+  uint16_t m_send;        //!< The event type written from events.
+  uint16_t m_thread;      //!< The event type written from threads.
+  uint16_t m_empty;       //!< An event type without fields.
+  uint32_t m_nEvaluated;  //!< The calls to Count.
+
+  static const uint32_t N_EVENTS = 10000;
+  static const uint32_t N_THREADS = 3;
+};
+
+EventTraceRoundTripTestCase::EventTraceRoundTripTestCase ()
+  : TestCase ("Check the records written and read back"),
+    m_nEvaluated (0)
+{
+}
+
+uint32_t
+EventTraceRoundTripTestCase::Count (uint32_t i)
+{
+  m_nEvaluated++;
+  return i;
+}
+
+void
+EventTraceRoundTripTestCase::Send (uint32_t node, uint32_t i)
+{
+  NS_EVENT_TRACE (m_send, node, Count (i), -static_cast<int64_t> (i), i * 0.5);
+  if (i % 1000 == 0)
+    {
+      NS_EVENT_TRACE (m_empty, node);
+    }
+}
+
+void
+EventTraceRoundTripTestCase::Produce (uint32_t thread)
+{
+  for (uint32_t i = 0; i < N_EVENTS; i++)
+    {
+      EventTrace::Write (m_thread, thread, i, thread);
+    }
+}
+
+void
+EventTraceRoundTripTestCase::DoRun (void)
+{
+  m_send = EventTrace::Register ("EventTraceTest", "Send", "count:u delta:i ratio:d");
+  m_thread = EventTrace::Register ("EventTraceTest", "Thread", "index:u thread:u");
+  m_empty = EventTrace::Register ("Other", "Empty", "");
+  NS_TEST_ASSERT_MSG_EQ (EventTrace::Register ("EventTraceTest", "Send", "count:u delta:i ratio:d"),
+                         m_send, "registered again");
+
+  // nothing is evaluated nor written without a file
+  Send (0, 1);
+  NS_TEST_ASSERT_MSG_EQ (m_nEvaluated, 0, "fields evaluated without a file");
+
+  std::string filename = CreateTempDirFilename ("event-trace.bin");
+  EventTrace::Open (filename);
+  NS_TEST_ASSERT_MSG_EQ (EventTrace::IsEnabled (), true, "file not open");
+  for (uint32_t i = 0; i < N_EVENTS; i++)
+    {
+      Simulator::ScheduleWithContext (i % 7, MicroSeconds (i),
+                                      &EventTraceRoundTripTestCase::Send, this, i % 7, i);
+    }
+  Simulator::Run ();
+  Simulator::Destroy ();
+  std::vector<std::thread> threads;
+  for (uint32_t t = 0; t < N_THREADS; t++)
+    {
+      threads.push_back (std::thread (&EventTraceRoundTripTestCase::Produce, this, t));
+    }
+  for (uint32_t t = 0; t < N_THREADS; t++)
+    {
+      threads[t].join ();
+    }
+  EventTrace::Close ();
+  NS_TEST_ASSERT_MSG_EQ (EventTrace::IsEnabled (), false, "file not closed");
+  NS_TEST_ASSERT_MSG_EQ (m_nEvaluated, N_EVENTS, "fields not evaluated");
+
+  EventTraceReader reader;
+  NS_TEST_ASSERT_MSG_EQ (reader.Open (filename), true, "cannot read " << filename);
+  NS_TEST_ASSERT_MSG_EQ (reader.GetResolution (), Time::GetResolution (), "resolution");
+  EventTrace::Record record;
+  uint32_t nSent = 0;
+  uint32_t nEmpty = 0;
+  std::vector<uint32_t> nThread (N_THREADS, 0);
+  while (reader.Read (record))
+    {
+      const EventTrace::Type *type = reader.GetType (record.type);
+      NS_TEST_ASSERT_MSG_NE (type, 0, "record before its type");
+      if (record.type == m_send)
+        {
+          int64_t delta = record.fields[1];
+          double ratio;
+          std::memcpy (&ratio, &record.fields[2], sizeof (ratio));
+          NS_TEST_ASSERT_MSG_EQ (record.fields[0], nSent, "records out of order");
+          NS_TEST_ASSERT_MSG_EQ (delta, -static_cast<int64_t> (nSent), "signed field");
+          NS_TEST_ASSERT_MSG_EQ (ratio, nSent * 0.5, "double field");
+          NS_TEST_ASSERT_MSG_EQ (record.time, MicroSeconds (nSent).GetTimeStep (), "time");
+          NS_TEST_ASSERT_MSG_EQ (record.node, nSent % 7, "node");
+          NS_TEST_ASSERT_MSG_EQ (record.component, type->component, "component");
+          nSent++;
+        }
+      else if (record.type == m_thread)
+        {
+          uint32_t thread = record.node;
+          NS_TEST_ASSERT_MSG_LT (thread, N_THREADS, "thread");
+          NS_TEST_ASSERT_MSG_EQ (record.fields[0], nThread[thread], "thread records out of order");
+          NS_TEST_ASSERT_MSG_EQ (record.fields[1], thread, "thread field");
+          nThread[thread]++;
+        }
+      else
+        {
+          NS_TEST_ASSERT_MSG_EQ (record.type, m_empty, "unknown type");
+          nEmpty++;
+        }
+    }
+  NS_TEST_ASSERT_MSG_EQ (nSent, N_EVENTS, "missing records");
+  NS_TEST_ASSERT_MSG_EQ (nEmpty, N_EVENTS / 1000, "missing records without fields");
+  for (uint32_t t = 0; t < N_THREADS; t++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (nThread[t], N_EVENTS, "missing records of thread " << t);
+    }
+
+  const EventTrace::Type *send = reader.GetType (m_send);
+  NS_TEST_ASSERT_MSG_EQ (send->componentName, "EventTraceTest", "component name");
+  NS_TEST_ASSERT_MSG_EQ (send->name, "Send", "event name");
+  NS_TEST_ASSERT_MSG_EQ (send->fields.size (), 3, "fields");
+  NS_TEST_ASSERT_MSG_EQ (send->fields[1].name, "delta", "field name");
+  NS_TEST_ASSERT_MSG_EQ (send->fields[1].kind, 'i', "field kind");
+  NS_TEST_ASSERT_MSG_EQ (send->fields[2].kind, 'd', "field kind");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetType (m_thread)->component, send->component, "same component");
+  NS_TEST_ASSERT_MSG_NE (reader.GetType (m_empty)->component, send->component, "other component");
+  NS_TEST_ASSERT_MSG_EQ (reader.GetType (m_empty)->fields.size (), 0, "no fields");
+  std::remove (filename.c_str ());
+}
+
+/**
+ * The event trace test suite.
+ */
+class EventTraceTestSuite : public TestSuite
+{
+public:
+  EventTraceTestSuite ();
+};
+
+EventTraceTestSuite::EventTraceTestSuite ()
+  : TestSuite ("event-trace", UNIT)
+{
+  AddTestCase (new EventTraceRoundTripTestCase, TestCase::QUICK);
+}
+
+static EventTraceTestSuite g_eventTraceTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/memory-pool.h"
+#include <thread>
+#include <vector>
+
+using namespace ns3;
+
+// ===========================================================================
+// Recycling of the blocks within a thread
+// ===========================================================================
+
+class MemoryPoolTestCase : public TestCase
+{
+public:
+  MemoryPoolTestCase ();
+  virtual ~MemoryPoolTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MemoryPoolTestCase::MemoryPoolTestCase ()
+  : TestCase ("Check that the blocks are recycled by size class")
+{
+}
+
+MemoryPoolTestCase::~MemoryPoolTestCase ()
+{
+}
+
+void
+MemoryPoolTestCase::DoRun (void)
+{
+  //a block freed is the next one allocated of its size class
+  void *block = MemoryPool::Allocate (48);
+  MemoryPool::Deallocate (block, 48);
+  void *reused = MemoryPool::Allocate (33);
+  NS_TEST_ASSERT_MSG_EQ (reused, block, "block not reused within its size class");
+  MemoryPool::Deallocate (reused, 33);
+
+  //no allocation from the system while blocks are recycled
+  uint64_t nAllocations = MemoryPool::GetNSystemAllocations ();
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      MemoryPool::Deallocate (MemoryPool::Allocate (48), 48);
+    }
+  NS_TEST_ASSERT_MSG_EQ (MemoryPool::GetNSystemAllocations (), nAllocations, "blocks not recycled");
+
+  //large blocks bypass the free lists
+  block = MemoryPool::Allocate (MemoryPool::MAX_SIZE + 1);
+  NS_TEST_ASSERT_MSG_EQ (MemoryPool::GetNSystemAllocations () - nAllocations, 1, "large block not allocated by the system");
+  MemoryPool::Deallocate (block, MemoryPool::MAX_SIZE + 1);
+  MemoryPool::Deallocate (0, 48);
+}
+
+// ===========================================================================
+// Recycling of the blocks across threads
+// ===========================================================================
+
+class MemoryPoolThreadsTestCase : public TestCase
+{
+public:
+  MemoryPoolThreadsTestCase ();
+  virtual ~MemoryPoolThreadsTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+MemoryPoolThreadsTestCase::MemoryPoolThreadsTestCase ()
+  : TestCase ("Check that the blocks of a thread are reused by other threads")
+{
+}
+
+MemoryPoolThreadsTestCase::~MemoryPoolThreadsTestCase ()
+{
+}
+
+/** Size of the blocks allocated by the threads of the test. */
+static const std::size_t BLOCK_SIZE = 200;
+/** Number of blocks allocated by a thread of the test. */
+static const uint32_t N_BLOCKS = 10000;
+
+/**
+ * Allocate blocks.
+ *
+ * \param [out] blocks The blocks.
+ */
+static void
+AllocateBlocks (std::vector<void *> *blocks)
+{
+  for (uint32_t i = 0; i < N_BLOCKS; i++)
+    {
+      blocks->push_back (MemoryPool::Allocate (BLOCK_SIZE));
+    }
+}
+
+/**
+ * Free blocks.
+ *
+ * \param [in,out] blocks The blocks.
+ */
+static void
+DeallocateBlocks (std::vector<void *> *blocks)
+{
+  for (uint32_t i = 0; i < blocks->size (); i++)
+    {
+      MemoryPool::Deallocate ((*blocks)[i], BLOCK_SIZE);
+    }
+  blocks->clear ();
+}
+
+void
+MemoryPoolThreadsTestCase::DoRun (void)
+{
+  std::vector<void *> blocks;
+
+  //the blocks of a thread which exits are reused by the next threads
+  std::thread first ([&blocks] () { AllocateBlocks (&blocks); DeallocateBlocks (&blocks); });
+  first.join ();
+  uint64_t nAllocations = MemoryPool::GetNSystemAllocations ();
+  std::thread second ([&blocks] () { AllocateBlocks (&blocks); DeallocateBlocks (&blocks); });
+  second.join ();
+  NS_TEST_ASSERT_MSG_EQ (MemoryPool::GetNSystemAllocations (), nAllocations, "blocks of an exited thread not reused");
+
+  //the blocks freed by another thread than the allocating one are reused
+  //by the allocating thread, instead of piling up in the freeing thread
+  std::thread allocator ([&blocks] () { AllocateBlocks (&blocks); });
+  allocator.join ();
+  DeallocateBlocks (&blocks);
+  nAllocations = MemoryPool::GetNSystemAllocations ();
+  std::thread next ([&blocks] () { AllocateBlocks (&blocks); });
+  next.join ();
+  NS_TEST_ASSERT_MSG_LT (MemoryPool::GetNSystemAllocations () - nAllocations, 10,
+                         "blocks freed by another thread not reused");
+  DeallocateBlocks (&blocks);
+}
+
+class MemoryPoolTestSuite : public TestSuite
+{
+public:
+  MemoryPoolTestSuite ();
+};
+
+MemoryPoolTestSuite::MemoryPoolTestSuite ()
+  : TestSuite ("memory-pool", UNIT)
+{
+  AddTestCase (new MemoryPoolTestCase, TestCase::QUICK);
+  AddTestCase (new MemoryPoolThreadsTestCase, TestCase::QUICK);
+}
+
+static MemoryPoolTestSuite memoryPoolTestSuite;
@@ -21,6 +21,7 @@
 #include "ns3/test.h"
 #include "ns3/object.h"
 #include "ns3/object-factory.h"
+#include "ns3/object-handle.h"
 #include "ns3/assert.h"
 
 namespace {
@@ -431,6 +432,97 @@ ObjectFactoryTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_NE (a->GetObject<DerivedA> (), 0, "Unexpectedly able to work around C++ type system");
 }
 
+// ===========================================================================
+// Test case to make sure that the lookups cached in an aggregate and the
+// ObjectHandle follow the aggregation
+// ===========================================================================
+class AggregateLookupTestCase : public TestCase
+{
+public:
+  AggregateLookupTestCase ();
+  virtual ~AggregateLookupTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AggregateLookupTestCase::AggregateLookupTestCase ()
+  : TestCase ("Check the cached aggregate lookups and ObjectHandle")
+{
+}
+
+AggregateLookupTestCase::~AggregateLookupTestCase ()
+{
+}
+
+void
+AggregateLookupTestCase::DoRun (void)
+{
+  Ptr<BaseA> baseA = CreateObject<BaseA> ();
+  ObjectHandle<BaseB> handleB (baseA);
+  ObjectHandle<DerivedB> handleDerivedB (baseA);
+  NS_TEST_ASSERT_MSG_EQ (handleB.IsBound (), true, "The handle has an aggregate");
+  NS_TEST_ASSERT_MSG_EQ (ObjectHandle<BaseB> ().IsBound (), false, "The handle has no aggregate");
+
+  //
+  // The failed lookups, cached or not, must not hide the Objects aggregated
+  // afterwards.
+  //
+  for (int i = 0; i < 2; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), 0, "Unexpectedly found a BaseB");
+      NS_TEST_ASSERT_MSG_EQ (handleB.Get (), 0, "Unexpectedly found a BaseB through the handle");
+    }
+  Ptr<DerivedB> derivedB = CreateObject<DerivedB> ();
+  baseA->AggregateObject (derivedB);
+  for (int i = 0; i < 2; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<BaseB> (), derivedB, "BaseB not found after the aggregation");
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<DerivedB> (), derivedB, "DerivedB not found after the aggregation");
+      NS_TEST_ASSERT_MSG_EQ (derivedB->GetObject<BaseA> (), baseA, "BaseA not found from the other side");
+      NS_TEST_ASSERT_MSG_EQ (baseA->GetObject<DerivedA> (), 0, "Unexpectedly found a DerivedA");
+      NS_TEST_ASSERT_MSG_EQ (handleB.Get (), derivedB, "BaseB not found through the handle");
+      NS_TEST_ASSERT_MSG_EQ (handleDerivedB.Get (), derivedB, "DerivedB not found through the handle");
+    }
+
+  //
+  // The types looked up share the slots of the cache.
+  //
+  std::vector<TypeId> tids;
+  tids.push_back (BaseA::GetTypeId ());
+  tids.push_back (DerivedA::GetTypeId ());
+  tids.push_back (BaseB::GetTypeId ());
+  tids.push_back (DerivedB::GetTypeId ());
+  tids.push_back (Object::GetTypeId ());
+  for (uint32_t i = 0; i < TypeId::GetRegisteredN (); i++)
+    {
+      tids.push_back (TypeId::GetRegistered (i));
+    }
+  for (int pass = 0; pass < 2; pass++)
+    {
+      for (std::vector<TypeId>::const_iterator i = tids.begin (); i != tids.end (); i++)
+        {
+          Ptr<Object> found = baseA->GetObject<Object> (*i);
+          if (*i == BaseA::GetTypeId ())
+            {
+              NS_TEST_ASSERT_MSG_EQ (found, baseA, "Wrong object for " << i->GetName ());
+            }
+          else if (*i == BaseB::GetTypeId () || *i == DerivedB::GetTypeId ())
+            {
+              NS_TEST_ASSERT_MSG_EQ (found, derivedB, "Wrong object for " << i->GetName ());
+            }
+          else if (*i == Object::GetTypeId ())
+            {
+              NS_TEST_ASSERT_MSG_EQ ((found == baseA || found == derivedB), true, "Wrong object for " << i->GetName ());
+            }
+          else
+            {
+              NS_TEST_ASSERT_MSG_EQ (found, 0, "Unexpectedly found " << i->GetName ());
+            }
+        }
+    }
+}
+
 // ===========================================================================
 // The Test Suite that glues the Test Cases together.
 // ===========================================================================
@@ -446,6 +538,7 @@ ObjectTestSuite::ObjectTestSuite ()
   AddTestCase (new CreateObjectTestCase, TestCase::QUICK);
   AddTestCase (new AggregateObjectTestCase, TestCase::QUICK);
   AddTestCase (new ObjectFactoryTestCase, TestCase::QUICK);
+  AddTestCase (new AggregateLookupTestCase, TestCase::QUICK);
 }
 
 static ObjectTestSuite objectTestSuite;
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/rng-stream.h"
+#include "ns3/random-variable-stream.h"
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Check that the values drawn in batches are the ones drawn one by one.
+ */
+class RandomVariableBatchTestCase : public TestCase
+{
+public:
+  RandomVariableBatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+
+  /**
+   * Compare the values of two variables of the same stream, one drawn
+   * one by one and the other in batches of increasing sizes.
+   * \param single The variable drawn one by one.
+   * \param batch The variable drawn in batches.
+   * \param name The name of the variable, for the messages.
+   */
+  void Compare (Ptr<RandomVariableStream> single, Ptr<RandomVariableStream> batch, std::string name);
+};
+
+RandomVariableBatchTestCase::RandomVariableBatchTestCase ()
+  : TestCase ("Check the random values drawn in batches")
+{
+}
+
+void
+RandomVariableBatchTestCase::Compare (Ptr<RandomVariableStream> single,
+                                      Ptr<RandomVariableStream> batch, std::string name)
+{
+  std::vector<double> values (100);
+  for (uint32_t n = 0; n < values.size (); n++)
+    {
+      batch->GetValues (&values[0], n);
+      for (uint32_t i = 0; i < n; i++)
+        {
+          NS_TEST_ASSERT_MSG_EQ (values[i], single->GetValue (),
+                                 name << ": value " << i << " of the batch of " << n);
+        }
+      // and the stream goes on after the batch
+      NS_TEST_ASSERT_MSG_EQ (batch->GetValue (), single->GetValue (), name << ": after the batch of " << n);
+    }
+}
+
+void
+RandomVariableBatchTestCase::DoRun (void)
+{
+  RngStream single (1, 3, 5);
+  RngStream batch (single);
+  double values[1000];
+  batch.RandU01 (values, 1000);
+  for (uint32_t i = 0; i < 1000; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (values[i], single.RandU01 (), "RngStream value " << i);
+    }
+
+  Ptr<UniformRandomVariable> u1 = CreateObject<UniformRandomVariable> ();
+  Ptr<UniformRandomVariable> u2 = CreateObject<UniformRandomVariable> ();
+  u1->SetStream (10);
+  u2->SetStream (10);
+  u1->SetAttribute ("Min", DoubleValue (-3.5));
+  u1->SetAttribute ("Max", DoubleValue (7.25));
+  u2->SetAttribute ("Min", DoubleValue (-3.5));
+  u2->SetAttribute ("Max", DoubleValue (7.25));
+  Compare (u1, u2, "uniform");
+
+  u1->SetAntithetic (true);
+  u2->SetAntithetic (true);
+  Compare (u1, u2, "antithetic uniform");
+
+  u2->GetValues (values, 10, 2, 4);
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (values[i], u1->GetValue (2, 4), "uniform in a range, value " << i);
+    }
+
+  // the distributions without a batch implementation
+  Ptr<NormalRandomVariable> n1 = CreateObject<NormalRandomVariable> ();
+  Ptr<NormalRandomVariable> n2 = CreateObject<NormalRandomVariable> ();
+  n1->SetStream (11);
+  n2->SetStream (11);
+  Compare (n1, n2, "normal");
+}
+
+/**
+ * The batch random values test suite.
+ */
+class RandomVariableBatchTestSuite : public TestSuite
+{
+public:
+  RandomVariableBatchTestSuite ();
+};
+
+RandomVariableBatchTestSuite::RandomVariableBatchTestSuite ()
+  : TestSuite ("random-variable-batch", UNIT)
+{
+  AddTestCase (new RandomVariableBatchTestCase, TestCase::QUICK);
+}
+
+static RandomVariableBatchTestSuite g_randomVariableBatchTestSuite; //!< Static variable for test initialization
@@ -23,6 +23,10 @@
 #include "ns3/heap-scheduler.h"
 #include "ns3/map-scheduler.h"
 #include "ns3/calendar-scheduler.h"
+#include "ns3/timing-wheel-scheduler.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+#include <map>
 
 using namespace ns3;
 
@@ -459,6 +463,89 @@ SimulatorTemplateTestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+class SchedulerOrderTestCase : public TestCase
+{
+public:
+  SchedulerOrderTestCase (ObjectFactory schedulerFactory);
+  virtual void DoRun (void);
+  ObjectFactory m_schedulerFactory;
+};
+
+SchedulerOrderTestCase::SchedulerOrderTestCase (ObjectFactory schedulerFactory)
+  : TestCase ("Check that events are removed in the same order as with the MapScheduler with " +
+              schedulerFactory.GetTypeId ().GetName ()),
+    m_schedulerFactory (schedulerFactory)
+{
+}
+
+void
+SchedulerOrderTestCase::DoRun (void)
+{
+  Ptr<Scheduler> scheduler = m_schedulerFactory.Create<Scheduler> ();
+  Ptr<Scheduler> reference = CreateObject<MapScheduler> ();
+  std::map<uint32_t, Scheduler::Event> pending;
+  uint64_t now = 0;
+  uint32_t uid = 0;
+  uint32_t random = 1;
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      random = random * 1103515245 + 12345;
+      uint32_t action = (random >> 16) % 8;
+      if (action < 5 || pending.empty ())
+        {
+          //short, medium and long delays, and ties
+          random = random * 1103515245 + 12345;
+          uint64_t delay = (random >> 16) % 1000;
+          if (action == 1)
+            {
+              delay *= 1000;
+            }
+          else if (action == 2)
+            {
+              delay *= 1000000;
+            }
+          else if (action == 3)
+            {
+              delay = 0;
+            }
+          Scheduler::Event ev;
+          ev.impl = 0;
+          ev.key.m_ts = now + delay;
+          ev.key.m_uid = uid++;
+          ev.key.m_context = 0;
+          scheduler->Insert (ev);
+          reference->Insert (ev);
+          pending[ev.key.m_uid] = ev;
+        }
+      else if (action == 5)
+        {
+          //cancel a pending event
+          random = random * 1103515245 + 12345;
+          std::map<uint32_t, Scheduler::Event>::iterator ev = pending.lower_bound ((random >> 16) % uid);
+          if (ev == pending.end ())
+            {
+              ev = pending.begin ();
+            }
+          scheduler->Remove (ev->second);
+          reference->Remove (ev->second);
+          pending.erase (ev);
+        }
+      else
+        {
+          Scheduler::Event next = reference->RemoveNext ();
+          NS_TEST_ASSERT_MSG_EQ (scheduler->PeekNext ().key.m_uid, next.key.m_uid, "wrong next event");
+          NS_TEST_ASSERT_MSG_EQ (scheduler->RemoveNext ().key.m_uid, next.key.m_uid, "wrong removed event");
+          pending.erase (next.key.m_uid);
+          now = next.key.m_ts;
+        }
+    }
+  while (!reference->IsEmpty ())
+    {
+      NS_TEST_ASSERT_MSG_EQ (scheduler->RemoveNext ().key.m_uid, reference->RemoveNext ().key.m_uid, "wrong removed event");
+    }
+  NS_TEST_ASSERT_MSG_EQ (scheduler->IsEmpty (), true, "events left");
+}
+
 class SimulatorTestSuite : public TestSuite
 {
 public:
@@ -475,5 +562,12 @@ public:
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
     factory.SetTypeId (CalendarScheduler::GetTypeId ());
     AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    factory.SetTypeId (TimingWheelScheduler::GetTypeId ());
+    AddTestCase (new SimulatorEventsTestCase (factory), TestCase::QUICK);
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
+    //small wheel, to go around it and through the overflow heap often
+    factory.Set ("BucketWidth", TimeValue (NanoSeconds (64)));
+    factory.Set ("NBuckets", UintegerValue (128));
+    AddTestCase (new SchedulerOrderTestCase (factory), TestCase::QUICK);
   }
 } g_simulatorTestSuite;
@@ -0,0 +1,391 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/test.h"
+#include "ns3/simulator.h"
+#include "ns3/threaded-simulator-impl.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/nstime.h"
+
+#include <algorithm>
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * Messages relayed between contexts, each with a local timer, run with
+ * several simulator implementations and thread counts.
+ */
+class ThreadedSimulatorImplRelayTestCase : public TestCase
+{
+public:
+  ThreadedSimulatorImplRelayTestCase ();
+
+private:
+  /// What a context has seen
+  struct Entry
+  {
+    uint64_t ts;    //!< the time
+    uint32_t from;  //!< the sender, or the context for the timers
+    uint32_t hop;   //!< the number of relays
+    bool operator < (const Entry &o) const
+    {
+      return ts < o.ts || (ts == o.ts && (from < o.from || (from == o.from && hop < o.hop)));
+    }
+    bool operator == (const Entry &o) const
+    {
+      return ts == o.ts && from == o.from && hop == o.hop;
+    }
+  };
+  typedef std::vector<std::vector<Entry> > Logs;
+
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+
+  /**
+   * Run the relays.
+   * \param type the simulator implementation
+   * \param threads the number of threads
+   * \param stop the stop time, zero for none
+   * \return what the contexts have seen
+   */
+  Logs Relay (std::string type, uint32_t threads, Time stop);
+  void Receive (uint32_t context, uint32_t from, uint32_t hop, Time expected);
+  void Timer (uint32_t context, uint32_t hop, Time expected);
+  void Cancelled (uint32_t context);
+
+  Logs m_logs;                  //!< what the contexts have seen
+  std::vector<uint32_t> m_errors; //!< wrong time or context per context
+
+  static const uint32_t N_CONTEXTS = 16;
+  static const uint32_t N_HOPS = 200;
+};
+
+ThreadedSimulatorImplRelayTestCase::ThreadedSimulatorImplRelayTestCase ()
+  : TestCase ("Relays between the logical processes")
+{
+}
+
+void
+ThreadedSimulatorImplRelayTestCase::Receive (uint32_t context, uint32_t from, uint32_t hop, Time expected)
+{
+  Entry entry = { static_cast<uint64_t> (Simulator::Now ().GetTimeStep ()), from, hop };
+  m_logs[context].push_back (entry);
+  if (Simulator::Now () != expected || Simulator::GetContext () != context)
+    {
+      m_errors[context]++;
+    }
+  if (hop == N_HOPS)
+    {
+      return;
+    }
+  // at least the lookahead for the other contexts
+  Time delay = MicroSeconds (1 + (context + hop) % 5);
+  uint32_t to = (context * 7 + hop + 1) % N_CONTEXTS;
+  Simulator::ScheduleWithContext (to, delay, &ThreadedSimulatorImplRelayTestCase::Receive,
+                                  this, to, context, hop + 1, Simulator::Now () + delay);
+  // and anything locally
+  Time local = NanoSeconds (100 * (hop % 3));
+  Simulator::Schedule (local, &ThreadedSimulatorImplRelayTestCase::Timer, this, context, hop,
+                       Simulator::Now () + local);
+  EventId cancelled = Simulator::Schedule (NanoSeconds (10), &ThreadedSimulatorImplRelayTestCase::Cancelled, this, context);
+  EventId removed = Simulator::Schedule (NanoSeconds (20), &ThreadedSimulatorImplRelayTestCase::Cancelled, this, context);
+  if (cancelled.IsExpired () || Simulator::GetDelayLeft (removed) != NanoSeconds (20))
+    {
+      m_errors[context]++;
+    }
+  cancelled.Cancel ();
+  Simulator::Remove (removed);
+  if (!cancelled.IsExpired () || !removed.IsExpired ())
+    {
+      m_errors[context]++;
+    }
+}
+
+void
+ThreadedSimulatorImplRelayTestCase::Timer (uint32_t context, uint32_t hop, Time expected)
+{
+  Entry entry = { static_cast<uint64_t> (Simulator::Now ().GetTimeStep ()), context, hop };
+  m_logs[context].push_back (entry);
+  if (Simulator::Now () != expected || Simulator::GetContext () != context)
+    {
+      m_errors[context]++;
+    }
+}
+
+void
+ThreadedSimulatorImplRelayTestCase::Cancelled (uint32_t context)
+{
+  m_errors[context]++;
+}
+
+ThreadedSimulatorImplRelayTestCase::Logs
+ThreadedSimulatorImplRelayTestCase::Relay (std::string type, uint32_t threads, Time stop)
+{
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Threads", UintegerValue (threads));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::LogicalProcesses", UintegerValue (4));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (1)));
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (type));
+
+  m_logs = Logs (N_CONTEXTS);
+  m_errors = std::vector<uint32_t> (N_CONTEXTS, 0);
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      Time start = NanoSeconds (10 * context);
+      Simulator::ScheduleWithContext (context, start, &ThreadedSimulatorImplRelayTestCase::Receive,
+                                      this, context, context, 0, start);
+    }
+  if (!stop.IsZero ())
+    {
+      Simulator::Stop (stop);
+    }
+  Simulator::Run ();
+  if (!stop.IsZero ())
+    {
+      NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), stop, type << " with " << threads << " threads did not stop at the stop time");
+    }
+  Simulator::Destroy ();
+
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_errors[context], 0, type << " with " << threads << " threads ran wrong events in context " << context);
+    }
+  return m_logs;
+}
+
+void
+ThreadedSimulatorImplRelayTestCase::DoRun (void)
+{
+  Logs expected = Relay ("ns3::DefaultSimulatorImpl", 1, Time ());
+  Logs single = Relay ("ns3::ThreadedSimulatorImpl", 1, Time ());
+  uint32_t nEntries = 0;
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      nEntries += expected[context].size ();
+      // the same events, with the events of a time step in another order
+      std::vector<Entry> sorted = single[context];
+      std::sort (sorted.begin (), sorted.end ());
+      std::sort (expected[context].begin (), expected[context].end ());
+      NS_TEST_EXPECT_MSG_EQ ((sorted == expected[context]), true, "Different events in context " << context);
+    }
+  NS_TEST_EXPECT_MSG_EQ (nEntries, 2 * N_CONTEXTS * N_HOPS + N_CONTEXTS, "Lost events");
+
+  // whatever the number of threads, in the same order
+  uint32_t threads[] = { 2, 3, 4, 8 };
+  for (uint32_t i = 0; i < sizeof (threads) / sizeof (threads[0]); i++)
+    {
+      Logs logs = Relay ("ns3::ThreadedSimulatorImpl", threads[i], Time ());
+      NS_TEST_EXPECT_MSG_EQ ((logs == single), true, "Different events with " << threads[i] << " threads");
+    }
+
+  Time stop = MicroSeconds (50);
+  Logs stopped = Relay ("ns3::ThreadedSimulatorImpl", 4, stop);
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      std::vector<Entry> until;
+      for (std::vector<Entry>::const_iterator i = single[context].begin (); i != single[context].end (); i++)
+        {
+          if (i->ts < static_cast<uint64_t> (stop.GetTimeStep ()))
+            {
+              until.push_back (*i);
+            }
+        }
+      NS_TEST_EXPECT_MSG_EQ ((stopped[context] == until), true, "Different events before the stop in context " << context);
+    }
+}
+
+void
+ThreadedSimulatorImplRelayTestCase::DoTeardown (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Threads", UintegerValue (1));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::LogicalProcesses", UintegerValue (0));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Lookahead", TimeValue (NanoSeconds (1)));
+}
+
+/**
+ * Events scheduled before and between the runs, and the lookahead.
+ */
+class ThreadedSimulatorImplWindowTestCase : public TestCase
+{
+public:
+  ThreadedSimulatorImplWindowTestCase ();
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+  void Count (void);
+
+  uint32_t m_count; //!< the events run
+};
+
+ThreadedSimulatorImplWindowTestCase::ThreadedSimulatorImplWindowTestCase ()
+  : TestCase ("Time windows and runs")
+{
+}
+
+void
+ThreadedSimulatorImplWindowTestCase::Count (void)
+{
+  m_count++;
+}
+
+void
+ThreadedSimulatorImplWindowTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Threads", UintegerValue (2));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Lookahead", TimeValue (MilliSeconds (10)));
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::ThreadedSimulatorImpl"));
+  m_count = 0;
+
+  Ptr<ThreadedSimulatorImpl> impl = DynamicCast<ThreadedSimulatorImpl> (Simulator::GetImplementation ());
+  NS_TEST_ASSERT_MSG_NE (impl, 0, "Not the threaded simulator");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetLogicalProcess (5), 1, "Context 5 out of 2 logical processes");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetLogicalProcess (0xffffffff), 0, "The events without context go first");
+  impl->SetLogicalProcess (5, 0);
+  NS_TEST_EXPECT_MSG_EQ (impl->GetLogicalProcess (5), 0, "Context 5 not moved");
+
+  // one window for both events, one for the last one
+  Simulator::Schedule (MilliSeconds (1), &ThreadedSimulatorImplWindowTestCase::Count, this);
+  Simulator::ScheduleWithContext (1, MilliSeconds (5), &ThreadedSimulatorImplWindowTestCase::Count, this);
+  Simulator::ScheduleWithContext (3, MilliSeconds (25), &ThreadedSimulatorImplWindowTestCase::Count, this);
+  Simulator::Stop (MilliSeconds (20));
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 2, "Events run before the stop");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (20), "Stopped at the wrong time");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::IsFinished (), true, "Stopped");
+  NS_TEST_EXPECT_MSG_EQ (impl->GetNWindows (), 1, "Wrong number of windows");
+
+  // resumes where it stopped
+  Simulator::ScheduleWithContext (2, MilliSeconds (1), &ThreadedSimulatorImplWindowTestCase::Count, this);
+  EventId last = Simulator::Schedule (MilliSeconds (1), &ThreadedSimulatorImplWindowTestCase::Count, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_count, 5, "Events run after the stop");
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (25), "Wrong end of the simulation");
+  NS_TEST_EXPECT_MSG_EQ (last.IsExpired (), true, "The event has run");
+  Simulator::Destroy ();
+}
+
+void
+ThreadedSimulatorImplWindowTestCase::DoTeardown (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Threads", UintegerValue (1));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::LogicalProcesses", UintegerValue (0));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Lookahead", TimeValue (NanoSeconds (1)));
+}
+
+/**
+ * Events cancelled and removed from another logical process.
+ */
+class ThreadedSimulatorImplCancelTestCase : public TestCase
+{
+public:
+  ThreadedSimulatorImplCancelTestCase ();
+
+private:
+  virtual void DoRun (void);
+  virtual void DoTeardown (void);
+  /// Schedule the events, in context 1
+  void Arm (void);
+  /// Cancel and remove them, in context 0
+  void Disarm (void);
+  void Count (void);
+  void Fail (void);
+
+  EventId m_cancelled; //!< cancelled from context 0
+  EventId m_removed;   //!< removed from context 0
+  EventId m_kept;      //!< runs
+  uint32_t m_count;    //!< the events run
+  uint32_t m_failed;   //!< the cancelled events run
+};
+
+ThreadedSimulatorImplCancelTestCase::ThreadedSimulatorImplCancelTestCase ()
+  : TestCase ("Events cancelled from another logical process")
+{
+}
+
+void
+ThreadedSimulatorImplCancelTestCase::Arm (void)
+{
+  m_cancelled = Simulator::Schedule (MicroSeconds (10), &ThreadedSimulatorImplCancelTestCase::Fail, this);
+  m_removed = Simulator::Schedule (MicroSeconds (10), &ThreadedSimulatorImplCancelTestCase::Fail, this);
+  m_kept = Simulator::Schedule (MicroSeconds (10), &ThreadedSimulatorImplCancelTestCase::Count, this);
+}
+
+void
+ThreadedSimulatorImplCancelTestCase::Disarm (void)
+{
+  m_cancelled.Cancel ();
+  Simulator::Remove (m_removed);
+}
+
+void
+ThreadedSimulatorImplCancelTestCase::Count (void)
+{
+  m_count++;
+}
+
+void
+ThreadedSimulatorImplCancelTestCase::Fail (void)
+{
+  m_failed++;
+}
+
+void
+ThreadedSimulatorImplCancelTestCase::DoRun (void)
+{
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Threads", UintegerValue (2));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (1)));
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::ThreadedSimulatorImpl"));
+  m_count = 0;
+  m_failed = 0;
+
+  Simulator::ScheduleWithContext (1, Seconds (0), &ThreadedSimulatorImplCancelTestCase::Arm, this);
+  Simulator::ScheduleWithContext (0, MicroSeconds (2), &ThreadedSimulatorImplCancelTestCase::Disarm, this);
+  Simulator::Run ();
+  NS_TEST_EXPECT_MSG_EQ (m_failed, 0, "Cancelled events run");
+  NS_TEST_EXPECT_MSG_EQ (m_count, 1, "Event not run");
+  NS_TEST_EXPECT_MSG_EQ (m_cancelled.IsExpired (), true, "Cancelled event pending");
+  NS_TEST_EXPECT_MSG_EQ (m_removed.IsExpired (), true, "Removed event pending");
+  m_cancelled = EventId ();
+  m_removed = EventId ();
+  m_kept = EventId ();
+  Simulator::Destroy ();
+}
+
+void
+ThreadedSimulatorImplCancelTestCase::DoTeardown (void)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Threads", UintegerValue (1));
+  Config::SetDefault ("ns3::ThreadedSimulatorImpl::Lookahead", TimeValue (NanoSeconds (1)));
+}
+
+class ThreadedSimulatorImplTestSuite : public TestSuite
+{
+public:
+  ThreadedSimulatorImplTestSuite ()
+    : TestSuite ("threaded-simulator-impl")
+  {
+    AddTestCase (new ThreadedSimulatorImplWindowTestCase, TestCase::QUICK);
+    AddTestCase (new ThreadedSimulatorImplRelayTestCase, TestCase::QUICK);
+    AddTestCase (new ThreadedSimulatorImplCancelTestCase, TestCase::QUICK);
+  }
+} g_threadedSimulatorImplTestSuite;
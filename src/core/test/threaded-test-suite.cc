@@ -225,6 +225,95 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+class ThreadedSimulatorOrderTestCase : public TestCase
+{
+public:
+  ThreadedSimulatorOrderTestCase ();
+  void Receive (unsigned int threadno, unsigned int delay, unsigned int seq);
+  void KeepAlive (void);
+  static void SchedulingThread (std::pair<ThreadedSimulatorOrderTestCase *, unsigned int> context);
+
+  static const unsigned int THREADS = 4;
+  static const unsigned int EVENTS = 2000;
+  static const unsigned int DELAYS = 3;
+  unsigned int m_received;
+  int m_last[THREADS][DELAYS];
+  std::string m_error;
+
+private:
+  virtual void DoRun (void);
+};
+
+ThreadedSimulatorOrderTestCase::ThreadedSimulatorOrderTestCase ()
+  : TestCase ("Check that the events of a thread with the same delay keep their order")
+{
+}
+
+void
+ThreadedSimulatorOrderTestCase::SchedulingThread (std::pair<ThreadedSimulatorOrderTestCase *, unsigned int> context)
+{
+  ThreadedSimulatorOrderTestCase *me = context.first;
+  unsigned int threadno = context.second;
+  for (unsigned int seq = 0; seq < EVENTS; ++seq)
+    {
+      unsigned int delay = seq % DELAYS;
+      Simulator::ScheduleWithContext (threadno, MicroSeconds (delay),
+                                      &ThreadedSimulatorOrderTestCase::Receive, me, threadno, delay, seq);
+    }
+}
+
+void
+ThreadedSimulatorOrderTestCase::Receive (unsigned int threadno, unsigned int delay, unsigned int seq)
+{
+  if (Simulator::GetContext () != threadno || int (seq) <= m_last[threadno][delay])
+    {
+      m_error = "Bad threaded scheduling order";
+    }
+  m_last[threadno][delay] = seq;
+  ++m_received;
+}
+
+void
+ThreadedSimulatorOrderTestCase::KeepAlive (void)
+{
+  if (m_received < THREADS * EVENTS)
+    {
+      Simulator::Schedule (MicroSeconds (1), &ThreadedSimulatorOrderTestCase::KeepAlive, this);
+    }
+}
+
+void
+ThreadedSimulatorOrderTestCase::DoRun (void)
+{
+  m_received = 0;
+  for (unsigned int i = 0; i < THREADS; ++i)
+    {
+      for (unsigned int j = 0; j < DELAYS; ++j)
+        {
+          m_last[i][j] = -1;
+        }
+    }
+
+  Simulator::Schedule (MicroSeconds (1), &ThreadedSimulatorOrderTestCase::KeepAlive, this);
+  std::list<Ptr<SystemThread> > threads;
+  for (unsigned int i = 0; i < THREADS; ++i)
+    {
+      threads.push_back (Create<SystemThread> (MakeBoundCallback (
+          &ThreadedSimulatorOrderTestCase::SchedulingThread,
+          std::pair<ThreadedSimulatorOrderTestCase *, unsigned int> (this, i))));
+      threads.back ()->Start ();
+    }
+  Simulator::Run ();
+  for (std::list<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+    {
+      (*it)->Join ();
+    }
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_error.empty (), true, m_error.c_str ());
+  NS_TEST_EXPECT_MSG_EQ (m_received, THREADS * EVENTS, "Lost events");
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -262,5 +351,6 @@ public:
               }
           }
       }
+    AddTestCase (new ThreadedSimulatorOrderTestCase, TestCase::QUICK);
   }
 } g_threadedSimulatorTestSuite;
@@ -108,6 +108,71 @@ BasicTracedCallbackTestCase::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_two, true, "Callback CbTwo not called");
 }
 
+class GroupTracedCallbackTestCase : public TestCase
+{
+public:
+  GroupTracedCallbackTestCase ();
+  virtual ~GroupTracedCallbackTestCase () {}
+
+private:
+  virtual void DoRun (void);
+
+  void Cb (uint8_t a, double b);
+  double Argument (void);
+
+  uint32_t m_calls;
+  uint32_t m_arguments;
+};
+
+GroupTracedCallbackTestCase::GroupTracedCallbackTestCase ()
+  : TestCase ("Check the traces fired with NS_TRACE")
+{
+}
+
+void
+GroupTracedCallbackTestCase::Cb (uint8_t a, double b)
+{
+  m_calls++;
+}
+
+double
+GroupTracedCallbackTestCase::Argument (void)
+{
+  m_arguments++;
+  return 2;
+}
+
+void
+GroupTracedCallbackTestCase::DoRun (void)
+{
+  TracedCallback<uint8_t, double> trace;
+  m_calls = 0;
+  m_arguments = 0;
+
+  //
+  // Without any callback, the arguments are not computed.
+  //
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "No callback connected");
+  NS_TRACE (true, trace, 1, Argument ());
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 0, "Argument computed for nobody");
+
+  trace.ConnectWithoutContext (MakeCallback (&GroupTracedCallbackTestCase::Cb, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), false, "Callback connected");
+  NS_TRACE (true, trace, 1, Argument ());
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Callback not called");
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 1, "Argument not computed");
+
+  //
+  // A disabled group fires nothing.
+  //
+  NS_TRACE (false, trace, 1, Argument ());
+  NS_TEST_ASSERT_MSG_EQ (m_calls, 1, "Callback of a disabled group called");
+  NS_TEST_ASSERT_MSG_EQ (m_arguments, 1, "Argument of a disabled group computed");
+
+  trace.DisconnectWithoutContext (MakeCallback (&GroupTracedCallbackTestCase::Cb, this));
+  NS_TEST_ASSERT_MSG_EQ (trace.IsEmpty (), true, "Callback disconnected");
+}
+
 class TracedCallbackTestSuite : public TestSuite
 {
 public:
@@ -118,6 +183,7 @@ TracedCallbackTestSuite::TracedCallbackTestSuite ()
   : TestSuite ("traced-callback", UNIT)
 {
   AddTestCase (new BasicTracedCallbackTestCase, TestCase::QUICK);
+  AddTestCase (new GroupTracedCallbackTestCase, TestCase::QUICK);
 }
 
 static TracedCallbackTestSuite tracedCallbackTestSuite;
@@ -22,8 +22,10 @@
 #include "ns3/log.h"
 #include "ns3/assert.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/trace-source-accessor.h"
 #include "ns3/simulator.h"
+#include <cmath>
 
 namespace ns3 {
 
@@ -66,6 +68,13 @@ BasicEnergySource::GetTypeId (void)
                    MakeTimeAccessor (&BasicEnergySource::SetEnergyUpdateInterval,
                                      &BasicEnergySource::GetEnergyUpdateInterval),
                    MakeTimeChecker ())
+    .AddAttribute ("LazyEnergyUpdate",
+                   "Update the remaining energy only when it is queried, when the "
+                   "current drawn changes and when a battery threshold is crossed, "
+                   "rather than every PeriodicEnergyUpdateInterval.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&BasicEnergySource::m_lazyUpdate),
+                   MakeBooleanChecker ())
     .AddTraceSource ("RemainingEnergy",
                      "Remaining energy at BasicEnergySource.",
                      MakeTraceSourceAccessor (&BasicEnergySource::m_remainingEnergyJ),
@@ -79,6 +88,7 @@ BasicEnergySource::BasicEnergySource ()
   NS_LOG_FUNCTION (this);
   m_lastUpdateTime = Seconds (0.0);
   m_depleted = false;
+  m_lazyUpdate = false;
 }
 
 BasicEnergySource::~BasicEnergySource ()
@@ -178,11 +188,26 @@ BasicEnergySource::UpdateEnergySource (void)
       HandleEnergyRechargedEvent ();
     }
 
+  if (m_lazyUpdate)
+    {
+      ScheduleThresholdUpdate ();
+      return;
+    }
   m_energyUpdateEvent = Simulator::Schedule (m_energyUpdateInterval,
                                              &BasicEnergySource::UpdateEnergySource,
                                              this);
 }
 
+void
+BasicEnergySource::NotifyCurrentChanged (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_lazyUpdate && !Simulator::IsFinished ())
+    {
+      ScheduleThresholdUpdate ();
+    }
+}
+
 /*
  * Private functions start here.
  */
@@ -221,6 +246,36 @@ BasicEnergySource::HandleEnergyRechargedEvent (void)
   NotifyEnergyRecharged (); // notify DeviceEnergyModel objects
 }
 
+void
+BasicEnergySource::ScheduleThresholdUpdate (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_energyUpdateEvent.Cancel ();
+
+  double totalCurrentA = CalculateTotalCurrent ();
+  double energyToThresholdJ;
+  if (!m_depleted && totalCurrentA > 0)
+    {
+      energyToThresholdJ = m_remainingEnergyJ - m_lowBatteryTh * m_initialEnergyJ;
+    }
+  else if (m_depleted && totalCurrentA < 0)
+    {
+      energyToThresholdJ = m_highBatteryTh * m_initialEnergyJ - m_remainingEnergyJ;
+    }
+  else
+    {
+      return; // no threshold is crossed at this current
+    }
+  double seconds = energyToThresholdJ / (std::fabs (totalCurrentA) * m_supplyVoltageV);
+  // round up, so that the threshold is crossed when the update is done
+  Time delay = NanoSeconds (std::ceil (std::max (seconds, 0.0) * 1e9));
+  delay = Max (delay, NanoSeconds (1));
+  NS_LOG_DEBUG ("BasicEnergySource:Next threshold update in " << delay);
+  m_energyUpdateEvent = Simulator::Schedule (delay,
+                                             &BasicEnergySource::UpdateEnergySource,
+                                             this);
+}
+
 void
 BasicEnergySource::CalculateRemainingEnergy (void)
 {
@@ -74,6 +74,12 @@ public:
    */
   virtual void UpdateEnergySource (void);
 
+  /**
+   * Implements NotifyCurrentChanged: in lazy update mode, predicts again when
+   * a battery threshold is crossed.
+   */
+  virtual void NotifyCurrentChanged (void);
+
   /**
    * \param initialEnergyJ Initial energy, in Joules
    *
@@ -135,6 +141,15 @@ private:
    */
   void CalculateRemainingEnergy (void);
 
+  /**
+   * Lazy update mode: schedules the next update at the instant the remaining
+   * energy first crosses the low battery threshold (or the high one, when
+   * depleted and recharging) at the present total current, if it ever does.
+   * Since the device models update the energy source whenever their current
+   * changes, the remaining energy is otherwise only computed on demand.
+   */
+  void ScheduleThresholdUpdate (void);
+
 private:
   double m_initialEnergyJ;                // initial energy, in Joules
   double m_supplyVoltageV;                // supply voltage, in Volts
@@ -146,6 +161,7 @@ private:
   EventId m_energyUpdateEvent;            // energy update event
   Time m_lastUpdateTime;                  // last update time
   Time m_energyUpdateInterval;            // energy update interval
+  bool m_lazyUpdate;                      // update on threshold crossing instead of periodically
 
 };
 
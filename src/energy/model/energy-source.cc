@@ -189,6 +189,12 @@ EnergySource::CalculateTotalCurrent (void)
   return totalCurrentA;
 }
 
+void
+EnergySource::NotifyCurrentChanged (void)
+{
+  NS_LOG_FUNCTION (this);
+}
+
 void
 EnergySource::NotifyEnergyDrained (void)
 {
@@ -120,6 +120,15 @@ public:
    */
   virtual void UpdateEnergySource (void) = 0;
 
+  /**
+   * Called by DeviceEnergyModels right after their current draw changed,
+   * following the call to UpdateEnergySource made before the change. Energy
+   * sources which predict when their battery thresholds are crossed use it
+   * to redo the prediction with the new total current. Does nothing by
+   * default.
+   */
+  virtual void NotifyCurrentChanged (void);
+
   /**
    * \brief Sets pointer to node containing this EnergySource.
    *
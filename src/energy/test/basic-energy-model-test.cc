@@ -20,6 +20,7 @@
 
 #include "ns3/basic-energy-source.h"
 #include "ns3/wifi-radio-energy-model.h"
+#include "ns3/simple-device-energy-model.h"
 #include "ns3/basic-energy-source-helper.h"
 #include "ns3/wifi-radio-energy-model-helper.h"
 #include "ns3/energy-source-container.h"
@@ -29,6 +30,7 @@
 #include "ns3/node.h"
 #include "ns3/simulator.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/string.h"
 #include "ns3/yans-wifi-helper.h"
@@ -370,6 +372,104 @@ BasicEnergyDepletionTest::DepletionTestCase (double simTimeS,
 
 // -------------------------------------------------------------------------- //
 
+/**
+ * Test case of the lazy update mode of BasicEnergySource: the remaining energy
+ * is only updated when the current changes and when the low battery threshold
+ * is crossed.
+ */
+class BasicEnergyLazyUpdateTest : public TestCase
+{
+public:
+  BasicEnergyLazyUpdateTest ();
+  virtual ~BasicEnergyLazyUpdateTest ();
+
+private:
+  void DoRun (void);
+
+  /**
+   * \param oldValue Previous remaining energy, in Joules.
+   * \param newValue New remaining energy, in Joules.
+   *
+   * Records the updates of the remaining energy.
+   */
+  void RemainingEnergy (double oldValue, double newValue);
+
+  /**
+   * \param source Energy source to query.
+   *
+   * Records the remaining energy of the source.
+   */
+  void QueryRemainingEnergy (Ptr<BasicEnergySource> source);
+
+  uint32_t m_nUpdates;  // number of remaining energy updates
+  double m_queriedEnergyJ; // remaining energy when queried
+  Time m_lastUpdate;    // time of the last remaining energy update
+  double m_tolerance;   // tolerance for energy estimation
+};
+
+BasicEnergyLazyUpdateTest::BasicEnergyLazyUpdateTest ()
+  : TestCase ("Basic energy source lazy update test case"),
+    m_nUpdates (0),
+    m_queriedEnergyJ (0),
+    m_tolerance (1.0e-9)
+{
+}
+
+BasicEnergyLazyUpdateTest::~BasicEnergyLazyUpdateTest ()
+{
+}
+
+void
+BasicEnergyLazyUpdateTest::RemainingEnergy (double oldValue, double newValue)
+{
+  m_nUpdates++;
+  m_lastUpdate = Simulator::Now ();
+}
+
+void
+BasicEnergyLazyUpdateTest::QueryRemainingEnergy (Ptr<BasicEnergySource> source)
+{
+  m_queriedEnergyJ = source->GetRemainingEnergy ();
+}
+
+void
+BasicEnergyLazyUpdateTest::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  Ptr<BasicEnergySource> source = CreateObject<BasicEnergySource> ();
+  source->SetAttribute ("BasicEnergySourceInitialEnergyJ", DoubleValue (10.0));
+  source->SetAttribute ("BasicEnergySupplyVoltageV", DoubleValue (3.0));
+  source->SetAttribute ("PeriodicEnergyUpdateInterval", TimeValue (Seconds (1.0)));
+  source->SetAttribute ("LazyEnergyUpdate", BooleanValue (true));
+  node->AggregateObject (source);
+  source->TraceConnectWithoutContext ("RemainingEnergy",
+                                      MakeCallback (&BasicEnergyLazyUpdateTest::RemainingEnergy, this));
+
+  Ptr<SimpleDeviceEnergyModel> model = CreateObject<SimpleDeviceEnergyModel> ();
+  model->SetEnergySource (source);
+  source->AppendDeviceEnergyModel (model);
+
+  /*
+   * 0.3 W during 10 s, then 0.6 W: the remaining energy is 7 J at 10 s and
+   * crosses the low battery threshold (1 J) at 20 s. It is queried at 15 s.
+   */
+  Simulator::Schedule (Seconds (0.0), &SimpleDeviceEnergyModel::SetCurrentA, model, 0.1);
+  Simulator::Schedule (Seconds (10.0), &SimpleDeviceEnergyModel::SetCurrentA, model, 0.2);
+  Simulator::Schedule (Seconds (15.0), &BasicEnergyLazyUpdateTest::QueryRemainingEnergy, this, source);
+  Simulator::Stop (Seconds (25.0));
+  Simulator::Run ();
+
+  // updates at 10 s, 15 s and 20 s only
+  NS_TEST_ASSERT_MSG_EQ (m_nUpdates, 3, "Unexpected remaining energy updates");
+  NS_TEST_ASSERT_MSG_EQ_TOL (m_queriedEnergyJ, 4.0, m_tolerance, "Wrong remaining energy");
+  NS_TEST_ASSERT_MSG_EQ (m_lastUpdate, Seconds (20.0), "Low battery threshold crossed at the wrong time");
+  NS_TEST_ASSERT_MSG_EQ_TOL (source->GetRemainingEnergy (), 1.0, m_tolerance, "Wrong remaining energy");
+
+  Simulator::Destroy ();
+}
+
+// -------------------------------------------------------------------------- //
+
 /**
  * Unit test suite for energy model. Although the test suite involves 2 modules
  * it is still considered a unit test. Because a DeviceEnergyModel cannot live
@@ -386,6 +486,7 @@ BasicEnergyModelTestSuite::BasicEnergyModelTestSuite ()
 {
   AddTestCase (new BasicEnergyUpdateTest, TestCase::QUICK);
   AddTestCase (new BasicEnergyDepletionTest, TestCase::QUICK);
+  AddTestCase (new BasicEnergyLazyUpdateTest, TestCase::QUICK);
 }
 
 // create an instance of the test suite
@@ -0,0 +1,70 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "arp-neighbor-table-helper.h"
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/ipv4-interface.h"
+#include "ns3/net-device.h"
+#include "ns3/node.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ArpNeighborTableHelper");
+
+Ptr<ArpNeighborTable>
+ArpNeighborTableHelper::Install (NodeContainer c)
+{
+  Ptr<ArpNeighborTable> table = CreateObject<ArpNeighborTable> ();
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<Ipv4L3Protocol> ipv4 = (*i)->GetObject<Ipv4L3Protocol> ();
+      NS_ASSERT_MSG (ipv4 != 0, "node " << (*i)->GetId () << " has no IPv4 stack");
+      for (uint32_t j = 0; j < ipv4->GetNInterfaces (); j++)
+        {
+          Ptr<Ipv4Interface> interface = ipv4->GetInterface (j);
+          Address hardwareAddress = interface->GetDevice ()->GetAddress ();
+          for (uint32_t k = 0; k < interface->GetNAddresses (); k++)
+            {
+              Ipv4Address address = interface->GetAddress (k).GetLocal ();
+              if (address == Ipv4Address::GetLoopback ())
+                {
+                  continue;
+                }
+              table->Add (address, hardwareAddress);
+            }
+        }
+    }
+  for (NodeContainer::Iterator i = c.Begin (); i != c.End (); ++i)
+    {
+      Ptr<ArpL3Protocol> arp = (*i)->GetObject<ArpL3Protocol> ();
+      NS_ASSERT_MSG (arp != 0, "node " << (*i)->GetId () << " has no ARP");
+      arp->SetNeighborTable (table);
+    }
+  NS_LOG_INFO (table->GetNEntries () << " addresses shared by " << c.GetN () << " nodes");
+  return table;
+}
+
+Ptr<ArpNeighborTable>
+ArpNeighborTableHelper::InstallAll (void)
+{
+  return Install (NodeContainer::GetGlobal ());
+}
+
+} // namespace ns3
@@ -0,0 +1,59 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef ARP_NEIGHBOR_TABLE_HELPER_H
+#define ARP_NEIGHBOR_TABLE_HELPER_H
+
+#include "ns3/node-container.h"
+#include "ns3/arp-neighbor-table.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup arp
+ * \brief Helper to resolve the IPv4 addresses of a set of nodes without
+ * ARP exchanges.
+ *
+ * Intended for single-hop subnets such as a BSS, where every node can
+ * reach every other one: one ArpNeighborTable holding the addresses of
+ * all the nodes is shared by their ArpL3Protocol, in time and memory
+ * linear in the number of nodes.
+ */
+class ArpNeighborTableHelper
+{
+public:
+  /**
+   * \brief Fill a neighbor table with the addresses of the IPv4 interfaces
+   * (loopback excepted) of the nodes and share it with their ArpL3Protocol.
+   *
+   * The nodes must have an IPv4 stack and their addresses assigned.
+   *
+   * \param c the nodes
+   * \return the neighbor table
+   */
+  static Ptr<ArpNeighborTable> Install (NodeContainer c);
+  /**
+   * \brief Install a neighbor table on all the nodes of the simulation.
+   *
+   * \return the neighbor table
+   */
+  static Ptr<ArpNeighborTable> InstallAll (void);
+};
+
+} // namespace ns3
+
+#endif /* ARP_NEIGHBOR_TABLE_HELPER_H */
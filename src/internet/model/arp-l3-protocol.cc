@@ -30,6 +30,7 @@
 #include "arp-l3-protocol.h"
 #include "arp-header.h"
 #include "arp-cache.h"
+#include "arp-neighbor-table.h"
 #include "ipv4-interface.h"
 
 namespace ns3 {
@@ -61,6 +62,12 @@ ArpL3Protocol::GetTypeId (void)
                    StringValue ("ns3::UniformRandomVariable[Min=0.0|Max=10.0]"),
                    MakePointerAccessor (&ArpL3Protocol::m_requestJitter),
                    MakePointerChecker<RandomVariableStream> ())
+    .AddAttribute ("NeighborTable",
+                   "The neighbor table consulted when a destination "
+                   "is not in the ARP cache of the interface.",
+                   PointerValue (),
+                   MakePointerAccessor (&ArpL3Protocol::m_neighborTable),
+                   MakePointerChecker<ArpNeighborTable> ())
     .AddTraceSource ("Drop",
                      "Packet dropped because not enough room "
                      "in pending queue for a specific cache entry.",
@@ -88,6 +95,13 @@ ArpL3Protocol::AssignStreams (int64_t stream)
   return 1;
 }
 
+void
+ArpL3Protocol::SetNeighborTable (Ptr<ArpNeighborTable> table)
+{
+  NS_LOG_FUNCTION (this << table);
+  m_neighborTable = table;
+}
+
 void 
 ArpL3Protocol::SetNode (Ptr<Node> node)
 {
@@ -126,6 +140,7 @@ ArpL3Protocol::DoDispose (void)
       cache->Dispose ();
     }
   m_cacheList.clear ();
+  m_neighborTable = 0;
   m_node = 0;
   Object::DoDispose ();
 }
@@ -335,6 +350,12 @@ ArpL3Protocol::Lookup (Ptr<Packet> packet, const Ipv4Header & ipHeader, Ipv4Addr
             }
         }
     }
+  else if (m_neighborTable != 0 && m_neighborTable->Lookup (destination, hardwareDestination))
+    {
+      NS_LOG_LOGIC ("node="<<m_node->GetId ()<<
+                    ", neighbor table entry for " << destination << " -- send");
+      return true;
+    }
   else
     {
       // This is our first attempt to transmit data to this destination.
@@ -31,6 +31,7 @@
 namespace ns3 {
 
 class ArpCache;
+class ArpNeighborTable;
 class NetDevice;
 class Node;
 class Packet;
@@ -99,6 +100,13 @@ public:
                Ptr<ArpCache> cache,
                Address *hardwareDestination);
 
+  /**
+   * \brief Set the neighbor table consulted when a destination is not in
+   * the ARP cache of the interface
+   * \param table the neighbor table, possibly shared with other nodes
+   */
+  void SetNeighborTable (Ptr<ArpNeighborTable> table);
+
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model.  Return the number of streams (possibly zero) that
@@ -160,6 +168,7 @@ private:
   Ptr<Node> m_node; //!< node the ARP L3 protocol is associated with
   TracedCallback<Ptr<const Packet> > m_dropTrace; //!< trace for packets dropped by ARP
   Ptr<RandomVariableStream> m_requestJitter; //!< jitter to de-sync ARP requests
+  Ptr<ArpNeighborTable> m_neighborTable; //!< bindings resolved without ARP exchange
 
 };
 
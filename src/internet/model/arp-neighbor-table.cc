@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "arp-neighbor-table.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("ArpNeighborTable");
+
+NS_OBJECT_ENSURE_REGISTERED (ArpNeighborTable);
+
+TypeId
+ArpNeighborTable::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::ArpNeighborTable")
+    .SetParent<Object> ()
+    .SetGroupName ("Internet")
+    .AddConstructor<ArpNeighborTable> ()
+  ;
+  return tid;
+}
+
+ArpNeighborTable::ArpNeighborTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+ArpNeighborTable::~ArpNeighborTable ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+ArpNeighborTable::Add (Ipv4Address to, const Address &hardwareAddress)
+{
+  NS_LOG_FUNCTION (this << to << hardwareAddress);
+  m_table[to] = hardwareAddress;
+}
+
+bool
+ArpNeighborTable::Lookup (Ipv4Address to, Address *hardwareAddress) const
+{
+  NS_LOG_FUNCTION (this << to);
+  Table::const_iterator it = m_table.find (to);
+  if (it == m_table.end ())
+    {
+      return false;
+    }
+  *hardwareAddress = it->second;
+  return true;
+}
+
+uint32_t
+ArpNeighborTable::GetNEntries (void) const
+{
+  return m_table.size ();
+}
+
+} // namespace ns3
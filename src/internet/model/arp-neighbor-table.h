@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef ARP_NEIGHBOR_TABLE_H
+#define ARP_NEIGHBOR_TABLE_H
+
+#include "ns3/object.h"
+#include "ns3/address.h"
+#include "ns3/ipv4-address.h"
+#include "ns3/sgi-hashmap.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup arp
+ * \brief A read-only table of IPv4 to hardware address bindings, shared
+ * by the ArpL3Protocol of many nodes.
+ *
+ * ArpL3Protocol consults its neighbor table, if any, when a destination is
+ * missing from the ArpCache of the interface: the destination is then
+ * resolved without an ARP exchange and without adding an entry to the
+ * cache. Entries learnt by the ArpCache take precedence.
+ *
+ * A single table holding the addresses of all the nodes of a single-hop
+ * subnet (e.g., a BSS) replaces the per-node ARP cache prepopulation, which
+ * costs one entry per pair of nodes. See ArpNeighborTableHelper.
+ */
+class ArpNeighborTable : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  ArpNeighborTable ();
+  virtual ~ArpNeighborTable ();
+
+  /**
+   * \brief Add or replace the binding of an IPv4 address
+   * \param to the IPv4 address
+   * \param hardwareAddress the hardware address of the interface of \p to
+   */
+  void Add (Ipv4Address to, const Address &hardwareAddress);
+  /**
+   * \brief Find the hardware address bound to an IPv4 address
+   * \param to the IPv4 address
+   * \param hardwareAddress filled with the hardware address, if found
+   * \return true if \p to is in the table
+   */
+  bool Lookup (Ipv4Address to, Address *hardwareAddress) const;
+  /**
+   * \return the number of IPv4 addresses in the table
+   */
+  uint32_t GetNEntries (void) const;
+
+private:
+  typedef sgi::hash_map<Ipv4Address, Address, Ipv4AddressHash> Table; //!< IPv4 to hardware addresses
+
+  Table m_table; //!< bindings
+};
+
+} // namespace ns3
+
+#endif /* ARP_NEIGHBOR_TABLE_H */
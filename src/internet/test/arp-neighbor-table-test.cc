@@ -0,0 +1,186 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "ns3/test.h"
+#include "ns3/socket-factory.h"
+#include "ns3/udp-socket-factory.h"
+#include "ns3/simulator.h"
+#include "ns3/simple-channel.h"
+#include "ns3/simple-net-device.h"
+#include "ns3/socket.h"
+#include "ns3/node.h"
+#include "ns3/node-container.h"
+#include "ns3/inet-socket-address.h"
+
+#include "ns3/arp-l3-protocol.h"
+#include "ns3/arp-neighbor-table-helper.h"
+#include "ns3/ipv4-l3-protocol.h"
+#include "ns3/icmpv4-l4-protocol.h"
+#include "ns3/udp-l4-protocol.h"
+#include "ns3/ipv4-static-routing.h"
+#include "ns3/traffic-control-layer.h"
+
+#include <limits>
+
+using namespace ns3;
+
+static void
+AddInternetStack (Ptr<Node> node)
+{
+  //ARP
+  Ptr<ArpL3Protocol> arp = CreateObject<ArpL3Protocol> ();
+  node->AggregateObject (arp);
+  //IPV4
+  Ptr<Ipv4L3Protocol> ipv4 = CreateObject<Ipv4L3Protocol> ();
+  //Routing for Ipv4
+  Ptr<Ipv4StaticRouting> ipv4Routing = CreateObject<Ipv4StaticRouting> ();
+  ipv4->SetRoutingProtocol (ipv4Routing);
+  node->AggregateObject (ipv4);
+  node->AggregateObject (ipv4Routing);
+  //ICMP
+  Ptr<Icmpv4L4Protocol> icmp = CreateObject<Icmpv4L4Protocol> ();
+  node->AggregateObject (icmp);
+  //UDP
+  Ptr<UdpL4Protocol> udp = CreateObject<UdpL4Protocol> ();
+  node->AggregateObject (udp);
+  //Traffic Control
+  Ptr<TrafficControlLayer> tc = CreateObject<TrafficControlLayer> ();
+  node->AggregateObject (tc);
+}
+
+/**
+ * Check that the destinations found in a shared ArpNeighborTable are
+ * resolved without ARP exchange, and that the others still are resolved
+ * through ARP.
+ */
+class ArpNeighborTableTest : public TestCase
+{
+public:
+  ArpNeighborTableTest ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \param withTable whether to install a neighbor table
+   * \return the number of ARP packets received by the destination
+   */
+  uint32_t SendAndCountArp (bool withTable);
+  void ReceivePkt (Ptr<Socket> socket);
+  void ReceiveArp (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol,
+                   const Address &from, const Address &to, NetDevice::PacketType packetType);
+  void DoSendData (Ptr<Socket> socket, Ipv4Address to);
+
+  uint32_t m_receivedPackets;
+  uint32_t m_receivedArp;
+};
+
+ArpNeighborTableTest::ArpNeighborTableTest ()
+  : TestCase ("ARP neighbor table")
+{
+}
+
+void
+ArpNeighborTableTest::ReceivePkt (Ptr<Socket> socket)
+{
+  socket->Recv (std::numeric_limits<uint32_t>::max (), 0);
+  m_receivedPackets++;
+}
+
+void
+ArpNeighborTableTest::ReceiveArp (Ptr<NetDevice> device, Ptr<const Packet> p, uint16_t protocol,
+                                  const Address &from, const Address &to, NetDevice::PacketType packetType)
+{
+  m_receivedArp++;
+}
+
+void
+ArpNeighborTableTest::DoSendData (Ptr<Socket> socket, Ipv4Address to)
+{
+  NS_TEST_EXPECT_MSG_EQ (socket->SendTo (Create<Packet> (123), 0, InetSocketAddress (to, 1234)),
+                         123, "packet not sent");
+}
+
+uint32_t
+ArpNeighborTableTest::SendAndCountArp (bool withTable)
+{
+  m_receivedPackets = 0;
+  m_receivedArp = 0;
+
+  NodeContainer nodes;
+  nodes.Create (2);
+  Ptr<SimpleChannel> channel = CreateObject<SimpleChannel> ();
+  Ptr<SimpleNetDevice> rxDev;
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      AddInternetStack (nodes.Get (i));
+      Ptr<SimpleNetDevice> dev = CreateObject<SimpleNetDevice> ();
+      dev->SetAddress (Mac48Address::ConvertFrom (Mac48Address::Allocate ()));
+      dev->SetChannel (channel);
+      nodes.Get (i)->AddDevice (dev);
+      Ptr<Ipv4> ipv4 = nodes.Get (i)->GetObject<Ipv4> ();
+      uint32_t netdev_idx = ipv4->AddInterface (dev);
+      ipv4->AddAddress (netdev_idx, Ipv4InterfaceAddress (Ipv4Address (i == 0 ? "10.0.0.1" : "10.0.0.2"),
+                                                          Ipv4Mask (0xffff0000U)));
+      ipv4->SetUp (netdev_idx);
+      rxDev = dev;
+    }
+  Ptr<Node> rxNode = nodes.Get (1);
+  rxNode->RegisterProtocolHandler (MakeCallback (&ArpNeighborTableTest::ReceiveArp, this),
+                                   ArpL3Protocol::PROT_NUMBER, rxDev);
+
+  if (withTable)
+    {
+      Ptr<ArpNeighborTable> table = ArpNeighborTableHelper::Install (nodes);
+      NS_TEST_EXPECT_MSG_EQ (table->GetNEntries (), 2, "wrong number of neighbor table entries");
+      Address hardwareAddress;
+      NS_TEST_EXPECT_MSG_EQ (table->Lookup (Ipv4Address ("10.0.0.2"), &hardwareAddress), true, "address not in the table");
+      NS_TEST_EXPECT_MSG_EQ (hardwareAddress, rxDev->GetAddress (), "wrong hardware address");
+      NS_TEST_EXPECT_MSG_EQ (table->Lookup (Ipv4Address ("10.0.0.3"), &hardwareAddress), false, "unknown address in the table");
+    }
+
+  Ptr<Socket> rxSocket = rxNode->GetObject<UdpSocketFactory> ()->CreateSocket ();
+  NS_TEST_EXPECT_MSG_EQ (rxSocket->Bind (InetSocketAddress (Ipv4Address ("10.0.0.2"), 1234)), 0, "trivial");
+  rxSocket->SetRecvCallback (MakeCallback (&ArpNeighborTableTest::ReceivePkt, this));
+  Ptr<Socket> txSocket = nodes.Get (0)->GetObject<UdpSocketFactory> ()->CreateSocket ();
+
+  Simulator::ScheduleWithContext (nodes.Get (0)->GetId (), Seconds (0),
+                                  &ArpNeighborTableTest::DoSendData, this, txSocket, Ipv4Address ("10.0.0.2"));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_EXPECT_MSG_EQ (m_receivedPackets, 1, "packet not received");
+  return m_receivedArp;
+}
+
+void
+ArpNeighborTableTest::DoRun (void)
+{
+  NS_TEST_EXPECT_MSG_GT (SendAndCountArp (false), 0, "no ARP request without neighbor table");
+  NS_TEST_EXPECT_MSG_EQ (SendAndCountArp (true), 0, "ARP request despite the neighbor table");
+}
+
+/**
+ * ARP neighbor table test suite
+ */
+class ArpNeighborTableTestSuite : public TestSuite
+{
+public:
+  ArpNeighborTableTestSuite () : TestSuite ("arp-neighbor-table", UNIT)
+  {
+    AddTestCase (new ArpNeighborTableTest, TestCase::QUICK);
+  }
+} g_arpNeighborTableTestSuite;
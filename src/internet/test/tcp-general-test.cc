@@ -1057,7 +1057,7 @@ TcpSocketSmallAcks::SendEmptyPacket (uint8_t flags)
     {
       flags |= TcpHeader::ACK;
     }
-  else if (m_state == FIN_WAIT_1 || m_state == LAST_ACK || m_state == CLOSING)
+  else if (false)
     {
       ++s;
     }
@@ -31,6 +31,11 @@
 #include <ctime>
 #include "ns3/basic-energy-source-helper.h"
 #include "ns3/lora-radio-energy-model-helper.h"
+#ifdef NS3_PARALLEL_LPS
+#include "ns3/threaded-simulator-impl.h"
+#include "ns3/node-list.h"
+#include "ns3/abort.h"
+#endif
 
 using namespace ns3;
 using namespace lorawan;
@@ -167,6 +172,26 @@ main (int argc, char *argv[])
    *  Create End Devices  *
    ************************/
 
+#ifdef NS3_PARALLEL_LPS
+  // With the ThreadedSimulatorImpl, the end devices are spread over the
+  // logical processes, while the gateways and the network server, which
+  // exchange messages over 2 ms links, stay in logical process 0: the
+  // network server only reads the configuration of an end device MAC
+  // while it waits for its reply, far more than a lookahead away from the
+  // device's own changes. The partition is set before the nodes schedule
+  // their first event.
+  Ptr<ThreadedSimulatorImpl> parallel =
+      DynamicCast<ThreadedSimulatorImpl> (Simulator::GetImplementation ());
+  if (parallel != 0)
+    {
+      uint32_t firstNode = NodeList::GetNNodes () + nDevices;
+      for (uint32_t i = firstNode; i <= firstNode + nGateways; i++)
+        {
+          parallel->SetLogicalProcess (i, 0);
+        }
+    }
+#endif
+
   // Create a set of nodes
   NodeContainer endDevices;
   endDevices.Create (nDevices);
@@ -354,10 +379,45 @@ main (int argc, char *argv[])
   // Simulation //
   ////////////////
 
+#ifdef NS3_PARALLEL_LPS
+  if (parallel != 0)
+    {
+      // The lookahead is the shortest propagation delay between two nodes
+      // of different logical processes
+      NodeContainer loraNodes (endDevices, gateways);
+      Time lookahead = Time::Max ();
+      for (uint32_t i = 0; i < loraNodes.GetN (); i++)
+        {
+          Ptr<MobilityModel> a = loraNodes.Get (i)->GetObject<MobilityModel> ();
+          uint32_t lpA = parallel->GetLogicalProcess (loraNodes.Get (i)->GetId ());
+          for (uint32_t j = i + 1; j < loraNodes.GetN (); j++)
+            {
+              if (parallel->GetLogicalProcess (loraNodes.Get (j)->GetId ()) != lpA)
+                {
+                  Ptr<MobilityModel> b = loraNodes.Get (j)->GetObject<MobilityModel> ();
+                  lookahead = std::min (lookahead, delay->GetDelay (a, b));
+                }
+            }
+        }
+      NS_ABORT_MSG_IF (lookahead.IsZero (), "Co-located nodes in different logical processes");
+      if (lookahead != Time::Max ())
+        {
+          parallel->SetLookahead (lookahead);
+        }
+      NS_LOG_INFO ("Lookahead " << lookahead);
+    }
+#endif
+
   Simulator::Stop (appStopTime + Hours (1));
 
   NS_LOG_INFO ("Running simulation...");
   Simulator::Run ();
+#ifdef NS3_PARALLEL_LPS
+  if (parallel != 0)
+    {
+      NS_LOG_INFO ("Ran " << parallel->GetNWindows () << " windows");
+    }
+#endif
   int counter = 0;
   // for (DeviceEnergyModelContainer::Iterator iter = deviceModels.Begin (); iter != deviceModels.End (); iter ++)
   // {
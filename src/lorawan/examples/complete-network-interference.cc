@@ -11,6 +11,7 @@
 #include "ns3/gateway-lorawan-mac.h"
 #include "ns3/simulator.h"
 #include "ns3/log.h"
+#include "ns3/event-trace.h"
 #include "ns3/pointer.h"
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/lora-helper.h"
@@ -68,6 +69,7 @@ std::string positionFile = ""; // file to read the positions of the interferers
 std::string transmitInputFile = ""; // file to read transmission information
 int interfererDevices = 50;
 int interfererPacketSize = 64;
+std::string eventTraceFile = ""; // binary event trace replacing the LoraPacketTracker logs
 
 // structure for device position
 struct Device {
@@ -96,6 +98,9 @@ main (int argc, char *argv[])
   cmd.AddValue ("interfererDevices", "interfererDevices", interfererDevices);
   cmd.AddValue ("interfererPacketSize", "interfererPacketSize", interfererPacketSize);
   cmd.AddValue ("seed", "seed", seed);
+  cmd.AddValue ("eventTraceFile",
+                "Binary event trace to write instead of the LoraPacketTracker logs "
+                "(decode it with utils/decode-event-trace)", eventTraceFile);
   cmd.Parse (argc, argv);
 
   // Set up logging
@@ -104,7 +109,14 @@ main (int argc, char *argv[])
   // LogComponentEnable ("CorrelatedShadowingPropagationLossModel", LOG_LEVEL_ALL);
   // LogComponentEnable ("BuildingPenetrationLoss", LOG_LEVEL_ALL);
 
-  LogComponentEnable ("LoraPacketTracker", LOG_LEVEL_ALL);
+  if (eventTraceFile != "")
+    {
+      EventTrace::Open (eventTraceFile);
+    }
+  else
+    {
+      LogComponentEnable ("LoraPacketTracker", LOG_LEVEL_ALL);
+    }
   // LogComponentEnable("EndDeviceStatus", LOG_LEVEL_ALL);
 
   // LogComponentEnable("LoraChannel", LOG_LEVEL_INFO);
@@ -533,6 +545,7 @@ main (int argc, char *argv[])
 
   NS_LOG_INFO ("Running simulation...");
   Simulator::Run ();
+  EventTrace::Close ();
   int counter = 0;
   // for (DeviceEnergyModelContainer::Iterator iter = deviceModels.Begin (); iter != deviceModels.End (); iter ++)
   // {
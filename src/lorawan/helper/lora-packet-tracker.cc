@@ -22,6 +22,7 @@
 #include "ns3/log.h"
 #include "ns3/simulator.h"
 #include "ns3/abort.h"
+#include "ns3/event-trace.h"
 #include "ns3/lorawan-mac-header.h"
 #include <iostream>
 #include <fstream>
@@ -30,6 +31,16 @@ namespace ns3 {
 namespace lorawan {
 NS_LOG_COMPONENT_DEFINE ("LoraPacketTracker");
 
+/// Event trace types, see EventTrace
+static const uint16_t g_macTxEvent =
+  EventTrace::Register ("LoraPacketTracker", "MacTx", "uid:u size:u");
+static const uint16_t g_macGwRxEvent =
+  EventTrace::Register ("LoraPacketTracker", "MacGwRx", "uid:u");
+static const uint16_t g_phyTxEvent =
+  EventTrace::Register ("LoraPacketTracker", "PhyTx", "uid:u size:u");
+static const uint16_t g_phyOutcomeEvent =
+  EventTrace::Register ("LoraPacketTracker", "PhyOutcome", "uid:u outcome:u");
+
 LoraPacketTracker::LoraPacketTracker ()
 {
   NS_LOG_FUNCTION (this);
@@ -50,6 +61,7 @@ LoraPacketTracker::MacTransmissionCallback (Ptr<Packet const> packet)
   if (IsUplink (packet))
     {
       // NS_LOG_INFO ("A new packet was sent by the MAC layer");
+      NS_EVENT_TRACE (g_macTxEvent, Simulator::GetContext (), packet->GetUid (), packet->GetSize ());
 
       MacPacketStatus status;
       status.packet = packet;
@@ -57,8 +69,9 @@ LoraPacketTracker::MacTransmissionCallback (Ptr<Packet const> packet)
       status.senderId = Simulator::GetContext ();
       status.receivedTime = Time::Max ();
 
-      m_macPacketTracker.insert (std::pair<Ptr<Packet const>, MacPacketStatus>
-                                   (packet, status));
+      std::lock_guard<std::mutex> lock (m_mutex);
+      m_macPacketTracker.insert (std::pair<uint64_t, MacPacketStatus>
+                                   (packet->GetUid (), status));
     }
 }
 
@@ -78,6 +91,7 @@ LoraPacketTracker::RequiredTransmissionsCallback (uint8_t reqTx, bool success,
   entry.reTxAttempts = reqTx;
   entry.successful = success;
 
+  std::lock_guard<std::mutex> lock (m_mutex);
   m_reTransmissionTracker.insert (std::pair<Ptr<Packet>, RetransmissionStatus>
                                     (packet, entry));
 }
@@ -90,9 +104,11 @@ LoraPacketTracker::MacGwReceptionCallback (Ptr<Packet const> packet)
       // NS_LOG_INFO ("A packet was successfully received" <<
       //              " at the MAC layer of gateway " <<
       //              Simulator::GetContext ());
+      NS_EVENT_TRACE (g_macGwRxEvent, Simulator::GetContext (), packet->GetUid ());
 
       // Find the received packet in the m_macPacketTracker
-      auto it = m_macPacketTracker.find (packet);
+      std::lock_guard<std::mutex> lock (m_mutex);
+      auto it = m_macPacketTracker.find (packet->GetUid ());
       if (it != m_macPacketTracker.end ())
         {
           (*it).second.receptionTimes.insert (std::pair<int, Time>
@@ -120,13 +136,15 @@ LoraPacketTracker::TransmissionCallback (Ptr<Packet const> packet, uint32_t edId
                                  << packet->GetSize()
                                  << " was transmitted by device "
                                  << edId);
+      NS_EVENT_TRACE (g_phyTxEvent, edId, packet->GetUid (), packet->GetSize ());
       // Create a packetStatus
       PacketStatus status;
       status.packet = packet;
       status.sendTime = Simulator::Now ();
       status.senderId = edId;
       // if(it != m_packetTracker.end())
-      m_packetTracker.insert (std::pair<Ptr<Packet const>, PacketStatus> (packet, status));
+      std::lock_guard<std::mutex> lock (m_mutex);
+      m_packetTracker.insert (std::pair<uint64_t, PacketStatus> (packet->GetUid (), status));
     }
 }
 
@@ -140,7 +158,9 @@ LoraPacketTracker::PacketReceptionCallback (Ptr<Packet const> packet, uint32_t g
       //                            << " was successfully received at gateway "
       //                            << gwId);
 
-      std::map<Ptr<Packet const>, PacketStatus>::iterator it = m_packetTracker.find (packet);
+      NS_EVENT_TRACE (g_phyOutcomeEvent, gwId, packet->GetUid (), RECEIVED);
+      std::lock_guard<std::mutex> lock (m_mutex);
+      PhyPacketData::iterator it = m_packetTracker.find (packet->GetUid ());
       if(it != m_packetTracker.end())
         (*it).second.outcomes.insert (std::pair<int, enum PhyPacketOutcome> (gwId,
                                                                             RECEIVED));
@@ -156,7 +176,9 @@ LoraPacketTracker::InterferenceCallback (Ptr<Packet const> packet, uint32_t gwId
       //                            << " was interfered at gateway "
       //                            << gwId);
 
-      std::map<Ptr<Packet const>, PacketStatus>::iterator it = m_packetTracker.find (packet);
+      NS_EVENT_TRACE (g_phyOutcomeEvent, gwId, packet->GetUid (), INTERFERED);
+      std::lock_guard<std::mutex> lock (m_mutex);
+      PhyPacketData::iterator it = m_packetTracker.find (packet->GetUid ());
       if(it != m_packetTracker.end())
         (*it).second.outcomes.insert (std::pair<int, enum PhyPacketOutcome> (gwId,
                                                                             INTERFERED));
@@ -171,7 +193,9 @@ LoraPacketTracker::NoMoreReceiversCallback (Ptr<Packet const> packet, uint32_t g
       // NS_LOG_INFO (Simulator::Now().GetSeconds() << " PHY packet " << packet
       //                            << " was lost because no more receivers at gateway "
                                 //  << gwId);
-      std::map<Ptr<Packet const>, PacketStatus>::iterator it = m_packetTracker.find (packet);
+      NS_EVENT_TRACE (g_phyOutcomeEvent, gwId, packet->GetUid (), NO_MORE_RECEIVERS);
+      std::lock_guard<std::mutex> lock (m_mutex);
+      PhyPacketData::iterator it = m_packetTracker.find (packet->GetUid ());
       if(it != m_packetTracker.end())
         (*it).second.outcomes.insert (std::pair<int, enum PhyPacketOutcome> (gwId,
                                                                             NO_MORE_RECEIVERS));
@@ -187,9 +211,12 @@ LoraPacketTracker::UnderSensitivityCallback (Ptr<Packet const> packet, uint32_t
       //                            << " was lost because under sensitivity at gateway "
       //                            << gwId);
 
-      std::map<Ptr<Packet const>, PacketStatus>::iterator it = m_packetTracker.find (packet);
-      (*it).second.outcomes.insert (std::pair<int, enum PhyPacketOutcome> (gwId,
-                                                                           UNDER_SENSITIVITY));
+      NS_EVENT_TRACE (g_phyOutcomeEvent, gwId, packet->GetUid (), UNDER_SENSITIVITY);
+      std::lock_guard<std::mutex> lock (m_mutex);
+      PhyPacketData::iterator it = m_packetTracker.find (packet->GetUid ());
+      if(it != m_packetTracker.end())
+        (*it).second.outcomes.insert (std::pair<int, enum PhyPacketOutcome> (gwId,
+                                                                            UNDER_SENSITIVITY));
     }
 }
 
@@ -202,9 +229,12 @@ LoraPacketTracker::LostBecauseTxCallback (Ptr<Packet const> packet, uint32_t gwI
       //                            << " was lost because of GW transmission at gateway "
       //                            << gwId);
 
-      std::map<Ptr<Packet const>, PacketStatus>::iterator it = m_packetTracker.find (packet);
-      (*it).second.outcomes.insert (std::pair<int, enum PhyPacketOutcome> (gwId,
-                                                                           LOST_BECAUSE_TX));
+      NS_EVENT_TRACE (g_phyOutcomeEvent, gwId, packet->GetUid (), LOST_BECAUSE_TX);
+      std::lock_guard<std::mutex> lock (m_mutex);
+      PhyPacketData::iterator it = m_packetTracker.find (packet->GetUid ());
+      if(it != m_packetTracker.end())
+        (*it).second.outcomes.insert (std::pair<int, enum PhyPacketOutcome> (gwId,
+                                                                            LOST_BECAUSE_TX));
     }
 }
 
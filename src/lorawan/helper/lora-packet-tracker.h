@@ -25,6 +25,7 @@
 #include "ns3/nstime.h"
 
 #include <map>
+#include <mutex>
 #include <string>
 
 namespace ns3 {
@@ -65,8 +66,9 @@ struct RetransmissionStatus
   bool successful;
 };
 
-typedef std::map<Ptr<Packet const>, MacPacketStatus> MacPacketData;
-typedef std::map<Ptr<Packet const>, PacketStatus> PhyPacketData;
+// By packet uid, which the copies of a packet received by the gateways share
+typedef std::map<uint64_t, MacPacketStatus> MacPacketData;
+typedef std::map<uint64_t, PacketStatus> PhyPacketData;
 typedef std::map<Ptr<Packet const>, RetransmissionStatus> RetransmissionData;
 
 
@@ -163,6 +165,9 @@ private:
   PhyPacketData m_packetTracker;
   MacPacketData m_macPacketTracker;
   RetransmissionData m_reTransmissionTracker;
+  // The callbacks are called by the concurrent logical processes of a
+  // parallel simulation
+  std::mutex m_mutex;
 };
 }
 }
@@ -198,16 +198,18 @@ CorrelatedShadowingPropagationLossModel::ShadowingMap::GetLoss
       // TODO: Avoid useless generation of ShadowingMap values. This can be
       // done by performing some checks (and not leveraging the map
       // implementation)
-      double q11 = m_shadowingValue->GetValue ();
+      double q[4];
+      m_shadowingValue->GetValues (q, 4);
+      double q11 = q[0];
       NS_LOG_DEBUG ("Lower left corner: " << q11);
       m_shadowingMap[lowerLeft] = q11;
-      double q12 = m_shadowingValue->GetValue ();
+      double q12 = q[1];
       NS_LOG_DEBUG ("Upper left corner: " << q12);
       m_shadowingMap[upperLeft] = q12;
-      double q21 = m_shadowingValue->GetValue ();
+      double q21 = q[2];
       NS_LOG_DEBUG ("Lower right corner: " << q21);
       m_shadowingMap[lowerRight] = q21;
-      double q22 = m_shadowingValue->GetValue ();
+      double q22 = q[3];
       NS_LOG_DEBUG ("Upper right corner: " << q22);
       m_shadowingMap[upperRight] = q22;
 
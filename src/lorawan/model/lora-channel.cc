@@ -61,6 +61,7 @@ LoraChannel::GetTypeId (void)
 }
 
 LoraChannel::LoraChannel ()
+  : m_receiversReady (false)
 {
 }
 
@@ -72,7 +73,8 @@ LoraChannel::~LoraChannel ()
 LoraChannel::LoraChannel (Ptr<PropagationLossModel> loss,
                           Ptr<PropagationDelayModel> delay) :
   m_loss (loss),
-  m_delay (delay)
+  m_delay (delay),
+  m_receiversReady (false)
 {
 }
 
@@ -83,6 +85,7 @@ LoraChannel::Add (Ptr<LoraPhy> phy)
 
   // Add the new phy to the vector
   m_phyList.push_back (phy);
+  m_receiversReady = false;
 }
 
 void
@@ -92,6 +95,7 @@ LoraChannel::AddI (Ptr<LoraPhy> phy)
 
   // Add the new phy to the vector
   m_phyListI.push_back (phy);
+  m_receiversReady = false;
 }
 
 void
@@ -101,6 +105,7 @@ LoraChannel::Remove (Ptr<LoraPhy> phy)
 
   // Remove the phy from the vector
   m_phyList.erase (find (m_phyList.begin (), m_phyList.end (), phy));
+  m_receiversReady = false;
 }
 
 uint32_t
@@ -127,8 +132,10 @@ LoraChannel::Send (Ptr< LoraPhy > sender, Ptr< Packet > packet,
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << txParams <<
                    duration << frequencyMHz);
 
+  UpdateReceivers ();
+
   // Get the mobility model of the sender
-  Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> senderMobility = sender->GetMobility ();
 
   NS_ASSERT (senderMobility != 0);     // Make sure it's available
 
@@ -145,8 +152,7 @@ LoraChannel::Send (Ptr< LoraPhy > sender, Ptr< Packet > packet,
       if (sender != (*i))
         {
           // Get the receiver's mobility model
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->
-            GetObject<MobilityModel> ();
+          Ptr<MobilityModel> receiverMobility = m_receivers[j].mobility;
 
           NS_LOG_INFO ("Receiver mobility: " <<
                       receiverMobility->GetPosition ());
@@ -164,18 +170,8 @@ LoraChannel::Send (Ptr< LoraPhy > sender, Ptr< Packet > packet,
                         "m, delay=" << delay);
 
           // Get the id of the destination PHY to correctly format the context
-          Ptr<NetDevice> dstNetDevice = m_phyList[j]->GetDevice ();
-          uint32_t dstNode = 0;
-          if (dstNetDevice != 0)
-            {
-              NS_LOG_INFO ("Getting node index from NetDevice, since it exists");
-              dstNode = dstNetDevice->GetNode ()->GetId ();
-              NS_LOG_DEBUG ("dstNode = " << dstNode);
-            }
-          else
-            {
-              NS_LOG_INFO ("No net device connected to the PHY, using context 0");
-            }
+          uint32_t dstNode = m_receivers[j].node;
+          NS_LOG_DEBUG ("dstNode = " << dstNode);
 
           // Create the parameters object based on the calculations above
           LoraChannelParameters parameters;
@@ -186,11 +182,18 @@ LoraChannel::Send (Ptr< LoraPhy > sender, Ptr< Packet > packet,
 
           // Schedule the receive event
           NS_LOG_INFO ("Scheduling reception of the packet");
+#ifdef NS3_PARALLEL_LPS
+          // the receiver may run in another thread, which must not share
+          // the buffers of the packet
+          Simulator::ScheduleWithContext (dstNode, delay, &LoraChannel::Receive,
+                                          this, j, packet->CreateFullCopy (), parameters);
+#else
           Simulator::ScheduleWithContext (dstNode, delay, &LoraChannel::Receive,
                                           this, j, packet, parameters);
+#endif
 
           // Fire the trace source for sent packet
-          m_packetSent (packet);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_CHANNEL, m_packetSent, packet);
         }
   }
 }
@@ -207,8 +210,10 @@ LoraChannel::SendI (Ptr< LoraPhy > sender, Ptr< Packet > packet,
   NS_LOG_FUNCTION (this << sender << packet << txPowerDbm << txParams <<
                    duration << frequencyMHz);
 
+  UpdateReceivers ();
+
   // Get the mobility model of the sender
-  Ptr<MobilityModel> senderMobility = sender->GetMobility ()->GetObject<MobilityModel> ();
+  Ptr<MobilityModel> senderMobility = sender->GetMobility ();
 
   NS_ASSERT (senderMobility != 0);     // Make sure it's available
 
@@ -225,8 +230,7 @@ LoraChannel::SendI (Ptr< LoraPhy > sender, Ptr< Packet > packet,
       if (sender != (*i))
         {
           // Get the receiver's mobility model
-          Ptr<MobilityModel> receiverMobility = (*i)->GetMobility ()->
-            GetObject<MobilityModel> ();
+          Ptr<MobilityModel> receiverMobility = m_receiversI[j].mobility;
 
           NS_LOG_INFO ("Receiver mobility: " <<
                       receiverMobility->GetPosition ());
@@ -244,18 +248,8 @@ LoraChannel::SendI (Ptr< LoraPhy > sender, Ptr< Packet > packet,
                         "m, delay=" << delay);
 
           // Get the id of the destination PHY to correctly format the context
-          Ptr<NetDevice> dstNetDevice = m_phyListI[j]->GetDevice ();
-          uint32_t dstNode = 0;
-          if (dstNetDevice != 0)
-            {
-              NS_LOG_INFO ("Getting node index from NetDevice, since it exists");
-              dstNode = dstNetDevice->GetNode ()->GetId ();
-              NS_LOG_DEBUG ("dstNode = " << dstNode);
-            }
-          else
-            {
-              NS_LOG_INFO ("No net device connected to the PHY, using context 0");
-            }
+          uint32_t dstNode = m_receiversI[j].node;
+          NS_LOG_DEBUG ("dstNode = " << dstNode);
 
           // Create the parameters object based on the calculations above
           LoraChannelParameters parameters;
@@ -266,11 +260,18 @@ LoraChannel::SendI (Ptr< LoraPhy > sender, Ptr< Packet > packet,
 
           // Schedule the receive event
           NS_LOG_INFO ("Scheduling reception of the packet");
+#ifdef NS3_PARALLEL_LPS
+          // the receiver may run in another thread, which must not share
+          // the buffers of the packet
+          Simulator::ScheduleWithContext (dstNode, delay, &LoraChannel::ReceiveI,
+                                          this, j, packet->CreateFullCopy (), parameters);
+#else
           Simulator::ScheduleWithContext (dstNode, delay, &LoraChannel::ReceiveI,
                                           this, j, packet, parameters);
+#endif
 
           // Fire the trace source for sent packet
-          m_packetSent (packet);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_CHANNEL, m_packetSent, packet);
         }
   }
 }
@@ -302,6 +303,46 @@ LoraChannel::ReceiveI (uint32_t i, Ptr<Packet> packet,
   
 }
 
+void
+LoraChannel::UpdateReceivers (void) const
+{
+  if (m_receiversReady.load (std::memory_order_acquire))
+    {
+      return;
+    }
+  std::lock_guard<std::mutex> lock (m_receiversMutex);
+  if (m_receiversReady.load (std::memory_order_relaxed))
+    {
+      return;
+    }
+  NS_LOG_FUNCTION (this);
+
+  const std::vector<Ptr<LoraPhy> > *lists[] = { &m_phyList, &m_phyListI };
+  std::vector<Receiver> *receivers[] = { &m_receivers, &m_receiversI };
+  for (uint32_t l = 0; l < 2; l++)
+    {
+      receivers[l]->clear ();
+      std::vector<Ptr<LoraPhy> >::const_iterator i;
+      for (i = lists[l]->begin (); i != lists[l]->end (); i++)
+        {
+          Receiver receiver;
+          receiver.mobility = (*i)->GetMobility ();
+          receiver.node = 0;
+          Ptr<NetDevice> device = (*i)->GetDevice ();
+          if (device != 0)
+            {
+              receiver.node = device->GetNode ()->GetId ();
+            }
+          else
+            {
+              NS_LOG_INFO ("No net device connected to the PHY, using context 0");
+            }
+          receivers[l]->push_back (receiver);
+        }
+    }
+  m_receiversReady.store (true, std::memory_order_release);
+}
+
 double
 LoraChannel::GetRxPower (double txPowerDbm, Ptr<MobilityModel> senderMobility,
                          Ptr<MobilityModel> receiverMobility) const
@@ -24,6 +24,8 @@
 #ifndef LORA_CHANNEL_H
 #define LORA_CHANNEL_H
 
+#include <atomic>
+#include <mutex>
 #include <vector>
 #include "ns3/lora-phy.h"
 #include "ns3/mobility-model.h"
@@ -34,6 +36,17 @@
 #include "ns3/logical-lora-channel.h"
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
+#include "ns3/traced-callback.h"
+
+/**
+ * Trace group of the traces of LoraChannel, see NS_TRACE: compiled
+ * out with --disable-trace-groups=lora-channel.
+ */
+#ifdef NS3_DISABLE_TRACE_GROUP_LORA_CHANNEL
+#define NS3_TRACE_GROUP_LORA_CHANNEL false
+#else
+#define NS3_TRACE_GROUP_LORA_CHANNEL true
+#endif
 
 namespace ns3 {
 class NetDevice;
@@ -172,6 +185,24 @@ private:
   void ReceiveI (uint32_t i, Ptr<Packet> packet,
                 LoraChannelParameters parameters) const;
 
+  /**
+    * The mobility model and the node of a connected PHY.
+    */
+  struct Receiver
+  {
+    Ptr<MobilityModel> mobility;     //!< The mobility model of the PHY.
+    uint32_t node;     //!< The node of the PHY, or 0 without a device.
+  };
+
+  /**
+    * Look up the mobility models and the nodes of the connected PHYs, once
+    * after they changed.
+    *
+    * The lookups bind the PHYs lazily, so they must not be done by the
+    * concurrent logical processes of a parallel simulation.
+    */
+  void UpdateReceivers (void) const;
+
   /**
     * The vector containing the PHYs that are currently connected to the
     * channel.
@@ -179,6 +210,14 @@ private:
   std::vector<Ptr<LoraPhy> > m_phyList;
   std::vector<Ptr<LoraPhy> > m_phyListI;
 
+  /**
+    * The receivers of m_phyList and m_phyListI, by index.
+    */
+  mutable std::vector<Receiver> m_receivers;
+  mutable std::vector<Receiver> m_receiversI;
+  mutable std::atomic<bool> m_receiversReady;     //!< Whether the receivers are up to date.
+  mutable std::mutex m_receiversMutex;     //!< Protects the update of the receivers.
+
   /**
     * Pointer to the loss model.
     *
@@ -27,6 +27,8 @@ namespace lorawan {
 
 NS_LOG_COMPONENT_DEFINE ("LoraFrameHeader");
 
+NS_OBJECT_ENSURE_REGISTERED (LoraFrameHeader);
+
 // Initialization list
 LoraFrameHeader::LoraFrameHeader () :
   m_fPort     (0),
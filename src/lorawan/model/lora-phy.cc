@@ -93,6 +93,7 @@ LoraPhy::SetDevice (Ptr<NetDevice> device)
   NS_LOG_FUNCTION (this << device);
 
   m_device = device;
+  m_nodeMobility = ObjectHandle<MobilityModel> ();
 }
 
 Ptr<LoraChannel>
@@ -116,7 +117,11 @@ LoraPhy::GetMobility (void)
     }
   else     // Else, take it from the node
     {
-      return m_device->GetNode ()->GetObject<MobilityModel> ();
+      if (!m_nodeMobility.IsBound ())
+        {
+          m_nodeMobility = ObjectHandle<MobilityModel> (m_device->GetNode ());
+        }
+      return m_nodeMobility.Get ();
     }
 }
 
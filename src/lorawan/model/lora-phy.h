@@ -22,7 +22,9 @@
 #define LORA_PHY_H
 
 #include "ns3/object.h"
+#include "ns3/object-handle.h"
 #include "ns3/callback.h"
+#include "ns3/traced-callback.h"
 #include "ns3/net-device.h"
 #include "ns3/nstime.h"
 #include "ns3/mobility-model.h"
@@ -32,6 +34,16 @@
 #include "ns3/lora-interference-helper.h"
 #include <list>
 
+/**
+ * Trace group of the traces of the LoraPhy classes, see NS_TRACE: compiled
+ * out with --disable-trace-groups=lora-phy.
+ */
+#ifdef NS3_DISABLE_TRACE_GROUP_LORA_PHY
+#define NS3_TRACE_GROUP_LORA_PHY false
+#else
+#define NS3_TRACE_GROUP_LORA_PHY true
+#endif
+
 namespace ns3 {
 namespace lorawan {
 
@@ -262,6 +274,7 @@ public:
 
 private:
   Ptr<MobilityModel> m_mobility;   //!< The mobility model associated to this PHY.
+  ObjectHandle<MobilityModel> m_nodeMobility; //!< The mobility model of the node, if there is none.
 
 protected:
   // Member objects
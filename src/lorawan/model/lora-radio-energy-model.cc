@@ -261,6 +261,7 @@ LoraRadioEnergyModel::ChangeState (int newState)
     {
       // update current state & last update time stamp
       SetLoraRadioState ((EndDeviceLoraPhy::State) newState);
+      m_source->NotifyCurrentChanged ();
 
       // some debug message
       NS_LOG_DEBUG ("LoraRadioEnergyModel:Total energy consumption is " <<
@@ -27,6 +27,8 @@ namespace lorawan {
 
 NS_LOG_COMPONENT_DEFINE ("LorawanMacHeader");
 
+NS_OBJECT_ENSURE_REGISTERED (LorawanMacHeader);
+
 LorawanMacHeader::LorawanMacHeader () : m_major (0)
 {
 }
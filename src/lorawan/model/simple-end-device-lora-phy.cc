@@ -102,11 +102,11 @@ SimpleEndDeviceLoraPhy::Send (Ptr<Packet> packet, LoraTxParameters txParams,
   // Call the trace source
   if (m_device)
     {
-      m_startSending (packet, m_device->GetNode ()->GetId ());
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_startSending, packet, m_device->GetNode ()->GetId ());
     }
   else
     {
-      m_startSending (packet, 0);
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_startSending, packet, 0);
     }
 }
 
@@ -153,11 +153,11 @@ SimpleEndDeviceLoraPhy::SendI (Ptr<Packet> packet, LoraTxParameters txParams,
   // Call the trace source
   if (m_device)
     {
-      m_startSending (packet, m_device->GetNode ()->GetId ());
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_startSending, packet, m_device->GetNode ()->GetId ());
     }
   else
     {
-      m_startSending (packet, 0);
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_startSending, packet, 0);
     }
 }
 
@@ -237,11 +237,11 @@ SimpleEndDeviceLoraPhy::StartReceive (Ptr<Packet> packet, double rxPowerDbm,
             // Fire the trace source for this event.
             if (m_device)
               {
-                m_wrongFrequency (packet, m_device->GetNode ()->GetId ());
+                NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_wrongFrequency, packet, m_device->GetNode ()->GetId ());
               }
             else
               {
-                m_wrongFrequency (packet, 0);
+                NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_wrongFrequency, packet, 0);
               }
 
             canLockOnPacket = false;
@@ -257,11 +257,11 @@ SimpleEndDeviceLoraPhy::StartReceive (Ptr<Packet> packet, double rxPowerDbm,
             // Fire the trace source for this event.
             if (m_device)
               {
-                m_wrongSf (packet, m_device->GetNode ()->GetId ());
+                NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_wrongSf, packet, m_device->GetNode ()->GetId ());
               }
             else
               {
-                m_wrongSf (packet, 0);
+                NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_wrongSf, packet, 0);
               }
 
             canLockOnPacket = false;
@@ -278,11 +278,11 @@ SimpleEndDeviceLoraPhy::StartReceive (Ptr<Packet> packet, double rxPowerDbm,
             // Fire the trace source for this event.
             if (m_device)
               {
-                m_underSensitivity (packet, m_device->GetNode ()->GetId ());
+                NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_underSensitivity, packet, m_device->GetNode ()->GetId ());
               }
             else
               {
-                m_underSensitivity (packet, 0);
+                NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_underSensitivity, packet, 0);
               }
 
             canLockOnPacket = false;
@@ -309,7 +309,7 @@ SimpleEndDeviceLoraPhy::StartReceive (Ptr<Packet> packet, double rxPowerDbm,
             // Simulator::Schedule (duration, &LoraPhy::EndReceive, this, packet,
             //                      event4);
             // Fire the beginning of reception trace source
-            m_phyRxBeginTrace (packet);
+            NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_phyRxBeginTrace, packet);
           }
       }
     }
@@ -347,7 +347,7 @@ SimpleEndDeviceLoraPhy::EndReceive (Ptr<Packet> packet,
   SwitchToStandby ();
 
   // Fire the trace source
-  m_phyRxEndTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_phyRxEndTrace, packet);
 
   // Call the LoraInterferenceHelper to determine whether there was destructive
   // interference on this event.
@@ -360,11 +360,11 @@ SimpleEndDeviceLoraPhy::EndReceive (Ptr<Packet> packet,
 
       if (m_device)
         {
-          m_interferedPacket (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_interferedPacket, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_interferedPacket (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_interferedPacket, packet, 0);
         }
 
       // If there is one, perform the callback to inform the upper layer of the
@@ -381,11 +381,11 @@ SimpleEndDeviceLoraPhy::EndReceive (Ptr<Packet> packet,
 
       if (m_device)
         {
-          m_successfullyReceivedPacket (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_successfullyReceivedPacket, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_successfullyReceivedPacket (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_successfullyReceivedPacket, packet, 0);
         }
 
       // If there is one, perform the callback to inform the upper layer
@@ -407,7 +407,7 @@ SimpleEndDeviceLoraPhy::EndReceiveI (Ptr<Packet> packet,
   SwitchToStandby ();
 
   // Fire the trace source
-  m_phyRxEndTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_phyRxEndTrace, packet);
 
   // Call the LoraInterferenceHelper to determine whether there was destructive
   // interference on this event.
@@ -420,11 +420,11 @@ SimpleEndDeviceLoraPhy::EndReceiveI (Ptr<Packet> packet,
 
       if (m_device)
         {
-          m_interferedPacket (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_interferedPacket, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_interferedPacket (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_interferedPacket, packet, 0);
         }
 
       // If there is one, perform the callback to inform the upper layer of the
@@ -441,11 +441,11 @@ SimpleEndDeviceLoraPhy::EndReceiveI (Ptr<Packet> packet,
 
       if (m_device)
         {
-          m_successfullyReceivedPacket (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_successfullyReceivedPacket, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_successfullyReceivedPacket (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_successfullyReceivedPacket, packet, 0);
         }
 
       // If there is one, perform the callback to inform the upper layer
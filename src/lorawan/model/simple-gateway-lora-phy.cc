@@ -80,12 +80,12 @@ SimpleGatewayLoraPhy::Send (Ptr<Packet> packet, LoraTxParameters txParams, doubl
           // Fire the trace source
           if (m_device)
             {
-              m_noReceptionBecauseTransmitting (currentPath->GetEvent ()->GetPacket (),
-                                                m_device->GetNode ()->GetId ());
+              NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_noReceptionBecauseTransmitting,
+                        currentPath->GetEvent ()->GetPacket (), m_device->GetNode ()->GetId ());
             }
           else
             {
-              m_noReceptionBecauseTransmitting (currentPath->GetEvent ()->GetPacket (), 0);
+              NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_noReceptionBecauseTransmitting, currentPath->GetEvent ()->GetPacket (), 0);
             }
 
           // Cancel the scheduled EndReceive call
@@ -106,11 +106,11 @@ SimpleGatewayLoraPhy::Send (Ptr<Packet> packet, LoraTxParameters txParams, doubl
   // Fire the trace source
   if (m_device)
     {
-      m_startSending (packet, m_device->GetNode ()->GetId ());
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_startSending, packet, m_device->GetNode ()->GetId ());
     }
   else
     {
-      m_startSending (packet, 0);
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_startSending, packet, 0);
     }
 }
 
@@ -136,7 +136,7 @@ SimpleGatewayLoraPhy::StartReceive (Ptr<Packet> packet, double rxPowerDbm, uint8
   NS_LOG_FUNCTION (this << packet << rxPowerDbm << duration << frequencyMHz);
 
   // Fire the trace source
-  m_phyRxBeginTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_phyRxBeginTrace, packet);
 
   if(packet->GetIsInterferer()){
     Ptr<LoraInterferenceHelper::Event> event;
@@ -151,16 +151,16 @@ SimpleGatewayLoraPhy::StartReceive (Ptr<Packet> packet, double rxPowerDbm, uint8
       NS_LOG_INFO ("Dropping packet reception of packet with sf = "
                    << unsigned (sf) << " because we are in TX mode");
 
-      m_phyRxEndTrace (packet);
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_phyRxEndTrace, packet);
 
       // Fire the trace source
       if (m_device)
         {
-          m_noReceptionBecauseTransmitting (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_noReceptionBecauseTransmitting, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_noReceptionBecauseTransmitting (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_noReceptionBecauseTransmitting, packet, 0);
         }
 
       return;
@@ -194,11 +194,11 @@ SimpleGatewayLoraPhy::StartReceive (Ptr<Packet> packet, double rxPowerDbm, uint8
 
               if (m_device)
                 {
-                  m_underSensitivity (packet, m_device->GetNode ()->GetId ());
+                  NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_underSensitivity, packet, m_device->GetNode ()->GetId ());
                 }
               else
                 {
-                  m_underSensitivity (packet, 0);
+                  NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_underSensitivity, packet, 0);
                 }
 
               // Since the packet is below sensitivity, it makes no sense to
@@ -233,11 +233,11 @@ SimpleGatewayLoraPhy::StartReceive (Ptr<Packet> packet, double rxPowerDbm, uint8
   // Fire the trace source
   if (m_device)
     {
-      m_noMoreDemodulators (packet, m_device->GetNode ()->GetId ());
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_noMoreDemodulators, packet, m_device->GetNode ()->GetId ());
     }
   else
     {
-      m_noMoreDemodulators (packet, 0);
+      NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_noMoreDemodulators, packet, 0);
     }
 }
 
@@ -257,7 +257,7 @@ SimpleGatewayLoraPhy::EndReceive (Ptr<Packet> packet, Ptr<LoraInterferenceHelper
   NS_LOG_FUNCTION (this << packet << *event);
 
   // Call the trace source
-  m_phyRxEndTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_phyRxEndTrace, packet);
 
   // Call the LoraInterferenceHelper to determine whether there was
   // destructive interference. If the packet is correctly received, this
@@ -280,11 +280,11 @@ SimpleGatewayLoraPhy::EndReceive (Ptr<Packet> packet, Ptr<LoraInterferenceHelper
       // Fire the trace source
       if (m_device)
         {
-          m_interferedPacket (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_interferedPacket, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_interferedPacket (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_interferedPacket, packet, 0);
         }
     }
   else // Reception was correct
@@ -295,11 +295,11 @@ SimpleGatewayLoraPhy::EndReceive (Ptr<Packet> packet, Ptr<LoraInterferenceHelper
       // Fire the trace source
       if (m_device)
         {
-          m_successfullyReceivedPacket (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_successfullyReceivedPacket, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_successfullyReceivedPacket (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_successfullyReceivedPacket, packet, 0);
         }
 
       // Forward the packet to the upper layer
@@ -344,7 +344,7 @@ SimpleGatewayLoraPhy::EndReceiveI (Ptr<Packet> packet, Ptr<LoraInterferenceHelpe
   NS_LOG_FUNCTION (this << packet << *event);
 
   // Call the trace source
-  m_phyRxEndTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_phyRxEndTrace, packet);
 
   // Call the LoraInterferenceHelper to determine whether there was
   // destructive interference. If the packet is correctly received, this
@@ -367,11 +367,11 @@ SimpleGatewayLoraPhy::EndReceiveI (Ptr<Packet> packet, Ptr<LoraInterferenceHelpe
       // Fire the trace source
       if (m_device)
         {
-          m_interferedPacket (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_interferedPacket, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_interferedPacket (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_interferedPacket, packet, 0);
         }
     }
   else // Reception was correct
@@ -382,11 +382,11 @@ SimpleGatewayLoraPhy::EndReceiveI (Ptr<Packet> packet, Ptr<LoraInterferenceHelpe
       // Fire the trace source
       if (m_device)
         {
-          m_successfullyReceivedPacket (packet, m_device->GetNode ()->GetId ());
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_successfullyReceivedPacket, packet, m_device->GetNode ()->GetId ());
         }
       else
         {
-          m_successfullyReceivedPacket (packet, 0);
+          NS_TRACE (NS3_TRACE_GROUP_LORA_PHY, m_successfullyReceivedPacket, packet, 0);
         }
 
       // Forward the packet to the upper layer
@@ -475,8 +475,10 @@ UniformDiscPositionAllocator::GetNext (void) const
   double x,y;
   do
     {
-      x = m_rv->GetValue (-m_rho, m_rho);
-      y = m_rv->GetValue (-m_rho, m_rho);
+      double xy[2];
+      m_rv->GetValues (xy, 2, -m_rho, m_rho);
+      x = xy[0];
+      y = xy[1];
     }
   while (std::sqrt (x*x + y*y) > m_rho);
 
@@ -50,7 +50,11 @@ namespace ns3 {
 NS_LOG_COMPONENT_DEFINE ("Buffer");
 
 
+#ifdef NS3_PARALLEL_LPS
+thread_local uint32_t Buffer::g_recommendedStart = 0;
+#else
 uint32_t Buffer::g_recommendedStart = 0;
+#endif
 #ifdef BUFFER_FREE_LIST
 /* The following macros are pretty evil but they are needed to allow us to
  * keep track of 3 possible states for the g_freeList variable:
@@ -75,8 +79,16 @@ uint32_t Buffer::g_recommendedStart = 0;
 #define IS_INITIALIZED(x) (!IS_UNINITIALIZED (x) && !IS_DESTROYED (x))
 #define DESTROYED ((Buffer::FreeList*)MAGIC_DESTROYED)
 #define UNINITIALIZED ((Buffer::FreeList*)0)
+/* Data of at most SMALL_SIZE bytes is allocated with exactly SMALL_SIZE
+ * bytes and recycled through its own free list: the small packets, which
+ * are most of them, then neither go to the system allocator nor get
+ * discarded because a larger packet raised g_maxSize. The spare room
+ * also lets headers be added in place.
+ */
+#define SMALL_SIZE 256
 uint32_t Buffer::g_maxSize = 0;
 Buffer::FreeList *Buffer::g_freeList = 0;
+Buffer::FreeList *Buffer::g_smallFreeList = 0;
 struct Buffer::LocalStaticDestructor Buffer::g_localStaticDestructor;
 
 Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
@@ -91,6 +103,13 @@ Buffer::LocalStaticDestructor::~LocalStaticDestructor(void)
         }
       delete g_freeList;
       g_freeList = DESTROYED;
+      for (Buffer::FreeList::iterator i = g_smallFreeList->begin ();
+           i != g_smallFreeList->end (); i++)
+        {
+          Buffer::Deallocate (*i);
+        }
+      delete g_smallFreeList;
+      g_smallFreeList = DESTROYED;
     }
 }
 
@@ -100,6 +119,19 @@ Buffer::Recycle (struct Buffer::Data *data)
   NS_LOG_FUNCTION (data);
   NS_ASSERT (data->m_count == 0);
   NS_ASSERT (!IS_UNINITIALIZED (g_freeList));
+  if (data->m_size == SMALL_SIZE)
+    {
+      if (IS_DESTROYED (g_smallFreeList) ||
+          g_smallFreeList->size () > 1000)
+        {
+          Buffer::Deallocate (data);
+        }
+      else
+        {
+          g_smallFreeList->push_back (data);
+        }
+      return;
+    }
   g_maxSize = std::max (g_maxSize, data->m_size);
   /* feed into free list */
   if (data->m_size < g_maxSize ||
@@ -123,8 +155,20 @@ Buffer::Create (uint32_t dataSize)
   if (IS_UNINITIALIZED (g_freeList))
     {
       g_freeList = new Buffer::FreeList ();
+      g_smallFreeList = new Buffer::FreeList ();
     }
-  else if (IS_INITIALIZED (g_freeList))
+  if (dataSize <= SMALL_SIZE)
+    {
+      if (IS_INITIALIZED (g_smallFreeList) && !g_smallFreeList->empty ())
+        {
+          struct Buffer::Data *data = g_smallFreeList->back ();
+          g_smallFreeList->pop_back ();
+          data->m_count = 1;
+          return data;
+        }
+      return Buffer::Allocate (SMALL_SIZE);
+    }
+  if (IS_INITIALIZED (g_freeList))
     {
       while (!g_freeList->empty ()) 
         {
@@ -25,7 +25,10 @@
 #include <ostream>
 #include "ns3/assert.h"
 
+#ifndef NS3_PARALLEL_LPS
+// the free lists are shared by all the threads
 #define BUFFER_FREE_LIST 1
+#endif
 
 namespace ns3 {
 
@@ -763,7 +766,11 @@ private:
    * writing data. i.e., m_start should be initialized to this 
    * value.
    */
+#ifdef NS3_PARALLEL_LPS
+  static thread_local uint32_t g_recommendedStart;
+#else
   static uint32_t g_recommendedStart;
+#endif
 
   /**
    * offset to the start of the virtual zero area from the start
@@ -796,6 +803,7 @@ private:
   };
   static uint32_t g_maxSize; //!< Max observed data size
   static FreeList *g_freeList; //!< Buffer data container
+  static FreeList *g_smallFreeList; //!< Buffer data of SMALL_SIZE bytes
   static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
 #endif
 };
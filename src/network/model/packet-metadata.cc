@@ -33,7 +33,11 @@ NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
+#ifdef NS3_PARALLEL_LPS
+std::atomic<bool> PacketMetadata::m_metadataSkipped (false);
+#else
 bool PacketMetadata::m_metadataSkipped = false;
+#endif
 uint32_t PacketMetadata::m_maxSize = 0;
 uint16_t PacketMetadata::m_chunkUid = 0;
 PacketMetadata::DataFreeList PacketMetadata::m_freeList;
@@ -95,6 +99,14 @@ PacketMetadata::ReserveCopy (uint32_t size)
       Append16 (0xffff, start);
     }
 }
+PacketMetadata
+PacketMetadata::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  PacketMetadata copy = *this;
+  copy.ReserveCopy (0);
+  return copy;
+}
 void
 PacketMetadata::Reserve (uint32_t size)
 {
@@ -572,6 +584,11 @@ PacketMetadata::Create (uint32_t size)
 {
   NS_LOG_FUNCTION (size);
   NS_LOG_LOGIC ("create size="<<size<<", max="<<m_maxSize);
+  if (!m_enable)
+    {
+      // nothing is recycled, and the threads share no state
+      return PacketMetadata::Allocate (size);
+    }
   if (size > m_maxSize)
     {
       m_maxSize = size;
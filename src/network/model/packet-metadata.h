@@ -23,6 +23,9 @@
 #include <stdint.h>
 #include <vector>
 #include <limits>
+#ifdef NS3_PARALLEL_LPS
+#include <atomic>
+#endif
 #include "ns3/callback.h"
 #include "ns3/assert.h"
 #include "ns3/type-id.h"
@@ -179,6 +182,12 @@ private:
   inline PacketMetadata &operator = (PacketMetadata const& o);
   inline ~PacketMetadata ();
 
+  /**
+   * \brief Create a copy which shares no data with this one
+   * \return the copy
+   */
+  PacketMetadata CreateFullCopy (void) const;
+
   /**
    * \brief Add an header
    * \param header header to add
@@ -665,7 +674,11 @@ public:
    * m_enable is false; used to detect enabling of metadata in the
    * middle of a simulation, which isn't allowed.
    */
+#ifdef NS3_PARALLEL_LPS
+  static std::atomic<bool> m_metadataSkipped;
+#else
   static bool m_metadataSkipped;
+#endif
 
   static uint32_t m_maxSize; //!< maximum metadata size
   static uint16_t m_chunkUid; //!< Chunk Uid
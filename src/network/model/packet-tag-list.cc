@@ -27,13 +27,27 @@
 #include "tag-buffer.h"
 #include "tag.h"
 #include "ns3/fatal-error.h"
+#include "ns3/assert.h"
 #include "ns3/log.h"
+#include "ns3/memory-pool.h"
 #include <cstring>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+void *
+PacketTagList::TagData::operator new (std::size_t size)
+{
+  return MemoryPool::Allocate (size);
+}
+
+void
+PacketTagList::TagData::operator delete (void *p, std::size_t size)
+{
+  MemoryPool::Deallocate (p, size);
+}
+
 bool
 PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 {
@@ -278,6 +292,25 @@ PacketTagList::Peek (Tag &tag) const
   return false;
 }
 
+PacketTagList
+PacketTagList::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  PacketTagList copy;
+  struct TagData **prevNext = &copy.m_next;
+  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+    {
+      struct TagData *data = new struct TagData ();
+      data->count = 1;
+      data->next = 0;
+      data->tid = cur->tid;
+      std::memcpy (data->data, cur->data, TagData::MAX_SIZE);
+      *prevNext = data;
+      prevNext = &data->next;
+    }
+  return copy;
+}
+
 const struct PacketTagList::TagData *
 PacketTagList::Head (void) const
 {
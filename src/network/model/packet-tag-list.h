@@ -26,6 +26,7 @@
 */
 
 #include <stdint.h>
+#include <cstddef>
 #include <ostream>
 #include "ns3/type-id.h"
 
@@ -165,6 +166,21 @@ public:
     struct TagData * next;   /**< Pointer to next in list */
     TypeId tid;               /**< Type of the tag serialized into #data */
     uint32_t count;           /**< Number of incoming links */
+
+    /**
+     * Allocate a node from the MemoryPool.
+     *
+     * \param [in] size The size of a node.
+     * \returns The memory of the node.
+     */
+    static void * operator new (std::size_t size);
+    /**
+     * Give a node back to the MemoryPool.
+     *
+     * \param [in] p The memory of the node.
+     * \param [in] size The size of a node.
+     */
+    static void operator delete (void *p, std::size_t size);
   };  /* struct TagData */
 
   /**
@@ -233,6 +249,12 @@ public:
    * Remove all tags from this list (up to the first merge).
    */
   inline void RemoveAll (void);
+  /**
+   * Copy the tags to a list which shares none of them.
+   *
+   * \returns the copy
+   */
+  PacketTagList CreateFullCopy (void) const;
   /**
    * \returns pointer to head of tag list
    */
@@ -21,6 +21,7 @@
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/memory-pool.h"
 #include <string>
 #include <cstdarg>
 
@@ -28,7 +29,7 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+std::atomic<uint32_t> Packet::m_globalUid (0);
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -127,6 +128,44 @@ Packet::Copy (void) const
   return Ptr<Packet> (new Packet (*this), false);
 }
 
+Ptr<Packet>
+Packet::CreateFullCopy (void) const
+{
+  NS_LOG_FUNCTION (this);
+  Buffer buffer;
+  buffer.AddAtStart (m_buffer.GetSize ());
+  buffer.Begin ().Write (m_buffer.Begin (), m_buffer.End ());
+  ByteTagList byteTagList;
+  byteTagList.Add (m_byteTagList);
+  Ptr<Packet> copy = Ptr<Packet> (new Packet (buffer, byteTagList,
+                                              m_packetTagList.CreateFullCopy (),
+                                              m_metadata.CreateFullCopy ()), false);
+  copy->m_isInterferer = m_isInterferer;
+  if (m_nixVector != 0)
+    {
+      copy->m_nixVector = m_nixVector->Copy ();
+    }
+  return copy;
+}
+
+uint32_t
+Packet::NextUid (void)
+{
+  return m_globalUid.fetch_add (1, std::memory_order_relaxed);
+}
+
+void *
+Packet::operator new (std::size_t size)
+{
+  return MemoryPool::Allocate (size);
+}
+
+void
+Packet::operator delete (void *p, std::size_t size)
+{
+  MemoryPool::Deallocate (p, size);
+}
+
 Packet::Packet ()
   : m_buffer (),
     m_byteTagList (),
@@ -137,17 +176,17 @@ Packet::Packet ()
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, 0),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | NextUid (), 0),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 
 Packet::Packet (const Packet &o)
   : m_buffer (o.m_buffer),
     m_byteTagList (o.m_byteTagList),
     m_packetTagList (o.m_packetTagList),
-    m_metadata (o.m_metadata)
+    m_metadata (o.m_metadata),
+    m_isInterferer (o.m_isInterferer)
 {
   o.m_nixVector ? m_nixVector = o.m_nixVector->Copy ()
     : m_nixVector = 0;
@@ -164,6 +203,7 @@ Packet::operator = (const Packet &o)
   m_byteTagList = o.m_byteTagList;
   m_packetTagList = o.m_packetTagList;
   m_metadata = o.m_metadata;
+  m_isInterferer = o.m_isInterferer;
   o.m_nixVector ? m_nixVector = o.m_nixVector->Copy () 
     : m_nixVector = 0;
   return *this;
@@ -179,11 +219,10 @@ Packet::Packet (uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | NextUid (), size),
     m_nixVector (0),
     m_isInterferer(0)
 {
-  m_globalUid++;
 }
 
 Packet::Packet (uint32_t size, uint8_t isInterferer)
@@ -196,11 +235,10 @@ Packet::Packet (uint32_t size, uint8_t isInterferer)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | NextUid (), size),
     m_nixVector (0),
     m_isInterferer(isInterferer)
 {
-  m_globalUid++;
 }
 
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
@@ -224,10 +262,9 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | NextUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
   i.Write (buffer, size);
@@ -21,6 +21,8 @@
 #define PACKET_H
 
 #include <stdint.h>
+#include <cstddef>
+#include <atomic>
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
@@ -425,6 +427,19 @@ public:
    */
   Ptr<Packet> Copy (void) const;
 
+  /**
+   * \brief performs a deep copy of the packet.
+   *
+   * \returns a copy of the packet which shares none of its datasets
+   * with the original packet.
+   *
+   * Unlike the copies made by Copy, which update the reference counts of
+   * the shared datasets, the returned packet can be handed to another
+   * thread, e.g. to a node of another logical process of the
+   * ThreadedSimulatorImpl. It keeps the uid of the packet.
+   */
+  Ptr<Packet> CreateFullCopy (void) const;
+
   /**
    * \brief Returns the packet's Uid.
    *
@@ -503,6 +518,23 @@ public:
    */
   static void EnableChecking (void);
 
+  /**
+   * \brief Allocate the memory of a packet from the MemoryPool, so that
+   * creating a packet does not call the system allocator once the
+   * simulation has reached its peak number of packets.
+   *
+   * \param [in] size The size of a packet.
+   * \returns The memory of the packet.
+   */
+  static void * operator new (std::size_t size);
+  /**
+   * \brief Give the memory of a packet back to the MemoryPool.
+   *
+   * \param [in] p The memory of the packet.
+   * \param [in] size The size of a packet.
+   */
+  static void operator delete (void *p, std::size_t size);
+
   /**
    * \brief Returns number of bytes required for packet
    * serialization.
@@ -714,6 +746,11 @@ private:
 
   uint32_t Deserialize (uint8_t const*buffer, uint32_t size);
 
+  /**
+   * \return a new packet uid, whatever the thread
+   */
+  static uint32_t NextUid (void);
+
   Buffer m_buffer;                //!< the packet buffer (it's actual contents)
   ByteTagList m_byteTagList;      //!< the ByteTag list
   PacketTagList m_packetTagList;  //!< the packet's Tag list
@@ -722,7 +759,7 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
 };
 
 /**
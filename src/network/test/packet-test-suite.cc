@@ -24,6 +24,7 @@
 #include <limits>     // std:numeric_limits
 #include <string>
 #include <cstdarg>
+#include <cstring>
 #include <iostream>
 #include <iomanip>
 #include <ctime>
@@ -847,6 +848,136 @@ PacketTagListTest::DoRun (void)
     
 }
 
+//-----------------------------------------------------------------------------
+class PacketRecyclingTest : public TestCase
+{
+public:
+  PacketRecyclingTest ();
+private:
+  void DoRun (void);
+};
+
+PacketRecyclingTest::PacketRecyclingTest ()
+  : TestCase ("Packets, small buffers and packet tags are recycled")
+{
+}
+
+void
+PacketRecyclingTest::DoRun (void)
+{
+  // the memory of a freed packet is the next one given out
+  Ptr<Packet> p = Create<Packet> (10);
+  Packet *freed = PeekPointer (p);
+  p = 0;
+  p = Create<Packet> (20);
+  NS_TEST_EXPECT_MSG_EQ (PeekPointer (p), freed, "packet memory not recycled");
+
+  // a recycled packet and its recycled buffer and tags start empty
+  uint8_t data[100];
+  for (uint32_t i = 0; i < sizeof (data); i++)
+    {
+      data[i] = i;
+    }
+  p = Create<Packet> (data, sizeof (data));
+  p->AddHeader (ATestHeader<10> ());
+  p->AddPacketTag (ATestTag<1> (1));
+  Ptr<Packet> copy = p->Copy ();
+  copy->AddHeader (ATestHeader<2> ());
+  p = 0;
+  copy = 0;
+
+  p = Create<Packet> (sizeof (data));
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), sizeof (data), "wrong size");
+  ATestTag<1> tag;
+  NS_TEST_EXPECT_MSG_EQ (p->PeekPacketTag (tag), false, "tag of a freed packet");
+  uint8_t out[sizeof (data)];
+  p->CopyData (out, sizeof (out));
+  bool zeroes = true;
+  for (uint32_t i = 0; i < sizeof (out); i++)
+    {
+      zeroes = zeroes && out[i] == 0;
+    }
+  NS_TEST_EXPECT_MSG_EQ (zeroes, true, "data of a freed packet");
+
+  // small packets whose headers outgrow the small buffers
+  p = Create<Packet> (data, sizeof (data));
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      p->AddHeader (ATestHeader<10> ());
+      p->AddPacketTag (ATestTag<2> (i));
+      copy = p->Copy ();
+      ATestTag<2> other;
+      NS_TEST_EXPECT_MSG_EQ (copy->RemovePacketTag (other), true, "tag not copied");
+      NS_TEST_EXPECT_MSG_EQ (other.GetData (), (int) i, "wrong tag copied");
+      NS_TEST_EXPECT_MSG_EQ (p->RemovePacketTag (other), true, "tag removed from the original");
+    }
+  for (uint32_t i = 0; i < 20; i++)
+    {
+      ATestHeader<10> header;
+      p->RemoveHeader (header);
+      NS_TEST_EXPECT_MSG_EQ (header.m_error, false, "wrong header");
+    }
+  p->CopyData (out, sizeof (out));
+  NS_TEST_EXPECT_MSG_EQ (memcmp (out, data, sizeof (data)), 0, "wrong payload");
+}
+
+//-----------------------------------------------------------------------------
+class PacketFullCopyTest : public TestCase
+{
+public:
+  PacketFullCopyTest ();
+private:
+  void DoRun (void);
+};
+
+PacketFullCopyTest::PacketFullCopyTest ()
+  : TestCase ("Full copies of packets")
+{
+}
+
+void
+PacketFullCopyTest::DoRun (void)
+{
+  uint8_t data[100];
+  for (uint32_t i = 0; i < sizeof (data); i++)
+    {
+      data[i] = i;
+    }
+  Ptr<Packet> payload = Create<Packet> (data, sizeof (data));
+  // with a zero-filled area in the middle
+  Ptr<Packet> p = Create<Packet> (50);
+  p->AddAtEnd (payload);
+  p->AddHeader (ATestHeader<10> ());
+  p->AddPacketTag (ATestTag<1> (1));
+  p->AddByteTag (ATestTag<2> (2));
+
+  Ptr<Packet> copy = p->CreateFullCopy ();
+  NS_TEST_EXPECT_MSG_EQ (copy->GetUid (), p->GetUid (), "uid not kept");
+  NS_TEST_EXPECT_MSG_EQ (copy->GetSize (), p->GetSize (), "wrong size");
+  uint8_t expected[160];
+  uint8_t out[160];
+  p->CopyData (expected, sizeof (expected));
+  copy->CopyData (out, sizeof (out));
+  NS_TEST_EXPECT_MSG_EQ (memcmp (out, expected, sizeof (out)), 0, "wrong data");
+
+  ATestTag<1> tag;
+  NS_TEST_EXPECT_MSG_EQ (copy->RemovePacketTag (tag), true, "packet tag not copied");
+  NS_TEST_EXPECT_MSG_EQ (tag.GetData (), 1, "wrong packet tag copied");
+  NS_TEST_EXPECT_MSG_EQ (p->PeekPacketTag (tag), true, "packet tag removed from the original");
+  ATestTag<2> byteTag;
+  NS_TEST_EXPECT_MSG_EQ (copy->FindFirstMatchingByteTag (byteTag), true, "byte tag not copied");
+  NS_TEST_EXPECT_MSG_EQ (byteTag.GetData (), 2, "wrong byte tag copied");
+
+  ATestHeader<10> header;
+  copy->RemoveHeader (header);
+  NS_TEST_EXPECT_MSG_EQ (header.m_error, false, "wrong header");
+  NS_TEST_EXPECT_MSG_EQ (p->GetSize (), 160, "header removed from the original");
+
+  Ptr<Packet> interferer = Create<Packet> (10, 1);
+  NS_TEST_EXPECT_MSG_EQ (interferer->Copy ()->GetIsInterferer (), 1, "interferer flag lost");
+  NS_TEST_EXPECT_MSG_EQ (interferer->CreateFullCopy ()->GetIsInterferer (), 1, "interferer flag lost");
+}
+
 //-----------------------------------------------------------------------------
 class PacketTestSuite : public TestSuite
 {
@@ -859,6 +990,8 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new PacketRecyclingTest, TestCase::QUICK);
+  AddTestCase (new PacketFullCopyTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite;
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#include "aid-bitmap.h"
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+const uint16_t AidBitmap::MAX_AID;
+
+AidBitmap::AidBitmap ()
+{
+}
+
+uint16_t
+AidBitmap::GetAid (Mac48Address address)
+{
+  uint8_t mac[6];
+  address.CopyTo (mac);
+  return ((mac[4] & 0x1f) << 8) | mac[5];
+}
+
+void
+AidBitmap::Set (uint16_t aid)
+{
+  NS_ASSERT (aid <= MAX_AID);
+  uint32_t word = aid / 64;
+  if (word >= m_words.size ())
+    {
+      m_words.resize (word + 1, 0);
+    }
+  m_words[word] |= (uint64_t) 1 << (aid % 64);
+}
+
+void
+AidBitmap::Reset (uint16_t aid)
+{
+  uint32_t word = aid / 64;
+  if (word < m_words.size ())
+    {
+      m_words[word] &= ~((uint64_t) 1 << (aid % 64));
+    }
+}
+
+void
+AidBitmap::ResetAll (void)
+{
+  m_words.assign (m_words.size (), 0);
+}
+
+void
+AidBitmap::SetAll (const AidBitmap &other)
+{
+  if (other.m_words.size () > m_words.size ())
+    {
+      m_words.resize (other.m_words.size (), 0);
+    }
+  for (uint32_t i = 0; i < other.m_words.size (); i++)
+    {
+      m_words[i] |= other.m_words[i];
+    }
+}
+
+bool
+AidBitmap::IsSet (uint16_t aid) const
+{
+  uint32_t word = aid / 64;
+  return word < m_words.size () && (m_words[word] >> (aid % 64)) & 1;
+}
+
+bool
+AidBitmap::IsEmpty (void) const
+{
+  for (uint32_t i = 0; i < m_words.size (); i++)
+    {
+      if (m_words[i] != 0)
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+uint32_t
+AidBitmap::GetCount (void) const
+{
+  uint32_t count = 0;
+  for (uint32_t i = 0; i < m_words.size (); i++)
+    {
+      count += __builtin_popcountll (m_words[i]);
+    }
+  return count;
+}
+
+} //namespace ns3
@@ -0,0 +1,94 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+
+#ifndef AID_BITMAP_H
+#define AID_BITMAP_H
+
+#include <stdint.h>
+#include <vector>
+#include "ns3/simple-ref-count.h"
+#include "ns3/mac48-address.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * A set of stations of a BSS, stored as a bitmap indexed by AID.
+ *
+ * The AP keeps the associated, sleeping and RAW slot stations of its BSS
+ * in such bitmaps: membership tests and updates are bit operations instead
+ * of lookups by MAC address. The bitmaps are reference counted so that
+ * the AP shares them with its EDCA queues instead of copying them.
+ */
+class AidBitmap : public SimpleRefCount<AidBitmap>
+{
+public:
+  /// Highest AID of a S1G BSS
+  static const uint16_t MAX_AID = 8191;
+
+  AidBitmap ();
+
+  /**
+   * \param address the MAC address of a station
+   *
+   * \return the AID the AP assigns to the station
+   *
+   * The AP derives the AID from the 13 least significant bits of the MAC
+   * address of the station.
+   */
+  static uint16_t GetAid (Mac48Address address);
+
+  /**
+   * \param aid the AID to add to the set
+   */
+  void Set (uint16_t aid);
+  /**
+   * \param aid the AID to remove from the set
+   */
+  void Reset (uint16_t aid);
+  /**
+   * Remove all the AIDs from the set.
+   */
+  void ResetAll (void);
+  /**
+   * \param other the AIDs to add to the set
+   */
+  void SetAll (const AidBitmap &other);
+  /**
+   * \param aid the AID
+   *
+   * \return true if the AID is in the set
+   */
+  bool IsSet (uint16_t aid) const;
+  /**
+   * \return true if the set is empty
+   */
+  bool IsEmpty (void) const;
+  /**
+   * \return the number of AIDs in the set
+   */
+  uint32_t GetCount (void) const;
+
+
+private:
+  std::vector<uint64_t> m_words; //!< bit i of word j is AID 64 * j + i
+};
+
+} //namespace ns3
+
+#endif /* AID_BITMAP_H */
@@ -40,6 +40,7 @@
 #include "ns3/uinteger.h"
 #include "wifi-mac-queue.h"
 #include <map>
+#include <algorithm>
 
 
 
@@ -182,10 +183,11 @@ ApWifiMac::ApWifiMac ()
   AuthenThreshold = 0;
   currentRawGroup = 0;
   //m_SlotFormat = 0;
-  m_AidToMacAddr.clear ();
-  m_accessList.clear ();
-  m_supportPageSlicingList.clear();
-  m_sleepList.clear ();
+  m_sleepList = Create<AidBitmap> ();
+  for (EdcaQueues::iterator i = m_edca.begin (); i != m_edca.end (); ++i)
+    {
+      i->second->SetsleepList (m_sleepList);
+    }
   m_DTIMCount = 0;
   //m_DTIMOffset = 0;
 }
@@ -491,8 +493,8 @@ ApWifiMac::ForwardDown (Ptr<const Packet> packet, Mac48Address from,
 	  if (aid == -1)
 		  NS_LOG_INFO (Simulator::Now().GetMicroSeconds() << " ms: AP cannot forward down data because There is no RAW for this MAC address.");
 	  */
-	  do {aid++;}
-	  while (m_AidToMacAddr.find(aid)->second != to); //TODO optimize search
+	  aid = AidBitmap::GetAid (to);
+	  NS_ASSERT (GetStaAddress (aid) == to);
 
 	  NS_LOG_INFO (Simulator::Now().GetMicroSeconds() << " ms: AP to forward data for [aid=" << aid << "]");
 
@@ -584,42 +586,44 @@ ApWifiMac::GetSlotStartTimeFromAid (uint16_t aid) const
 	}
 
 	//std::cout << "aid=" << (int)aid << ", toTim=" << (int)toTim << std::endl;
-	uint16_t raw_len = (*m_rpsset.rpsset.at(toTim)).GetInformationFieldSize();
+	Ptr<const RawSchedule> schedule = GetRawSchedule (toTim);
+	uint8_t raw_index = schedule->GetFirstGroup (aid);
+	if (raw_index != RawSchedule::NO_GROUP)
+	{
+		const RawSchedule::Group &group = schedule->GetGroup (raw_index);
+		uint16_t statRawSlot = (aid & 0x03ff) % group.slotNum;
+		Time start = group.start + group.slotDuration * statRawSlot;
+		NS_LOG_DEBUG ("[aid=" << aid << "] is located in RAW " << (int)raw_index + 1 << " in slot " << statRawSlot + 1 << ". RAW slot start time relative to the beacon = " << start.GetMicroSeconds() << " us.");
+		return start;
+	}
+	// AIDs that are not assigned to any RAW group can sleep through all the RAW groups
+	// For station that does not belong to anz RAW group, return the start of the last RAW group
+	if (schedule->GetNGroups () == 0)
+	{
+		return MicroSeconds (0);
+	}
+	return schedule->GetGroup (schedule->GetNGroups () - 1).start;
+}
 
-	uint16_t rawAssignment_len = 6;
-	if (raw_len % rawAssignment_len !=0)
+Ptr<const RawSchedule>
+ApWifiMac::GetRawSchedule (uint32_t index) const
+{
+	if (m_rawSchedules.size () != m_rpsset.rpsset.size ())
 	{
-		NS_ASSERT ("RAW configuration incorrect!");
+		m_rawSchedules.assign (m_rpsset.rpsset.size (), 0);
+		m_rawScheduleKeys.assign (m_rpsset.rpsset.size (), std::vector<uint8_t> ());
 	}
-	uint8_t RAW_number = raw_len/rawAssignment_len;
-
-    uint16_t slotDurationCount=0;
-    uint16_t slotNum=0;
-    uint64_t currentRAW_start=0;
-    Time lastRawDurationus = MicroSeconds(0);
-    int x = 0;
-	for (uint8_t raw_index=0; raw_index < RAW_number; raw_index++)
+	// the RPS may have been replaced or edited since it was decoded
+	const RPS &rps = *m_rpsset.rpsset.at (index);
+	const uint8_t *bytes = rps.GetRawAssignment ();
+	std::vector<uint8_t> &key = m_rawScheduleKeys[index];
+	if (m_rawSchedules[index] == 0 || key.size () != rps.GetInformationFieldSize ()
+	    || !std::equal (key.begin (), key.end (), bytes))
 	{
-		RPS::RawAssignment ass = m_rpsset.rpsset.at(toTim)->GetRawAssigmentObj(raw_index);
-		currentRAW_start += (500 + slotDurationCount * 120) * slotNum;
-		slotDurationCount = ass.GetSlotDurationCount();
-		slotNum = ass.GetSlotNum();
-		Time slotDuration = MicroSeconds(500 + slotDurationCount * 120);
-		lastRawDurationus += slotDuration * slotNum;
-		if (ass.GetRawGroupAIDStart() <= aid && aid <= ass.GetRawGroupAIDEnd()) {
-			uint16_t statRawSlot = (aid & 0x03ff) % slotNum;
-			Time start = MicroSeconds((500 + slotDurationCount * 120) * statRawSlot + currentRAW_start);
-			NS_LOG_DEBUG ("[aid=" << aid << "] is located in RAW " << (int)raw_index + 1 << " in slot " << statRawSlot + 1 << ". RAW slot start time relative to the beacon = " << start.GetMicroSeconds() << " us.");
-			x = 1;
-			return start;
-		}
+		key.assign (bytes, bytes + rps.GetInformationFieldSize ());
+		m_rawSchedules[index] = RawSchedule::Get (rps);
 	}
-	// AIDs that are not assigned to any RAW group can sleep through all the RAW groups
-	// For station that does not belong to anz RAW group, return the time after all RAW groups
-	/*currentRAW_start += (500 + slotDurationCount * 120) * slotNum;
-	NS_LOG_DEBUG ("[aid=" << aid << "] is located outside all RAWs. It can start contending " << currentRAW_start << " us after the beacon.");*/
-	//NS_ASSERT (x);
-	return MicroSeconds (currentRAW_start);
+	return m_rawSchedules[index];
 }
 
 void
@@ -763,13 +767,13 @@ ApWifiMac::SendAssocResp (Mac48Address to, bool success, uint8_t staType)
   Ptr<Packet> packet = Create<Packet> ();
   MgtAssocResponseHeader assoc;
   
-  uint8_t mac[6];
-  to.CopyTo (mac);
-  uint8_t aid_l = mac[5];
-  uint8_t aid_h = mac[4] & 0x1f;
-  uint16_t aid = (aid_h << 8) | (aid_l << 0); //assign mac address as AID
+  uint16_t aid = AidBitmap::GetAid (to); //assign mac address as AID
   assoc.SetAID(aid); //
-  m_AidToMacAddr[aid]=to;
+  if (aid >= m_aidToMacAddr.size ())
+    {
+      m_aidToMacAddr.resize (aid + 1);
+    }
+  m_aidToMacAddr[aid] = to;
 
   StatusCode code;
   if (success)
@@ -870,12 +874,12 @@ ApWifiMac::HasPacketsToBlock (uint16_t blockInd , uint16_t PageInd)
        for (uint16_t j = 0; j <= 7; j++) //8 stations in each subblock
         {
            sta_aid = subblock | j;
-           if (m_stationManager->IsAssociated (m_AidToMacAddr.find(sta_aid)->second) && HasPacketsInQueueTo(m_AidToMacAddr.find(sta_aid)->second) )
+           if (m_associatedList.IsSet (sta_aid) && HasPacketsInQueueTo (GetStaAddress (sta_aid)))
             {
         	   blockBitmap = blockBitmap | (1 << i);
         	   NS_LOG_DEBUG ("[aid=" << sta_aid << "] " << "paged");
         	   // if there is at least one station associated with AP that has FALSE for PageSlicingImplemented within this page then m_PageSliceNum = 31
-        	   if (!m_supportPageSlicingList.at(m_AidToMacAddr[sta_aid]))
+        	   if (!m_supportPageSlicingList.IsSet (sta_aid))
         		   m_PageSliceNum = 31;
         	   break;
             }
@@ -896,57 +900,38 @@ ApWifiMac::HasPacketsToSubBlock (uint16_t subblockInd, uint16_t blockInd , uint1
     for (uint16_t j = 0; j <= 7; j++) //8 stations in each subblock
         {
            sta_aid = subblock | j;
-           if (m_stationManager->IsAssociated (m_AidToMacAddr.find(sta_aid)->second) && HasPacketsInQueueTo(m_AidToMacAddr.find(sta_aid)->second) )
+           if (m_associatedList.IsSet (sta_aid) && HasPacketsInQueueTo (GetStaAddress (sta_aid)))
              {
                subblockBitmap = subblockBitmap | (1 << j); 
-               m_sleepList[m_AidToMacAddr.find(sta_aid)->second]=false;
+               m_sleepList->Reset (sta_aid);
              } 
         }
     return subblockBitmap;
 }
     
 
-bool 
-ApWifiMac::HasPacketsInQueueTo(Mac48Address dest) 
-{           
-    //check also if ack received
-    Ptr<const Packet> peekedPacket_VO, peekedPacket_VI, peekedPacket_BE, peekedPacket_BK;
-    WifiMacHeader peekedHdr;
-    Time tstamp;
-        
-    peekedPacket_VO = m_edca.find(AC_VO)->second->GetEdcaQueue()->PeekByAddress (WifiMacHeader::ADDR1, dest);
-    peekedPacket_VI = m_edca.find(AC_VI)->second->GetEdcaQueue()->PeekByAddress (WifiMacHeader::ADDR1, dest);
-    peekedPacket_BE = m_edca.find(AC_BE)->second->GetEdcaQueue()->PeekByAddress (WifiMacHeader::ADDR1, dest);
-    peekedPacket_BK = m_edca.find(AC_BK)->second->GetEdcaQueue()->PeekByAddress (WifiMacHeader::ADDR1, dest);
-        
-    if (peekedPacket_VO != 0 || peekedPacket_VI != 0 || peekedPacket_BE != 0 || peekedPacket_BK != 0 )
-       {
-         return true;
-       }
-    else
-      {
-         return false;
-      }
+bool
+ApWifiMac::HasPacketsInQueueTo (Mac48Address dest)
+{
+  //the queues count their packets per receiver; all of them are asked so
+  //that they all drop their expired packets now
+  bool hasPacketsVo = m_edca.find (AC_VO)->second->GetEdcaQueue ()->HasPacketsTo (dest);
+  bool hasPacketsVi = m_edca.find (AC_VI)->second->GetEdcaQueue ()->HasPacketsTo (dest);
+  bool hasPacketsBe = m_edca.find (AC_BE)->second->GetEdcaQueue ()->HasPacketsTo (dest);
+  bool hasPacketsBk = m_edca.find (AC_BK)->second->GetEdcaQueue ()->HasPacketsTo (dest);
+  return hasPacketsVo || hasPacketsVi || hasPacketsBe || hasPacketsBk;
 }
  
+Mac48Address
+ApWifiMac::GetStaAddress (uint16_t aid) const
+{
+  return aid < m_aidToMacAddr.size () ? m_aidToMacAddr[aid] : Mac48Address ();
+}
+
 uint16_t ApWifiMac::RpsIndex = 0;
 void
-ApWifiMac::SetaccessList (std::map<Mac48Address, bool> list)
+ApWifiMac::SetaccessList (Ptr<const AidBitmap> list)
 {
-        Mac48Address stasAddr;
-
-            
-        if (list.size () == 0)
-         {
-            return;
-         }
-              
-        for (uint32_t k = 1; k <= m_totalStaNum; k++)
-          {   
-            stasAddr = m_AidToMacAddr.find(k)->second;
-            //NS_LOG_UNCOND ( "aid "  << k << ", send " << list.find(stasAddr)->second << ", at " << Simulator::Now () << ", size " << list.size ());
-          }     
-               
         m_edca.find (AC_VO)->second->SetaccessList (list);
         m_edca.find (AC_VI)->second->SetaccessList (list);
         m_edca.find (AC_BE)->second->SetaccessList (list);
@@ -974,33 +959,16 @@ ApWifiMac::SendOneBeacon (void)
       compatibility.SetBeaconInterval (m_beaconInterval.GetMicroSeconds ());
       beacon.SetBeaconCompatibility (compatibility);
      
-      RPS *m_rps;
-      if (RpsIndex < m_rpsset.rpsset.size())
-         {
-            m_rps = m_rpsset.rpsset.at(RpsIndex);
-            NS_LOG_INFO ("< RpsIndex =" << RpsIndex);
-            RpsIndex++;
-          }
-      else
-         {
-            m_rps = m_rpsset.rpsset.at(0);
-            NS_LOG_INFO ("RpsIndex =" << RpsIndex);
-            RpsIndex = 1;
-          }
+      uint32_t rpsIndex = RpsIndex < m_rpsset.rpsset.size() ? RpsIndex : 0;
+      NS_LOG_INFO ("RpsIndex =" << RpsIndex);
+      RPS *m_rps = m_rpsset.rpsset.at(rpsIndex);
+      Ptr<const RawSchedule> schedule = GetRawSchedule (rpsIndex);
+      RpsIndex = rpsIndex + 1;
       beacon.SetRPS (*m_rps);
 
-    Mac48Address stasleepAddr;
-    for (auto i=m_AidToMacAddr.begin(); i != m_AidToMacAddr.end() ; ++i)
-    {
-    	// assume all station sleep, then change some to awake state based on downlink data
-    	//This implementation is temporary, should be removed if ps-poll is supported
-
-    	stasleepAddr = i->second;
-    	if (m_stationManager->IsAssociated (stasleepAddr))
-    	{
-    		m_sleepList[stasleepAddr]=true;
-    	}
-    }
+    // assume all station sleep, then change some to awake state based on downlink data
+    //This implementation is temporary, should be removed if ps-poll is supported
+    m_sleepList->SetAll (m_associatedList);
 
     if (m_DTIMCount == 0 && GetPageSlicingActivated ()) // TODO filter when GetPageSlicingActivated() is false
       {
@@ -1056,8 +1024,8 @@ ApWifiMac::SendOneBeacon (void)
     m_PageIndex = m_pageslice.GetPageindex();
     //m_TIM.SetPageIndex (m_PageIndex);
     uint64_t numPagedStas (0);
-    for (auto it = m_supportPageSlicingList.begin(); it != m_supportPageSlicingList.end(); ++it){
-    	if (m_stationManager->IsAssociated (it->first) && HasPacketsInQueueTo(it->first) )
+    for (uint16_t aid = 0; aid < m_aidToMacAddr.size (); aid++){
+    	if (m_associatedList.IsSet (aid) && HasPacketsInQueueTo (m_aidToMacAddr[aid]))
     	{
     		numPagedStas++;
     	}
@@ -1163,11 +1131,7 @@ ApWifiMac::SendOneBeacon (void)
       }
     //NS_ASSERT (m_DTIMPeriod - m_DTIMCount + m_DTIMOffset == m_DTIMPeriod || (m_DTIMCount == 0 && m_DTIMOffset == 0));
     
-    //set sleep list, temporary, removed if ps-poll supported 
-    m_edca.find (AC_VO)->second->SetsleepList (m_sleepList);
-    m_edca.find (AC_VI)->second->SetsleepList (m_sleepList);
-    m_edca.find (AC_BE)->second->SetsleepList (m_sleepList);
-    m_edca.find (AC_BK)->second->SetsleepList (m_sleepList);
+    //the sleep list, temporary, removed if ps-poll supported, is shared with the EDCA queues
     
     
    
@@ -1207,90 +1171,61 @@ ApWifiMac::SendOneBeacon (void)
     		  "Transmission of beacon will take " << txTime << ", delaying RAW start for that amount");
       Time bufferTimeToAllowBeaconToBeReceived = txTime;
       //bufferTimeToAllowBeaconToBeReceived = MicroSeconds (5600);
-      auto nRaw = m_rps->GetNumberOfRawGroups();
+      auto nRaw = schedule->GetNGroups();
       currentRawGroup = (currentRawGroup + 1) % nRaw;
 
       uint16_t startaid;
       uint16_t endaid;
-      Mac48Address stasAddr;
       //uint16_t offset;
       uint16_t statsPerSlot;
       uint16_t statRawSlot;
 
       //NS_LOG_UNCOND ("ap send beacon at " << Simulator::Now ());
 
-      m_accessList.clear ();
-      for (uint16_t i=1; i<= m_totalStaNum;i++)
-      {
-    	  // assume all station sleeps, then change some to awake state based on downlink data
-    	  //This implementation is temporary, should be removed if ps-poll is supported
-    	  if (m_AidToMacAddr.size () == 0)
-    	  {
-    		  break;
-    	  }
-    	  stasAddr = m_AidToMacAddr.find(i)->second;
-
-    	  if (m_stationManager->IsAssociated (stasAddr))
-    	  {
-    		  m_accessList[stasAddr]=false;
-    	  }
-     }
-      //NS_LOG_UNCOND ("m_accessList.size " << m_accessList.size ());
-
-
       // schedule the slot start
       Time timeToSlotStart = Time ();
       for (uint32_t g = 0; g < nRaw; g++)
       {
-    	  if (m_AidToMacAddr.size () == 0)
+    	  if (m_aidToMacAddr.size () == 0)
     	  {
     		  break;
     	  }
 
 
-    	  startaid = m_rps->GetRawAssigmentObj(g).GetRawGroupAIDStart();
-    	  endaid = m_rps->GetRawAssigmentObj(g).GetRawGroupAIDEnd();
+    	  const RawSchedule::Group &group = schedule->GetGroup (g);
+    	  startaid = group.aidStart;
+    	  endaid = group.aidEnd;
 
 
 
     	  //offset =0; // for test
-    	  //m_slotNum=m_rps->GetRawAssigmentObj(g).GetSlotNum();
-    	  statsPerSlot = (endaid - startaid + 1)/m_rps->GetRawAssigmentObj(g).GetSlotNum();
+    	  statsPerSlot = (endaid - startaid + 1)/group.slotNum;
 
-    	  for (uint32_t i = 0; i < m_rps->GetRawAssigmentObj(g).GetSlotNum(); i++)
+    	  for (uint32_t i = 0; i < group.slotNum; i++)
     	  {
+    		  // the stations allowed in the slot, handed over to the EDCA queues when it starts
+    		  Ptr<AidBitmap> accessList = Create<AidBitmap> ();
     		  for (uint32_t k = startaid; k <= endaid; k++)
     		  {
 
-    			  statRawSlot = (k & 0x03ff) % m_rps->GetRawAssigmentObj(g).GetSlotNum(); //slot that the station k will be
+    			  statRawSlot = (k & 0x03ff) % group.slotNum; //slot that the station k will be
     			  // station is in sot i
     			  if (statRawSlot == i )
     			  {
-    				  stasAddr = m_AidToMacAddr.find(k)->second;
-    				  if (m_stationManager->IsAssociated (stasAddr))
+    				  if (m_associatedList.IsSet (k))
     				  {
-    					  m_accessList[stasAddr]=true;
+    					  accessList->Set (k);
     				  }
     			  }
 
     		  }
     		  Simulator::Schedule(bufferTimeToAllowBeaconToBeReceived + timeToSlotStart,
-    				  &ApWifiMac::SetaccessList, this, m_accessList);
+    				  &ApWifiMac::SetaccessList, this, accessList);
 
     		  Simulator::Schedule(
     				  bufferTimeToAllowBeaconToBeReceived + timeToSlotStart,
     				  &ApWifiMac::OnRAWSlotStart, this, RpsIndex, g + 1, i + 1);
-    		  timeToSlotStart += MicroSeconds(500 + m_rps->GetRawAssigmentObj(g).GetSlotDurationCount() * 120);
-
-    		  for (uint16_t i=1; i<= m_totalStaNum;i++)
-    		  {
-    			  stasAddr = m_AidToMacAddr.find(i)->second;
-
-    			  if (m_stationManager->IsAssociated (stasAddr))
-    			  {
-    				  m_accessList[stasAddr]=false;
-    			  }
-    		  }
+    		  timeToSlotStart += group.slotDuration;
     	  }
       }
       //NS_LOG_UNCOND(GetAddress () << ", " << startaid << "\t" << endaid << ", at " << Simulator::Now () << ", bufferTimeToAllowBeaconToBeReceived " << bufferTimeToAllowBeaconToBeReceived);
@@ -1344,6 +1279,7 @@ ApWifiMac::TxOk (const WifiMacHeader &hdr)
     {
       NS_LOG_DEBUG ("associated with sta=" << hdr.GetAddr1 ());
       m_stationManager->RecordGotAssocTxOk (hdr.GetAddr1 ());
+      m_associatedList.Set (AidBitmap::GetAid (hdr.GetAddr1 ()));
     }
 }
 
@@ -1358,6 +1294,7 @@ ApWifiMac::TxFailed (const WifiMacHeader &hdr)
     {
       NS_LOG_DEBUG ("assoc failed with sta=" << hdr.GetAddr1 ());
       m_stationManager->RecordGotAssocTxFailed (hdr.GetAddr1 ());
+      m_associatedList.Reset (AidBitmap::GetAid (hdr.GetAddr1 ()));
     }
 }
 
@@ -1531,6 +1468,7 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
                     }
                     
                   m_stationManager->RecordWaitAssocTxOk (from);
+                  m_associatedList.Reset (AidBitmap::GetAid (from));
                   
                   if (m_s1gSupported)
                     {
@@ -1538,7 +1476,14 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
                       m_stationManager->AddStationS1gCapabilities (from,s1gcapabilities);
                       uint8_t sta_type = s1gcapabilities.GetStaType ();
                       bool pageSlicingSupported = s1gcapabilities.GetPageSlicingSupport() != 0;
-                      m_supportPageSlicingList[hdr->GetAddr2 ()] = pageSlicingSupported;
+                      if (pageSlicingSupported)
+                        {
+                          m_supportPageSlicingList.Set (AidBitmap::GetAid (hdr->GetAddr2 ()));
+                        }
+                      else
+                        {
+                          m_supportPageSlicingList.Reset (AidBitmap::GetAid (hdr->GetAddr2 ()));
+                        }
                       SendAssocResp (hdr->GetAddr2 (), true, sta_type);
                     }
                   else
@@ -1553,11 +1498,8 @@ ApWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
           else if (hdr->IsDisassociation ())
             {
               m_stationManager->RecordDisassociated (from);
-              uint8_t mac[6];
-              from.CopyTo (mac);
-              uint8_t aid_l = mac[5];
-              uint8_t aid_h = mac[4] & 0x1f;
-              uint16_t aid = (aid_h << 8) | (aid_l << 0);
+              uint16_t aid = AidBitmap::GetAid (from);
+              m_associatedList.Reset (aid);
               NS_LOG_UNCOND ("Disassociation request from aid " << aid);
 
              for (std::vector<uint16_t>::iterator it = m_sensorList.begin(); it != m_sensorList.end(); it++)
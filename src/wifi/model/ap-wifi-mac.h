@@ -30,7 +30,9 @@
 #include "supported-rates.h"
 #include "ns3/random-variable-stream.h"
 #include "rps.h"
+#include "raw-schedule.h"
 #include "tim.h"
+#include "aid-bitmap.h"
 #include "pageSlice.h"
 #include "s1g-raw-control.h"
 #include "ns3/string.h"
@@ -133,7 +135,10 @@ public:
    * \return the number of stream indices assigned by this model
    */
   int64_t AssignStreams (int64_t stream);
-  void SetaccessList (std::map<Mac48Address, bool> list);
+  /**
+   * \param list the stations allowed to transmit in the RAW slot starting now
+   */
+  void SetaccessList (Ptr<const AidBitmap> list);
 
   uint8_t GetDTIMPeriod (void) const;
   void SetDTIMPeriod (uint8_t period);
@@ -256,10 +261,18 @@ private:
   uint32_t GetSlotNum (void) const;
 
   Time GetSlotStartTimeFromAid (uint16_t aid) const;
+  /**
+   * \param index the index of the RPS in m_rpsset
+   *
+   * \return the decoded RAW groups of the RPS
+   */
+  Ptr<const RawSchedule> GetRawSchedule (uint32_t index) const;
   void SetPageSlicingActivated (bool activate);
   bool GetPageSlicingActivated (void) const;
 
   RPSVector m_rpsset;
+  mutable std::vector<Ptr<const RawSchedule> > m_rawSchedules; //!< decoded RAW groups of m_rpsset
+  mutable std::vector<std::vector<uint8_t> > m_rawScheduleKeys; //!< RAW assignments m_rawSchedules were decoded from
   pageSlice m_pageslice;
   TIM m_TIM;
   void SetTotalStaNum (uint32_t num);
@@ -305,11 +318,18 @@ private:
   std::vector<uint16_t> m_sensorList; //stations allowed to transmit in last beacon
   std::vector<uint16_t> m_OffloadList;
   std::vector<uint16_t> m_receivedAid;
-  std::map<uint16_t, Mac48Address> m_AidToMacAddr;
-  std::map<Mac48Address, bool> m_accessList;
-    
-  std::map<Mac48Address, bool> m_sleepList;
-  std::map<Mac48Address, bool> m_supportPageSlicingList;
+  /**
+   * \param aid the AID of a station
+   *
+   * \return the MAC address of the station, or 00:00:00:00:00:00 if no
+   *         station has been given the AID
+   */
+  Mac48Address GetStaAddress (uint16_t aid) const;
+
+  std::vector<Mac48Address> m_aidToMacAddr; //!< MAC address of the stations, indexed by AID
+  AidBitmap m_associatedList;               //!< stations associated with the AP
+  Ptr<AidBitmap> m_sleepList;               //!< sleeping stations, shared with the EDCA queues
+  AidBitmap m_supportPageSlicingList;       //!< stations supporting page slicing
 
   S1gRawCtr m_S1gRawCtr;
   Ptr<DcaTxop> m_beaconDca;                  //!< Dedicated DcaTxop for beacons
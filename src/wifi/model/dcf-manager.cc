@@ -338,7 +338,8 @@ DcfManager::DcfManager ()
     m_slotTimeUs (0),
     m_sifs (Seconds (0.0)),
     m_phyListener (0),
-    m_lowListener (0)
+    m_lowListener (0),
+    m_accessGrantStartValid (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -443,6 +444,7 @@ DcfManager::SetSifs (Time sifs)
 {
   NS_LOG_FUNCTION (this << sifs);
   m_sifs = sifs;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -450,6 +452,7 @@ DcfManager::SetEifsNoDifs (Time eifsNoDifs)
 {
   NS_LOG_FUNCTION (this << eifsNoDifs);
   m_eifsNoDifs = eifsNoDifs;
+  InvalidateAccessGrantStart ();
 }
 
 Time
@@ -644,6 +647,10 @@ Time
 DcfManager::GetAccessGrantStart (void) const
 {
   NS_LOG_FUNCTION (this);
+  if (m_accessGrantStartValid)
+    {
+      return m_accessGrantStart;
+    }
   Time rxAccessStart;
   if (!m_rxing)
     {
@@ -676,9 +683,17 @@ DcfManager::GetAccessGrantStart (void) const
                ", busy access start=" << busyAccessStart <<
                ", tx access start=" << txAccessStart <<
                ", nav access start=" << navAccessStart);
+  m_accessGrantStart = accessGrantedStart;
+  m_accessGrantStartValid = true;
   return accessGrantedStart;
 }
 
+void
+DcfManager::InvalidateAccessGrantStart (void)
+{
+  m_accessGrantStartValid = false;
+}
+
 Time
 DcfManager::GetBackoffStartFor (DcfState *state)
 {
@@ -694,7 +709,8 @@ DcfManager::GetBackoffEndFor (DcfState *state)
 {
   //return GetBackoffStartFor (state) + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
 	//std::cout << "Calculating backoff end, start is " << GetBackoffStartFor (state).GetMicroSeconds() << ", duration of backoff is (slots: " << state->GetBackoffSlots() << ", slot duration: " << m_slotTimeUs << "), total duration: " << state->GetBackoffSlots () * m_slotTimeUs << std::endl;
-    Time backOffEnd = GetBackoffStartFor (state) + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
+    Time backoffStart = GetBackoffStartFor (state);
+    Time backOffEnd = backoffStart + MicroSeconds (state->GetBackoffSlots () * m_slotTimeUs);
 
 	if(m_rawSlotStart + m_rawSlotDuration == Time(0)) // if not set
 		return backOffEnd;
@@ -706,7 +722,7 @@ DcfManager::GetBackoffEndFor (DcfState *state)
 		//		<< ", " << "Raw slot end: " << (m_rawSlotStart + m_rawSlotDuration).GetMicroSeconds() << ")" <<  std::endl;
 		Time adjusted = backOffEnd - (m_rawSlotStart + m_rawSlotDuration);
 
-		if(adjusted <= GetBackoffStartFor (state)) {
+		if(adjusted <= backoffStart) {
 			// eh can't adjust it, the start of the backoff is already later
 			// nothing to be done now, let it drop
 			//std::cout << "Unable to adjust the backoff end to prevent going out of the RAW period, the start is already later than the raw slot end" << std::endl;;
@@ -725,6 +741,15 @@ void
 DcfManager::UpdateBackoff (void)
 {
   NS_LOG_FUNCTION (this);
+  /**
+   * The backoff of every DcfState starts AIFS after the access grant start
+   * at the earliest: while the medium is busy, all the backoff counters are
+   * frozen and none needs to be updated.
+   */
+  if (GetAccessGrantStart () > Simulator::Now ())
+    {
+      return;
+    }
   uint32_t k = 0;
   for (States::const_iterator i = m_states.begin (); i != m_states.end (); i++, k++)
     {
@@ -793,6 +818,7 @@ DcfManager::NotifyRxStartNow (Time duration)
   m_lastRxStart = Simulator::Now ();
   m_lastRxDuration = duration;
   m_rxing = true;
+  InvalidateAccessGrantStart ();
   m_RxingTrace (1, Simulator::Now ().GetMicroSeconds ());
 }
 
@@ -805,8 +831,8 @@ DcfManager::NotifyRxEndOkNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxReceivedOk = true;
   m_rxing = false;
+  InvalidateAccessGrantStart ();
   m_RxingTrace (0, Simulator::Now ().GetMicroSeconds ());
-
 }
 
 void
@@ -818,6 +844,7 @@ DcfManager::NotifyRxEndErrorNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxReceivedOk = false;
   m_rxing = false;
+  InvalidateAccessGrantStart ();
   m_RxingTrace (0, Simulator::Now ().GetMicroSeconds ());
 }
 
@@ -835,12 +862,14 @@ DcfManager::NotifyTxStartNow (Time duration)
       m_lastRxDuration = m_lastRxEnd - m_lastRxStart;
       m_lastRxReceivedOk = true;
       m_rxing = false;
+      InvalidateAccessGrantStart ();
       m_RxingTrace (0, Simulator::Now ().GetMicroSeconds ());
     }
   MY_DEBUG ("tx start for " << duration);
   UpdateBackoff ();
   m_lastTxStart = Simulator::Now ();
   m_lastTxDuration = duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -852,6 +881,7 @@ DcfManager::NotifyMaybeCcaBusyStartNow (Time duration)
   UpdateBackoff ();
   m_lastBusyStart = Simulator::Now ();
   m_lastBusyDuration = duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -912,6 +942,7 @@ DcfManager::NotifySwitchingStartNow (Time duration)
   MY_DEBUG ("switching start for " << duration);
   m_lastSwitchingStart = Simulator::Now ();
   m_lastSwitchingDuration = duration;
+  InvalidateAccessGrantStart ();
 
 }
 
@@ -963,6 +994,7 @@ DcfManager::NotifyNavResetNow (Time duration)
   UpdateBackoff ();
   m_lastNavStart = Simulator::Now ();
   m_lastNavDuration = duration;
+  InvalidateAccessGrantStart ();
   UpdateBackoff ();
   /**
    * If the nav reset indicates an end-of-nav which is earlier
@@ -986,6 +1018,7 @@ DcfManager::NotifyNavStartNow (Time duration)
     {
       m_lastNavStart = Simulator::Now ();
       m_lastNavDuration = duration;
+      InvalidateAccessGrantStart ();
     }
 }
 
@@ -995,6 +1028,7 @@ DcfManager::NotifyAckTimeoutStartNow (Time duration)
   NS_LOG_FUNCTION (this << duration);
   NS_ASSERT (m_lastAckTimeoutEnd < Simulator::Now ());
   m_lastAckTimeoutEnd = Simulator::Now () + duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -1002,6 +1036,7 @@ DcfManager::NotifyAckTimeoutResetNow ()
 {
   NS_LOG_FUNCTION (this);
   m_lastAckTimeoutEnd = Simulator::Now ();
+  InvalidateAccessGrantStart ();
   DoRestartAccessTimeoutIfNeeded ();
 }
 
@@ -1010,6 +1045,7 @@ DcfManager::NotifyCtsTimeoutStartNow (Time duration)
 {
   NS_LOG_FUNCTION (this << duration);
   m_lastCtsTimeoutEnd = Simulator::Now () + duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -1017,6 +1053,7 @@ DcfManager::NotifyCtsTimeoutResetNow ()
 {
   NS_LOG_FUNCTION (this);
   m_lastCtsTimeoutEnd = Simulator::Now ();
+  InvalidateAccessGrantStart ();
   DoRestartAccessTimeoutIfNeeded ();
 }
 } //namespace ns3
@@ -492,8 +492,17 @@ private:
    * the time returned by this method.
    *
    * \returns the absolute time at which access could start to be granted
+   *
+   * The access grant start is the same for all the DcfStates and only
+   * changes with the medium state, so it is computed once after every
+   * medium state change rather than once per DcfState and event.
    */
   Time GetAccessGrantStart (void) const;
+  /**
+   * Recompute the access grant start on next use, to be called whenever
+   * the medium state it depends on changes.
+   */
+  void InvalidateAccessGrantStart (void);
   /**
    * Return the time when the backoff procedure
    * started for the given DcfState.
@@ -564,6 +573,9 @@ private:
 
   Time m_rawSlotStart;
   Time m_rawSlotDuration;
+
+  mutable Time m_accessGrantStart;      //!< cached access grant start
+  mutable bool m_accessGrantStartValid; //!< whether m_accessGrantStart is up to date
 };
 
 } //namespace ns3
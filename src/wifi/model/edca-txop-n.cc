@@ -320,6 +320,8 @@ EdcaTxopN::DoDispose (void)
   m_blockAckListener = 0;
   m_txMiddle = 0;
   m_aggregator = 0;
+  m_accessList = 0;
+  m_sleepList = 0;
 }
 
 bool
@@ -497,13 +499,13 @@ EdcaTxopN::RemoveRetransmitPacket (uint8_t tid, Mac48Address recipient, uint16_t
 }
 
 void
-EdcaTxopN::SetaccessList (std::map<Mac48Address, bool> list)
+EdcaTxopN::SetaccessList (Ptr<const AidBitmap> list)
 {
     m_accessList = list;
 }
 
 void
-EdcaTxopN::SetsleepList (std::map<Mac48Address, bool> list)
+EdcaTxopN::SetsleepList (Ptr<const AidBitmap> list)
 {
     m_sleepList = list;
 }
@@ -554,7 +556,7 @@ EdcaTxopN::NotifyAccessGranted (void)
           
           //while (1)
            // {
-              if (!(!m_sleepList.find(m_currentHdr.GetAddr1())->second || m_sleepList.size ()== 0)) // "m_sleepList.size ()== 0" for non-ap stations
+              if (m_sleepList != 0 && m_sleepList->IsSet (AidBitmap::GetAid (m_currentHdr.GetAddr1 ()))) // no sleep list for non-ap stations
               // no sleep 
                 {
             	  return;
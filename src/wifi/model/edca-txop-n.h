@@ -32,6 +32,7 @@
 #include "dcf.h"
 #include "ctrl-headers.h"
 #include "block-ack-manager.h"
+#include "aid-bitmap.h"
 #include <map>
 #include <list>
 #include "ns3/traced-callback.h"
@@ -494,8 +495,16 @@ public:
   void RawStart (Time duration, bool crossSlotBoundaryAllowed);
   void OutsideRawStart (void);
   
-  void SetaccessList (std::map<Mac48Address, bool> list);
-  void SetsleepList (std::map<Mac48Address, bool> list);
+  /**
+   * \param list the stations allowed to transmit in the current RAW slot,
+   *        shared with the AP
+   */
+  void SetaccessList (Ptr<const AidBitmap> list);
+  /**
+   * \param list the sleeping stations, shared with the AP and updated by
+   *        the AP at every beacon
+   */
+  void SetsleepList (Ptr<const AidBitmap> list);
 
 
 private:
@@ -596,12 +605,12 @@ private:
   struct Bar m_currentBar;
   bool m_ampduExist;
   
-  std::map<Mac48Address, bool> m_accessList;
+  Ptr<const AidBitmap> m_accessList;
   
   TracedCallback<uint32_t> m_collisionTrace;
   TracedCallback<Time,Time> m_transmissionWillCrossRAWBoundary;
 
-  std::map<Mac48Address, bool> m_sleepList;
+  Ptr<const AidBitmap> m_sleepList; //!< null for non-AP stations
 };
 
 } //namespace ns3
@@ -90,6 +90,7 @@ void
 S1gBeaconHeader::SetRPS (RPS rps)
 {
   m_rps = rps;
+  m_rawSchedule = 0;
 }
 
 void
@@ -141,31 +142,41 @@ S1gBeaconHeader::GetAccessNetwork (void) const
   return m_accessnetwork;
 }
     
-S1gBeaconCompatibility
+const S1gBeaconCompatibility &
 S1gBeaconHeader::GetBeaconCompatibility (void) const
 {
   return m_beaconcompatibility;
 }
 
-TIM
+const TIM &
 S1gBeaconHeader::GetTIM (void) const
 {
   return m_tim;
 }
 
-pageSlice
+const pageSlice &
 S1gBeaconHeader::GetpageSlice (void) const
 {
   return m_pageSlice;
 }
     
-RPS
+const RPS &
 S1gBeaconHeader::GetRPS (void) const
 {
   return m_rps;
 }
+
+Ptr<const RawSchedule>
+S1gBeaconHeader::GetRawSchedule (void) const
+{
+  if (m_rawSchedule == 0)
+    {
+      m_rawSchedule = RawSchedule::Get (m_rps);
+    }
+  return m_rawSchedule;
+}
     
-AuthenticationCtrl
+const AuthenticationCtrl &
 S1gBeaconHeader::GetAuthCtrl (void) const
 {
   return m_auth;
@@ -255,6 +266,7 @@ S1gBeaconHeader::Deserialize (Buffer::Iterator start)
     i = m_beaconcompatibility.Deserialize (i);
     i = m_tim.Deserialize (i);
     i = m_rps.Deserialize (i);
+    m_rawSchedule = 0;
     if (!m_tim.GetDTIMCount())
     	i = m_pageSlice.Deserialize (i);
     i = m_auth.DeserializeIfPresent (i);
@@ -32,6 +32,7 @@
 #include "rps.h"
 #include "pageSlice.h"
 #include "authentication-control.h"
+#include "raw-schedule.h"
 
 namespace ns3 {
 
@@ -62,11 +63,15 @@ public:
   uint32_t GetNextTBTT (void) const;
   uint32_t GetCompressedSSID (void) const;
   uint8_t GetAccessNetwork (void) const;
-  S1gBeaconCompatibility GetBeaconCompatibility (void) const;
-  TIM GetTIM (void) const;
-  pageSlice GetpageSlice (void) const;
-  RPS GetRPS (void) const;
-  AuthenticationCtrl GetAuthCtrl (void) const;
+  const S1gBeaconCompatibility & GetBeaconCompatibility (void) const;
+  const TIM & GetTIM (void) const;
+  const pageSlice & GetpageSlice (void) const;
+  const RPS & GetRPS (void) const;
+  const AuthenticationCtrl & GetAuthCtrl (void) const;
+  /**
+   * \return the decoded RAW schedule of the RPS element, looked up on first use
+   */
+  Ptr<const RawSchedule> GetRawSchedule (void) const;
     
   static TypeId GetTypeId (void);
   virtual TypeId GetInstanceTypeId (void) const;
@@ -87,6 +92,7 @@ private:
   RPS m_rps;
   pageSlice m_pageSlice;
   AuthenticationCtrl  m_auth;
+  mutable Ptr<const RawSchedule> m_rawSchedule; //!< schedule of m_rps, null until looked up
 };
 
 
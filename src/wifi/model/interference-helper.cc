@@ -106,7 +106,8 @@ InterferenceHelper::Event::GetPreambleType (void) const
 
 InterferenceHelper::NiChange::NiChange (Time time, double delta)
   : m_time (time),
-    m_delta (delta)
+    m_delta (delta),
+    m_power (0.0)
 {
 }
 
@@ -122,6 +123,18 @@ InterferenceHelper::NiChange::GetDelta (void) const
   return m_delta;
 }
 
+double
+InterferenceHelper::NiChange::GetPower (void) const
+{
+  return m_power;
+}
+
+void
+InterferenceHelper::NiChange::SetPower (double power)
+{
+  m_power = power;
+}
+
 bool
 InterferenceHelper::NiChange::operator < (const InterferenceHelper::NiChange& o) const
 {
@@ -191,19 +204,22 @@ Time
 InterferenceHelper::GetEnergyDuration (double energyW)
 {
   Time now = Simulator::Now ();
-  double noiseInterferenceW = 0.0;
-  Time end = now;
-  noiseInterferenceW = m_firstPower;
-  for (NiChanges::const_iterator i = m_niChanges.begin (); i != m_niChanges.end (); i++)
+  NiChanges::iterator i = std::lower_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (now, 0));
+  if (!m_rxing)
     {
-      noiseInterferenceW += i->GetDelta ();
-      end = i->GetTime ();
-      if (end < now)
-        {
-          continue;
-        }
-      if (noiseInterferenceW < energyW)
+      EraseNiChanges (i);
+      i = m_niChanges.begin ();
+    }
+  if (m_niChanges.empty ())
+    {
+      return MicroSeconds (0);
+    }
+  Time end = m_niChanges.back ().GetTime ();
+  for (; i != m_niChanges.end (); i++)
+    {
+      if (i->GetPower () < energyW)
         {
+          end = i->GetTime ();
           break;
         }
     }
@@ -216,13 +232,14 @@ InterferenceHelper::AppendEvent (Ptr<InterferenceHelper::Event> event)
   Time now = Simulator::Now ();
   if (!m_rxing)
     {
-      NiChanges::iterator nowIterator = GetPosition (now);
-      for (NiChanges::iterator i = m_niChanges.begin (); i != nowIterator; i++)
+      EraseNiChanges (GetPosition (now));
+      NiChange start (event->GetStartTime (), event->GetRxPowerW ());
+      m_niChanges.push_front (start);
+      m_niChanges.front ().SetPower (m_firstPower + start.GetDelta ());
+      for (NiChanges::iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
         {
-          m_firstPower += i->GetDelta ();
+          i->SetPower (i->GetPower () + start.GetDelta ());
         }
-      m_niChanges.erase (m_niChanges.begin (), nowIterator);
-      m_niChanges.insert (m_niChanges.begin (), NiChange (event->GetStartTime (), event->GetRxPowerW ()));
     }
   else
     {
@@ -249,20 +266,26 @@ InterferenceHelper::CalculateSnr (double signal, double noiseInterference, WifiM
 }
 
 double
-InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculateNoiseInterferenceW (Ptr<InterferenceHelper::Event> event, NiChanges::const_iterator *first,
+                                                 NiChanges::const_iterator *last) const
 {
   double noiseInterference = m_firstPower;
   NS_ASSERT (m_rxing);
-  for (NiChanges::const_iterator i = m_niChanges.begin () + 1; i != m_niChanges.end (); i++)
+  NS_ASSERT (!m_niChanges.empty () && m_niChanges.front ().GetTime () == event->GetStartTime ());
+  *first = m_niChanges.begin () + 1;
+  //The end of the event is found by a binary search on its end time, and then
+  //by matching its power among the changes happening at that same time.
+  NiChanges::const_iterator i = std::lower_bound (*first, m_niChanges.end (), NiChange (event->GetEndTime (), 0));
+  while (i != m_niChanges.end () && i->GetTime () == event->GetEndTime ()
+         && event->GetRxPowerW () != -i->GetDelta ())
     {
-      if ((event->GetEndTime () == i->GetTime ()) && event->GetRxPowerW () == -i->GetDelta ())
-        {
-          break;
-        }
-      ni->push_back (*i);
+      i++;
+    }
+  if (i != m_niChanges.end () && i->GetTime () != event->GetEndTime ())
+    {
+      i = m_niChanges.end ();
     }
-  ni->insert (ni->begin (), NiChange (event->GetStartTime (), noiseInterference));
-  ni->push_back (NiChange (event->GetEndTime (), 0));
+  *last = i;
   return noiseInterference;
 }
 
@@ -280,12 +303,13 @@ InterferenceHelper::CalculateChunkSuccessRate (double snir, Time duration, WifiM
 }
 
 double
-InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event> event, double noiseInterferenceW,
+                                             NiChanges::const_iterator first, NiChanges::const_iterator last) const
 {
   NS_LOG_FUNCTION (this);
   double psr = 1.0; /* Packet Success Rate */
-  NiChanges::iterator j = ni->begin ();
-  Time previous = (*j).GetTime ();
+  NiChanges::const_iterator j = first;
+  Time previous = event->GetStartTime ();
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = event->GetPreambleType ();
   Time plcpHeaderStart;
@@ -299,26 +323,25 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event
   Time plcpSigBStart;
  if (payloadMode.GetModulationClass () != WIFI_MOD_CLASS_S1G)
  {
-  plcpHeaderStart = (*j).GetTime () + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble); //packet start time + preamble
+  plcpHeaderStart = previous + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble); //packet start time + preamble
   plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (payloadMode, preamble); //packet start time + preamble + L-SIG
   plcpHtTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG
   plcpPayloadStart = plcpHtTrainingSymbolsStart + WifiPhy::GetPlcpHtTrainingSymbolDuration (preamble,event->GetTxVector ()); //packet start time + preamble + L-SIG + HT-SIG + HT Training
    }
  else
    {
-  plcpHeaderStart = (*j).GetTime () + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble); //packet start time + preamble
+  plcpHeaderStart = previous + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble); //packet start time + preamble
   plcpTrainingSymbolsStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (payloadMode, preamble); //packet start time + preamble + L-SIG
   plcpSigAStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (preamble,event->GetTxVector()); //packet start time + preamble + L-SIG + LTF
   plcpS1gTrainingSymbolsStart = plcpSigAStart + WifiPhy::GetPlcpSigADuration (preamble); //packet start time + preamble + L-SIG + LTF + S1G-A
   plcpSigBStart = plcpS1gTrainingSymbolsStart + WifiPhy::GetPlcpS1gTrainingSymbolDuration (preamble,event->GetTxVector()); //packet start time + preamble + L-SIG + LTF + S1G-A + S1G Training
   plcpPayloadStart = plcpSigBStart + WifiPhy::GetPlcpSigBDuration (preamble); ////packet start time + preamble + L-SIG + LTF + S1G-A + S1G Training + S1G-B
    }
-  double noiseInterferenceW = (*j).GetDelta ();
   double powerW = event->GetRxPowerW ();
-  j++;
-  while (ni->end () != j)
+  while (true)
     {
-      Time current = (*j).GetTime ();
+      //The last chunk ends with the event itself
+      Time current = (j == last) ? event->GetEndTime () : j->GetTime ();
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
       //Case 1: Both previous and current point to the payload
@@ -343,8 +366,13 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event
           NS_LOG_DEBUG ("previous is before payload and current is in the payload: mode=" << payloadMode << ", psr=" << psr);
         }
 
-      noiseInterferenceW += (*j).GetDelta ();
-      previous = (*j).GetTime ();
+      if (j == last)
+        {
+          break;
+        }
+      //The running power includes the signal itself
+      noiseInterferenceW = std::max (j->GetPower () - powerW, 0.0);
+      previous = current;
       j++;
     }
 
@@ -353,12 +381,13 @@ InterferenceHelper::CalculatePlcpPayloadPer (Ptr<const InterferenceHelper::Event
 }
 
 double
-InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event> event, NiChanges *ni) const
+InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event> event, double noiseInterferenceW,
+                                            NiChanges::const_iterator first, NiChanges::const_iterator last) const
 {
   NS_LOG_FUNCTION (this);
   double psr = 1.0; /* Packet Success Rate */
-  NiChanges::iterator j = ni->begin ();
-  Time previous = (*j).GetTime ();
+  NiChanges::const_iterator j = first;
+  Time previous = event->GetStartTime ();
   WifiMode payloadMode = event->GetPayloadMode ();
   WifiPreamble preamble = event->GetPreambleType ();
   WifiMode htHeaderMode;
@@ -379,26 +408,25 @@ InterferenceHelper::CalculatePlcpHeaderPer (Ptr<const InterferenceHelper::Event>
   Time plcpSigBStart;
 if (payloadMode.GetModulationClass () != WIFI_MOD_CLASS_S1G)
  {
-  Time plcpHeaderStart = (*j).GetTime () + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble); //packet start time + preamble
+  Time plcpHeaderStart = previous + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble); //packet start time + preamble
   Time plcpHsigHeaderStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (payloadMode, preamble); //packet start time + preamble + L-SIG
   Time plcpHtTrainingSymbolsStart = plcpHsigHeaderStart + WifiPhy::GetPlcpHtSigHeaderDuration (preamble); //packet start time + preamble + L-SIG + HT-SIG
   Time plcpPayloadStart = plcpHtTrainingSymbolsStart + WifiPhy::GetPlcpHtTrainingSymbolDuration (preamble, event->GetTxVector ()); //packet start time + preamble + L-SIG + HT-SIG + HT Training
  }
 else
  {
-  Time plcpHeaderStart = (*j).GetTime () + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble); //packet start time + preamble
+  Time plcpHeaderStart = previous + WifiPhy::GetPlcpPreambleDuration (payloadMode, preamble); //packet start time + preamble
   Time plcpTrainingSymbolsStart = plcpHeaderStart + WifiPhy::GetPlcpHeaderDuration (payloadMode, preamble); //packet start time + preamble + L-SIG
   Time plcpSigAStart = plcpTrainingSymbolsStart + WifiPhy::GetPlcpTrainingSymbolDuration (preamble,event->GetTxVector()); //packet start time + preamble + L-SIG + LTF
   Time plcpS1gTrainingSymbolsStart = plcpSigAStart + WifiPhy::GetPlcpSigADuration (preamble); //packet start time + preamble + L-SIG + LTF + S1G-A
   Time plcpSigBStart = plcpS1gTrainingSymbolsStart + WifiPhy::GetPlcpS1gTrainingSymbolDuration (preamble,event->GetTxVector()); //packet start time + preamble + L-SIG + LTF + S1G-A + S1G Training
   Time plcpPayloadStart = plcpSigBStart + WifiPhy::GetPlcpSigBDuration (preamble); ////packet start time + preamble + L-SIG + LTF + S1G-A + S1G Training + S1G-B
  }
-  double noiseInterferenceW = (*j).GetDelta ();
   double powerW = event->GetRxPowerW ();
-  j++;
-  while (ni->end () != j)
+  while (true)
     {
-      Time current = (*j).GetTime ();
+      //The last chunk ends with the event itself
+      Time current = (j == last) ? event->GetEndTime () : j->GetTime ();
       NS_LOG_DEBUG ("previous= " << previous << ", current=" << current);
       NS_ASSERT (current >= previous);
    if (payloadMode.GetModulationClass () != WIFI_MOD_CLASS_S1G)
@@ -677,8 +705,13 @@ else
          }
       }      
 
-      noiseInterferenceW += (*j).GetDelta ();
-      previous = (*j).GetTime ();
+      if (j == last)
+        {
+          break;
+        }
+      //The running power includes the signal itself
+      noiseInterferenceW = std::max (j->GetPower () - powerW, 0.0);
+      previous = current;
       j++;
     }
 
@@ -689,8 +722,8 @@ else
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> event)
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  NiChanges::const_iterator first, last;
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &first, &last);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              event->GetPayloadMode ());
@@ -698,7 +731,7 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> e
   /* calculate the SNIR at the start of the packet and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpPayloadPer (event, &ni);
+  double per = CalculatePlcpPayloadPer (event, noiseInterferenceW, first, last);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -709,8 +742,8 @@ InterferenceHelper::CalculatePlcpPayloadSnrPer (Ptr<InterferenceHelper::Event> e
 struct InterferenceHelper::SnrPer
 InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> event)
 {
-  NiChanges ni;
-  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &ni);
+  NiChanges::const_iterator first, last;
+  double noiseInterferenceW = CalculateNoiseInterferenceW (event, &first, &last);
   double snr = CalculateSnr (event->GetRxPowerW (),
                              noiseInterferenceW,
                              WifiPhy::GetPlcpHeaderMode (event->GetPayloadMode (), event->GetPreambleType ()));
@@ -718,7 +751,7 @@ InterferenceHelper::CalculatePlcpHeaderSnrPer (Ptr<InterferenceHelper::Event> ev
   /* calculate the SNIR at the start of the plcp header and accumulate
    * all SNIR changes in the snir vector.
    */
-  double per = CalculatePlcpHeaderPer (event, &ni);
+  double per = CalculatePlcpHeaderPer (event, noiseInterferenceW, first, last);
 
   struct SnrPer snrPer;
   snrPer.snr = snr;
@@ -743,7 +776,22 @@ InterferenceHelper::GetPosition (Time moment)
 void
 InterferenceHelper::AddNiChangeEvent (NiChange change)
 {
-  m_niChanges.insert (GetPosition (change.GetTime ()), change);
+  NiChanges::iterator i = m_niChanges.insert (GetPosition (change.GetTime ()), change);
+  i->SetPower ((i == m_niChanges.begin () ? m_firstPower : (i - 1)->GetPower ()) + change.GetDelta ());
+  for (i++; i != m_niChanges.end (); i++)
+    {
+      i->SetPower (i->GetPower () + change.GetDelta ());
+    }
+}
+
+void
+InterferenceHelper::EraseNiChanges (NiChanges::iterator end)
+{
+  if (end != m_niChanges.begin ())
+    {
+      m_firstPower = (end - 1)->GetPower ();
+      m_niChanges.erase (m_niChanges.begin (), end);
+    }
 }
 
 void
@@ -758,6 +806,7 @@ InterferenceHelper::NotifyRxEnd ()
 {
   NS_LOG_FUNCTION (this);
   m_rxing = false;
+  EraseNiChanges (std::lower_bound (m_niChanges.begin (), m_niChanges.end (), NiChange (Simulator::Now (), 0)));
 }
 
 } //namespace ns3
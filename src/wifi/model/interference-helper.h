@@ -22,7 +22,7 @@
 #define INTERFERENCE_HELPER_H
 
 #include <stdint.h>
-#include <vector>
+#include <deque>
 #include <list>
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
@@ -243,6 +243,20 @@ public:
      * \return the power
      */
     double GetDelta (void) const;
+    /**
+     * Return the total noise and interference power on the medium
+     * right after this change has been applied.
+     *
+     * \return the power (W)
+     */
+    double GetPower (void) const;
+    /**
+     * Set the total noise and interference power on the medium
+     * right after this change has been applied.
+     *
+     * \param power the power (W)
+     */
+    void SetPower (double power);
     /**
      * Compare the event time of two NiChange objects (a < o).
      *
@@ -255,11 +269,13 @@ public:
 private:
     Time m_time;
     double m_delta;
+    double m_power;
   };
   /**
-   * typedef for a vector of NiChanges
+   * typedef for the time-ordered timeline of NiChanges. A deque is used
+   * so that stale changes can be popped from the front in constant time.
    */
-  typedef std::vector <NiChange> NiChanges;
+  typedef std::deque <NiChange> NiChanges;
   /**
    * typedef for a list of Events
    */
@@ -272,14 +288,17 @@ private:
    */
   void AppendEvent (Ptr<Event> event);
   /**
-   * Calculate noise and interference power in W.
+   * Calculate noise and interference power in W at the start of the given
+   * event, and locate the part of the timeline covering the event.
    *
    * \param event
-   * \param ni
+   * \param first set to the first change following the start of the event
+   * \param last set to the change marking the end of the event
    *
    * \return noise and interference power
    */
-  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges *ni) const;
+  double CalculateNoiseInterferenceW (Ptr<Event> event, NiChanges::const_iterator *first,
+                                      NiChanges::const_iterator *last) const;
   /**
    * Calculate SNR (linear ratio) from the given signal power and noise+interference power.
    * (Mode is not currently used)
@@ -307,36 +326,50 @@ private:
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param noiseInterferenceW noise and interference power at the start of the event
+   * \param first the first change following the start of the event
+   * \param last the change marking the end of the event
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpPayloadPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpPayloadPer (Ptr<const Event> event, double noiseInterferenceW,
+                                  NiChanges::const_iterator first, NiChanges::const_iterator last) const;
   /**
    * Calculate the error rate of the plcp header. The plcp header can be divided into
    * multiple chunks (e.g. due to interference from other transmissions).
    *
    * \param event
-   * \param ni
+   * \param noiseInterferenceW noise and interference power at the start of the event
+   * \param first the first change following the start of the event
+   * \param last the change marking the end of the event
    *
    * \return the error rate of the packet
    */
-  double CalculatePlcpHeaderPer (Ptr<const Event> event, NiChanges *ni) const;
+  double CalculatePlcpHeaderPer (Ptr<const Event> event, double noiseInterferenceW,
+                                 NiChanges::const_iterator first, NiChanges::const_iterator last) const;
 
   double m_noiseFigure; /**< noise figure (linear) */
   Ptr<ErrorRateModel> m_errorRateModel;
   /// Experimental: needed for energy duration calculation
   NiChanges m_niChanges;
-  double m_firstPower;
+  double m_firstPower; /**< power on the medium before the first change in m_niChanges */
   bool m_rxing;
   /// Returns an iterator to the first nichange, which is later than moment
   NiChanges::iterator GetPosition (Time moment);
   /**
-   * Add NiChange to the list at the appropriate position.
+   * Add NiChange to the list at the appropriate position, and update the
+   * running power of all the changes which follow it.
    *
    * \param change
    */
   void AddNiChangeEvent (NiChange change);
+  /**
+   * Drop all the changes preceding the given position, folding their
+   * power into m_firstPower.
+   *
+   * \param end the first change to keep
+   */
+  void EraseNiChanges (NiChanges::iterator end);
 };
 
 } //namespace ns3
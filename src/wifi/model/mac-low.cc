@@ -537,6 +537,13 @@ MacLow::SetPhy (Ptr<WifiPhy> phy)
   m_phy->SetReceiveOkCallback (MakeCallback (&MacLow::DeaggregateAmpduAndReceive, this));
   m_phy->SetReceiveErrorCallback (MakeCallback (&MacLow::ReceiveError, this));
   SetupPhyMacLowListener (phy);
+  //control frame durations are needed for every frame exchange
+  m_phy->PrecomputeTxDuration (GetAckSize ());
+  m_phy->PrecomputeTxDuration (GetCtsSize ());
+  m_phy->PrecomputeTxDuration (GetRtsSize ());
+  m_phy->PrecomputeTxDuration (GetPspollSize ());
+  m_phy->PrecomputeTxDuration (GetBlockAckSize (BASIC_BLOCK_ACK));
+  m_phy->PrecomputeTxDuration (GetBlockAckSize (COMPRESSED_BLOCK_ACK));
 }
 
 Ptr<WifiPhy>
@@ -116,7 +116,6 @@ pageSlice::SetPageBitmap (uint32_t control)
   m_PageSliceControl = this->GetPageindex()  | ((m_PageSliceLen & 0x1f ) << 2 )| ( (m_PageSliceCount & 0x1f) << 7 )
          | ((m_BlockOffset & 0x1f )<< 12 ) | ( (m_TIMOffset & 0x0f) << 17 );
   
-  m_PageBitmap = m_PageBitmaparry;
   //printf("     ---pageSlice::SetPageBitmap -- m_PageBitmap = %x\n", *m_PageBitmap);
   //printf("     ---pageSlice::SetPageBitmap -- m_length = %d\n", m_length);
 
@@ -168,7 +167,8 @@ pageSlice::GetTIMOffset (void) const
 uint8_t *
 pageSlice::GetPageBitmap (void) const
 {
-  return m_PageBitmap;
+  //the bitmap is owned by the element, so that copies of the element do not refer to each other
+  return const_cast<uint8_t *> (m_PageBitmaparry);
 }
 
 uint8_t
@@ -222,7 +222,6 @@ pageSlice::DeserializeInformationField (Buffer::Iterator start, uint8_t length)
   m_PageSliceControl_m = start.ReadU8 ();
   m_PageSliceControl_h = start.ReadU8 ();
   start.Read (m_PageBitmaparry, length - 4);
-  m_PageBitmap = m_PageBitmaparry;
   
   m_PageSliceControl = (uint32_t)m_PageSliceControl_l | (uint32_t)m_PageSliceControl_m << 8 | (uint32_t) m_PageSliceControl_h << 16;
 
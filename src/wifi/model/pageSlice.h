@@ -88,7 +88,6 @@ private:
   uint8_t m_TIMOffset;
   
   uint8_t m_PageBitmaparry[4];
-  uint8_t * m_PageBitmap;
   
 };
 
@@ -30,6 +30,7 @@ RandomStream::~RandomStream ()
 
 
 RealRandomStream::RealRandomStream ()
+  : m_next (N_VALUES)
 {
   m_stream = CreateObject<UniformRandomVariable> ();
 }
@@ -37,13 +38,25 @@ RealRandomStream::RealRandomStream ()
 uint32_t
 RealRandomStream::GetNext (uint32_t min, uint32_t max)
 {
-  return m_stream->GetInteger (min, max);
+  NS_ASSERT (min <= max);
+  if (m_next == N_VALUES)
+    {
+      m_stream->GetValues (m_values, N_VALUES, 0.0, 1.0);
+      m_next = 0;
+    }
+  //same value as m_stream->GetInteger (min, max), m_stream being private
+  //and not antithetic
+  double low = min;
+  double high = static_cast<double> (max) + 1.0;
+  return static_cast<uint32_t> (low + m_values[m_next++] * (high - low));
 }
 
 int64_t
 RealRandomStream::AssignStreams (int64_t stream)
 {
   m_stream->SetStream (stream);
+  //the values left were drawn from the previous stream
+  m_next = N_VALUES;
   return 1;
 }
 
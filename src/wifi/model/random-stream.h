@@ -77,8 +77,15 @@ public:
 
 
 private:
+  /// The number of values drawn at once from m_stream.
+  static const uint32_t N_VALUES = 64;
+
   /// Provides uniform random variables.
   Ptr<UniformRandomVariable> m_stream;
+  /// Values of [0, 1) drawn in advance, in the order of m_stream.
+  double m_values[N_VALUES];
+  /// The next value of m_values to use, N_VALUES when all are used.
+  uint32_t m_next;
 };
 
 
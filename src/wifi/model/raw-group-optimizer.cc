@@ -0,0 +1,333 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <algorithm>
+#include "raw-group-optimizer.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RawGroupOptimizer");
+
+/// Fixed part of the duration of a RAW slot (us), see 802.11ah D5.0 9.19.4a.4
+static const uint64_t RAW_SLOT_BASE_DURATION = 500;
+/// Duration of a unit of the slot duration count (us)
+static const uint64_t RAW_SLOT_COUNT_UNIT = 120;
+/// Largest slot duration count used by the simulation scripts (11 bit format)
+static const uint16_t RAW_SLOT_MAX_COUNT = 2037;
+/// Largest number of RAW assignments fitting in a RPS element
+static const uint16_t RPS_MAX_GROUPS = 255 / 6;
+/// Number of bisection steps of the load threshold in Partition
+static const uint32_t PARTITION_ITERATIONS = 50;
+
+RawGroupOptimizer::RawGroupOptimizer ()
+  : m_beaconInterval (102400),
+    m_beaconOverhead (2200),
+    m_groupOverhead (160),
+    m_txDuration (2000),
+    m_slotTime (52),
+    m_cwMin (15),
+    m_maxGroups (32),
+    m_page (0),
+    m_nGroups (0),
+    m_expectedSuccesses (0.0)
+{
+}
+
+RawGroupOptimizer::~RawGroupOptimizer ()
+{
+}
+
+void
+RawGroupOptimizer::SetBeaconInterval (uint64_t beaconInterval)
+{
+  m_beaconInterval = beaconInterval;
+}
+
+void
+RawGroupOptimizer::SetBeaconOverhead (uint64_t overhead, uint64_t perGroupOverhead)
+{
+  m_beaconOverhead = overhead;
+  m_groupOverhead = perGroupOverhead;
+}
+
+void
+RawGroupOptimizer::SetTransmissionDuration (uint64_t duration)
+{
+  NS_ASSERT (duration > 0);
+  m_txDuration = duration;
+}
+
+void
+RawGroupOptimizer::SetContention (uint64_t slotTime, uint32_t cwMin)
+{
+  m_slotTime = slotTime;
+  m_cwMin = cwMin;
+}
+
+void
+RawGroupOptimizer::SetMaxGroups (uint16_t maxGroups)
+{
+  NS_ASSERT (maxGroups > 0 && maxGroups <= RPS_MAX_GROUPS);
+  m_maxGroups = maxGroups;
+}
+
+void
+RawGroupOptimizer::SetPage (uint8_t page)
+{
+  NS_ASSERT (page < 4);
+  m_page = page;
+}
+
+void
+RawGroupOptimizer::AddStation (uint16_t aid, double load)
+{
+  NS_ASSERT (load >= 0.0);
+  Station sta;
+  sta.aid = aid;
+  sta.load = load;
+  m_stations.push_back (sta);
+}
+
+void
+RawGroupOptimizer::Clear (void)
+{
+  m_stations.clear ();
+}
+
+uint16_t
+RawGroupOptimizer::GetNGroups (void) const
+{
+  return m_nGroups;
+}
+
+double
+RawGroupOptimizer::GetExpectedSuccesses (void) const
+{
+  return m_expectedSuccesses;
+}
+
+double
+RawGroupOptimizer::GetSlotSuccesses (double load, double active, uint64_t slotDuration,
+                                     uint64_t txDuration, uint64_t slotTime, uint32_t cwMin)
+{
+  if (load <= 0.0)
+    {
+      return 0.0;
+    }
+  //Bianchi-like model: every backoff slot, each active station transmits
+  //with probability tau; a backoff slot is idle, a success or a collision
+  double n = std::max (active, 1.0);
+  double tau = 2.0 / (cwMin + 1);
+  double pIdle = std::pow (1.0 - tau, n);
+  double pSuccess = n * tau * std::pow (1.0 - tau, n - 1.0);
+  double meanDuration = pIdle * slotTime + (1.0 - pIdle) * txDuration;
+  double successes = slotDuration * pSuccess / meanDuration;
+  return std::min (load, successes);
+}
+
+void
+RawGroupOptimizer::Partition (uint16_t nGroups, std::vector<uint32_t> &ends) const
+{
+  uint32_t n = m_stations.size ();
+  //smallest threshold such that the greedy split needs at most nGroups ranges
+  double low = 0.0;
+  double high = m_prefixLoad[n];
+  for (uint32_t i = 0; i < n; i++)
+    {
+      low = std::max (low, m_stations[i].load);
+    }
+  for (uint32_t iteration = 0; iteration < PARTITION_ITERATIONS && high > low; iteration++)
+    {
+      double threshold = (low + high) / 2;
+      uint32_t ranges = 1;
+      double sum = 0.0;
+      for (uint32_t i = 0; i < n; i++)
+        {
+          if (sum + m_stations[i].load > threshold)
+            {
+              ranges++;
+              sum = 0.0;
+            }
+          sum += m_stations[i].load;
+        }
+      if (ranges <= nGroups)
+        {
+          high = threshold;
+        }
+      else
+        {
+          low = threshold;
+        }
+    }
+  ends.clear ();
+  double sum = 0.0;
+  for (uint32_t i = 0; i < n; i++)
+    {
+      if (i > 0 && sum + m_stations[i].load > high)
+        {
+          ends.push_back (i);
+          sum = 0.0;
+        }
+      sum += m_stations[i].load;
+    }
+  ends.push_back (n);
+  //split the most populated ranges until there are nGroups of them,
+  //since fewer stations per group means less contention
+  while (ends.size () < nGroups)
+    {
+      uint32_t largest = 0;
+      uint32_t largestSize = 0;
+      for (uint32_t g = 0; g < ends.size (); g++)
+        {
+          uint32_t size = ends[g] - (g == 0 ? 0 : ends[g - 1]);
+          if (size > largestSize)
+            {
+              largest = g;
+              largestSize = size;
+            }
+        }
+      if (largestSize < 2)
+        {
+          break;
+        }
+      uint32_t start = (largest == 0 ? 0 : ends[largest - 1]);
+      ends.insert (ends.begin () + largest, start + largestSize / 2);
+    }
+}
+
+double
+RawGroupOptimizer::Evaluate (const std::vector<uint32_t> &ends, std::vector<uint16_t> &counts) const
+{
+  uint32_t nGroups = ends.size ();
+  uint64_t overhead = m_beaconOverhead + nGroups * m_groupOverhead;
+  if (m_beaconInterval <= overhead + nGroups * RAW_SLOT_BASE_DURATION)
+    {
+      return -1.0;
+    }
+  double available = m_beaconInterval - overhead;
+  double totalLoad = m_prefixLoad.back ();
+  double successes = 0.0;
+  counts.clear ();
+  for (uint32_t g = 0; g < nGroups; g++)
+    {
+      uint32_t start = (g == 0 ? 0 : ends[g - 1]);
+      double load = m_prefixLoad[ends[g]] - m_prefixLoad[start];
+      double active = m_prefixActive[ends[g]] - m_prefixActive[start];
+      double share = totalLoad > 0.0 ? available * load / totalLoad : available / nGroups;
+      double count = std::floor ((share - RAW_SLOT_BASE_DURATION) / RAW_SLOT_COUNT_UNIT);
+      count = std::min (std::max (count, 0.0), static_cast<double> (RAW_SLOT_MAX_COUNT));
+      counts.push_back (static_cast<uint16_t> (count));
+      uint64_t duration = RAW_SLOT_BASE_DURATION + counts.back () * RAW_SLOT_COUNT_UNIT;
+      successes += GetSlotSuccesses (load, active, duration, m_txDuration, m_slotTime, m_cwMin);
+    }
+  return successes;
+}
+
+RPSVector
+RawGroupOptimizer::Optimize (void)
+{
+  NS_LOG_FUNCTION (this << m_stations.size ());
+  RPSVector rpsv;
+  m_nGroups = 0;
+  m_expectedSuccesses = 0.0;
+  if (m_stations.empty ())
+    {
+      return rpsv;
+    }
+  std::sort (m_stations.begin (), m_stations.end ());
+  m_prefixLoad.assign (1, 0.0);
+  m_prefixActive.assign (1, 0.0);
+  for (std::vector<Station>::const_iterator i = m_stations.begin (); i != m_stations.end (); i++)
+    {
+      m_prefixLoad.push_back (m_prefixLoad.back () + i->load);
+      //probability to have at least one packet, Poisson arrivals
+      m_prefixActive.push_back (m_prefixActive.back () + 1.0 - std::exp (-i->load));
+    }
+
+  std::vector<uint32_t> ends;
+  std::vector<uint16_t> counts;
+  std::vector<uint32_t> bestEnds;
+  std::vector<uint16_t> bestCounts;
+  double best = -1.0;
+  uint32_t maxGroups = std::min<uint32_t> (m_maxGroups, m_stations.size ());
+  for (uint16_t nGroups = 1; nGroups <= maxGroups; nGroups++)
+    {
+      Partition (nGroups, ends);
+      double successes = Evaluate (ends, counts);
+      NS_LOG_DEBUG (nGroups << " groups: " << successes << " packets per beacon");
+      //strictly better only, to favour fewer groups
+      if (successes > best)
+        {
+          best = successes;
+          bestEnds = ends;
+          bestCounts = counts;
+        }
+    }
+  if (best < 0.0)
+    {
+      NS_LOG_WARN ("beacon interval too short for any RAW group");
+      return rpsv;
+    }
+
+  //owned by the caller
+  RPS *rps = new RPS;
+  for (uint32_t g = 0; g < bestEnds.size (); g++)
+    {
+      uint32_t start = (g == 0 ? 0 : bestEnds[g - 1]);
+      uint32_t aidStart = m_stations[start].aid;
+      //the groups cover all the AIDs up to the first station of the next one
+      uint32_t aidEnd = (g + 1 < bestEnds.size ()) ? m_stations[bestEnds[g]].aid - 1 : m_stations.back ().aid;
+      RPS::RawAssignment raw;
+      raw.SetRawControl (0);
+      raw.SetSlotCrossBoundary (1);
+      raw.SetSlotFormat (1);
+      raw.SetSlotDurationCount (bestCounts[g]);
+      raw.SetSlotNum (1);
+      raw.SetRawGroup ((aidEnd << 13) | (aidStart << 2) | m_page);
+      rps->SetRawAssignment (raw);
+    }
+  rpsv.rpsset.push_back (rps);
+  m_nGroups = bestEnds.size ();
+  m_expectedSuccesses = best;
+  return rpsv;
+}
+
+void
+RawGroupOptimizer::PrintRawConfig (std::ostream &os, const RPSVector &rpsv)
+{
+  os << rpsv.rpsset.size () << "\n";
+  for (RPSVector::RPSlist::const_iterator i = rpsv.rpsset.begin (); i != rpsv.rpsset.end (); i++)
+    {
+      os << static_cast<uint32_t> ((*i)->GetNumberOfRawGroups ()) << "\n";
+      for (uint32_t j = 0; j < (*i)->GetNumberOfRawGroups (); j++)
+        {
+          RPS::RawAssignment raw = (*i)->GetRawAssigmentObj (j);
+          os << static_cast<uint32_t> (raw.GetRawTypeIndex ()) << "\t"
+             << static_cast<uint32_t> (raw.GetSlotCrossBoundary ()) << "\t"
+             << static_cast<uint32_t> (raw.GetSlotFormat ()) << "\t"
+             << raw.GetSlotDurationCount () << "\t"
+             << raw.GetSlotNum () << "\t"
+             << static_cast<uint32_t> (raw.GetRawGroupPage ()) << "\t"
+             << raw.GetRawGroupAIDStart () << "\t"
+             << raw.GetRawGroupAIDEnd () << "\t" << "\n";
+        }
+    }
+}
+
+} //namespace ns3
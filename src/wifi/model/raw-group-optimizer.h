@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RAW_GROUP_OPTIMIZER_H
+#define RAW_GROUP_OPTIMIZER_H
+
+#include <stdint.h>
+#include <vector>
+#include <ostream>
+#include "rps.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * Computes a RAW grouping for a set of stations from estimates of their
+ * traffic, without running any simulation.
+ *
+ * Every station is described by its AID and the number of packets it is
+ * expected to send per beacon interval (e.g. derived from
+ * Sensor::EstimateTransmissionInterval). For every candidate number of RAW
+ * groups, the stations are split in contiguous AID ranges with balanced
+ * load, the beacon interval (minus the beacon overhead) is shared among the
+ * groups in proportion to their load, and the expected number of delivered
+ * packets is evaluated with an analytical contention model (see
+ * GetSlotSuccesses). The grouping which delivers the most packets is
+ * returned as a single RPS.
+ *
+ * The whole search is O(G * N * log) for N stations and at most G groups.
+ * It is used as an offline pre-pass by the RAW-generate script, which
+ * writes the resulting RAW configuration file; the AP does not run it
+ * online.
+ */
+class RawGroupOptimizer
+{
+public:
+  RawGroupOptimizer ();
+  ~RawGroupOptimizer ();
+
+  /**
+   * \param beaconInterval the beacon interval (us)
+   */
+  void SetBeaconInterval (uint64_t beaconInterval);
+  /**
+   * \param overhead the airtime of a beacon without RAW assignments (us)
+   * \param perGroupOverhead the airtime added by every RAW assignment (us)
+   */
+  void SetBeaconOverhead (uint64_t overhead, uint64_t perGroupOverhead);
+  /**
+   * \param duration the duration of a frame exchange (DATA, SIFS, ACK and DIFS) (us)
+   */
+  void SetTransmissionDuration (uint64_t duration);
+  /**
+   * \param slotTime the backoff slot time (us)
+   * \param cwMin the minimum contention window
+   */
+  void SetContention (uint64_t slotTime, uint32_t cwMin);
+  /**
+   * \param maxGroups the maximum number of RAW groups to consider (at most 42,
+   *        the number of RAW assignments fitting in a RPS element)
+   */
+  void SetMaxGroups (uint16_t maxGroups);
+  /**
+   * \param page the page of the AIDs of the stations
+   */
+  void SetPage (uint8_t page);
+
+  /**
+   * Add a station to the set of stations to group.
+   *
+   * \param aid the AID of the station
+   * \param load the expected number of packets sent per beacon interval
+   */
+  void AddStation (uint16_t aid, double load);
+  /**
+   * Remove all the stations.
+   */
+  void Clear (void);
+
+  /**
+   * Compute the grouping of the stations added so far.
+   *
+   * \return a RPSVector holding a single RPS with one RAW assignment per
+   *         group, or no RPS if there is no station to group or no room
+   *         for a RAW in the beacon interval. As for the other RPSVector
+   *         instances, the RPS is allocated with new and is owned by the
+   *         caller, which must delete it.
+   */
+  RPSVector Optimize (void);
+  /**
+   * \return the number of groups of the last grouping computed by Optimize
+   */
+  uint16_t GetNGroups (void) const;
+  /**
+   * \return the expected number of packets delivered per beacon interval
+   *         with the last grouping computed by Optimize
+   */
+  double GetExpectedSuccesses (void) const;
+
+  /**
+   * Analytical contention model of a RAW slot. The stations with a packet
+   * contend with a transmission probability of 2/(cwMin+1) per backoff slot;
+   * an attempt succeeds if no other active station transmits in the same
+   * backoff slot. Collided packets are retried within the slot as long as
+   * it lasts.
+   *
+   * \param load the expected number of packets to send in the slot
+   * \param active the expected number of stations with a packet to send
+   * \param slotDuration the duration of the RAW slot (us)
+   * \param txDuration the duration of a frame exchange (us)
+   * \param slotTime the backoff slot time (us)
+   * \param cwMin the minimum contention window
+   *
+   * \return the expected number of packets delivered in the slot
+   */
+  static double GetSlotSuccesses (double load, double active, uint64_t slotDuration,
+                                  uint64_t txDuration, uint64_t slotTime, uint32_t cwMin);
+
+  /**
+   * Print a RPSVector in the format of the RAW configuration files read by
+   * the simulation scripts.
+   *
+   * \param os the output stream
+   * \param rpsv the RAW configuration
+   */
+  static void PrintRawConfig (std::ostream &os, const RPSVector &rpsv);
+
+private:
+  /**
+   * A station to group
+   */
+  struct Station
+  {
+    uint16_t aid;  //!< AID of the station
+    double load;   //!< expected packets per beacon interval
+    bool operator < (const Station &o) const
+    {
+      return aid < o.aid;
+    }
+  };
+
+  /**
+   * Split the (sorted) stations in at most nGroups contiguous ranges
+   * minimizing the largest load of a range.
+   *
+   * \param nGroups the number of ranges
+   * \param ends the index past the last station of each range
+   */
+  void Partition (uint16_t nGroups, std::vector<uint32_t> &ends) const;
+  /**
+   * Share the RAW time among the ranges in proportion to their load.
+   *
+   * \param ends the index past the last station of each range
+   * \param counts the slot duration count of each range
+   *
+   * \return the expected number of delivered packets
+   */
+  double Evaluate (const std::vector<uint32_t> &ends, std::vector<uint16_t> &counts) const;
+
+  std::vector<Station> m_stations; //!< stations to group
+  std::vector<double> m_prefixLoad; //!< cumulated load of the sorted stations
+  std::vector<double> m_prefixActive; //!< cumulated probability of the sorted stations to have a packet
+  uint64_t m_beaconInterval;       //!< beacon interval (us)
+  uint64_t m_beaconOverhead;       //!< beacon airtime without RAW assignments (us)
+  uint64_t m_groupOverhead;        //!< beacon airtime of a RAW assignment (us)
+  uint64_t m_txDuration;           //!< duration of a frame exchange (us)
+  uint64_t m_slotTime;             //!< backoff slot time (us)
+  uint32_t m_cwMin;                //!< minimum contention window
+  uint16_t m_maxGroups;            //!< maximum number of RAW groups
+  uint8_t m_page;                  //!< page of the AIDs
+  uint16_t m_nGroups;              //!< number of groups of the last grouping
+  double m_expectedSuccesses;      //!< score of the last grouping
+};
+
+} //namespace ns3
+
+#endif /* RAW_GROUP_OPTIMIZER_H */
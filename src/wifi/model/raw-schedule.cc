@@ -0,0 +1,146 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <map>
+#include <deque>
+#include "raw-schedule.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RawSchedule");
+
+/// Number of AIDs in a page
+static const uint32_t AIDS_PER_PAGE = 2048;
+/// Number of AIDs in all the pages
+static const uint32_t AIDS = 4 * AIDS_PER_PAGE;
+/// Number of distinct RPS elements whose schedules are kept by RawSchedule::Get
+static const uint32_t MAX_CACHED_SCHEDULES = 256;
+
+/**
+ * The schedules decoded by RawSchedule::Get in a thread
+ */
+struct ScheduleCache
+{
+  /// Schedules by RAW assignments
+  typedef std::map<std::vector<uint8_t>, Ptr<const RawSchedule> > Schedules;
+
+  Schedules schedules;                         //!< the schedules
+  std::deque<Schedules::iterator> order;       //!< the schedules, oldest first
+};
+
+RawSchedule::RawSchedule (const RPS &rps)
+  : m_firstGroup (AIDS_PER_PAGE, NO_GROUP),
+    m_lastGroup (AIDS, NO_GROUP)
+{
+  uint32_t nGroups = rps.GetNumberOfRawGroups ();
+  NS_ASSERT (nGroups < NO_GROUP);
+  uint64_t start = 0;
+  for (uint32_t i = 0; i < nGroups; i++)
+    {
+      RPS::RawAssignment raw = rps.GetRawAssigmentObj (i);
+      Group group;
+      group.aidStart = raw.GetRawGroupAIDStart ();
+      group.aidEnd = raw.GetRawGroupAIDEnd ();
+      group.page = raw.GetRawGroupPage ();
+      group.rawTypeIndex = raw.GetRawTypeIndex ();
+      group.crossBoundary = raw.GetSlotCrossBoundary () == 0x0001;
+      group.slotNum = raw.GetSlotNum ();
+      uint64_t slotDuration = 500 + raw.GetSlotDurationCount () * 120;
+      group.slotDuration = MicroSeconds (slotDuration);
+      group.start = MicroSeconds (start);
+      start += slotDuration * group.slotNum;
+      m_groups.push_back (group);
+
+      for (uint32_t aid = group.aidStart; aid <= group.aidEnd; aid++)
+        {
+          if (m_firstGroup[aid] == NO_GROUP)
+            {
+              m_firstGroup[aid] = i;
+            }
+          m_lastGroup[(group.page * AIDS_PER_PAGE) | aid] = i;
+        }
+    }
+  m_duration = MicroSeconds (start);
+}
+
+Ptr<const RawSchedule>
+RawSchedule::Get (const RPS &rps)
+{
+  // per thread, as the stations of different logical processes decode
+  // their beacons concurrently
+  static thread_local ScheduleCache threadCache;
+  ScheduleCache *cache = &threadCache;
+
+  std::vector<uint8_t> key;
+  if (rps.GetInformationFieldSize () > 0)
+    {
+      const uint8_t *bytes = rps.GetRawAssignment ();
+      key.assign (bytes, bytes + rps.GetInformationFieldSize ());
+    }
+  ScheduleCache::Schedules::const_iterator it = cache->schedules.find (key);
+  if (it != cache->schedules.end ())
+    {
+      return it->second;
+    }
+  if (cache->schedules.size () >= MAX_CACHED_SCHEDULES)
+    {
+      cache->schedules.erase (cache->order.front ());
+      cache->order.pop_front ();
+    }
+  NS_LOG_DEBUG ("decode RPS of " << rps.GetNumberOfRawGroups () << " RAW groups");
+  Ptr<const RawSchedule> schedule = Create<RawSchedule> (rps);
+  cache->order.push_back (cache->schedules.insert (std::make_pair (key, schedule)).first);
+  return schedule;
+}
+
+uint32_t
+RawSchedule::GetNGroups (void) const
+{
+  return m_groups.size ();
+}
+
+const RawSchedule::Group &
+RawSchedule::GetGroup (uint32_t index) const
+{
+  NS_ASSERT (index < m_groups.size ());
+  return m_groups[index];
+}
+
+Time
+RawSchedule::GetDuration (void) const
+{
+  return m_duration;
+}
+
+uint8_t
+RawSchedule::GetFirstGroup (uint16_t aid) const
+{
+  if (aid >= AIDS_PER_PAGE)
+    {
+      return NO_GROUP;
+    }
+  return m_firstGroup[aid];
+}
+
+uint8_t
+RawSchedule::GetLastGroupInPage (uint16_t aid) const
+{
+  return m_lastGroup[aid % AIDS];
+}
+
+} //namespace ns3
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef RAW_SCHEDULE_H
+#define RAW_SCHEDULE_H
+
+#include <stdint.h>
+#include <vector>
+#include "ns3/simple-ref-count.h"
+#include "ns3/nstime.h"
+#include "ns3/ptr.h"
+#include "rps.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * The RAW groups of a RPS element, decoded once into flat arrays.
+ *
+ * The RAW assignments are decoded when the schedule is built, together with
+ * the start time of every RAW relative to the end of the beacon, and every
+ * AID is mapped to the RAW group it belongs to. Finding the RAW slot of a
+ * station is then a table lookup instead of a decoding of the RPS bytes.
+ *
+ * Schedules are immutable and shared: during a simulation, RawSchedule::Get
+ * returns the same schedule for all the RPS elements carrying the same
+ * bytes, so that the RPS of a beacon is decoded once for the whole BSS.
+ */
+class RawSchedule : public SimpleRefCount<RawSchedule>
+{
+public:
+  /**
+   * A decoded RAW assignment
+   */
+  struct Group
+  {
+    uint16_t aidStart;    //!< first AID of the RAW group
+    uint16_t aidEnd;      //!< last AID of the RAW group
+    uint8_t page;         //!< page of the RAW group
+    uint8_t rawTypeIndex; //!< RAW type index
+    bool crossBoundary;   //!< whether transmissions may cross slot boundaries
+    uint16_t slotNum;     //!< number of slots of the RAW
+    Time slotDuration;    //!< duration of a slot of the RAW
+    Time start;           //!< start of the RAW, relative to the end of the beacon
+  };
+
+  /// Value returned by the lookups for AIDs which are not in any RAW group
+  static const uint8_t NO_GROUP = 0xff;
+
+  /**
+   * Decode a RPS element.
+   *
+   * \param rps the RPS element
+   */
+  RawSchedule (const RPS &rps);
+
+  /**
+   * \param rps the RPS element
+   *
+   * \return the (shared) schedule of the RPS element, decoded on first use
+   *
+   * The schedules are kept per thread, up to a bound beyond which the
+   * oldest ones are forgotten.
+   */
+  static Ptr<const RawSchedule> Get (const RPS &rps);
+
+  /**
+   * \return the number of RAW groups
+   */
+  uint32_t GetNGroups (void) const;
+  /**
+   * \param index the index of the RAW group
+   *
+   * \return the RAW group
+   */
+  const Group & GetGroup (uint32_t index) const;
+  /**
+   * \return the total duration of the RAWs
+   */
+  Time GetDuration (void) const;
+  /**
+   * \param aid the AID of the station, compared with the AID ranges as is
+   *
+   * \return the index of the first RAW group whose AID range contains the
+   *         AID, or NO_GROUP
+   */
+  uint8_t GetFirstGroup (uint16_t aid) const;
+  /**
+   * \param aid the AID of the station, whose two most significant bits are
+   *        the page of the station
+   *
+   * \return the index of the last RAW group of the page of the station whose
+   *         AID range contains the AID of the station in the page, or NO_GROUP
+   */
+  uint8_t GetLastGroupInPage (uint16_t aid) const;
+
+
+private:
+  std::vector<Group> m_groups;        //!< the RAW groups
+  Time m_duration;                    //!< total duration of the RAWs
+  std::vector<uint8_t> m_firstGroup;  //!< first group of every AID
+  std::vector<uint8_t> m_lastGroup;   //!< last group of every AID, indexed with the page
+};
+
+} //namespace ns3
+
+#endif /* RAW_SCHEDULE_H */
@@ -276,7 +276,6 @@ RPS::SetRawAssignment (RPS::RawAssignment raw)
 	//m_rpsarry.push_back( (uint8_t)(raw.GetPRAW () >> 16));
 	//m_length++;
 
-	m_rps = &m_rpsarry[0];
 	//printf (" set m_rps %x\n" , m_rps[6]);
 
 	/*std::cout << "GetRawControl-----" << (unsigned int)assignment.GetRawControl() << std::endl;
@@ -298,7 +297,8 @@ RPS::GetRawAssignment (void) const
 {
     //printf (" get m_rps addressx\n" , m_rps);
     //printf (" get m_rps %x\n" , m_rps[6]);
-    return m_rps;
+    //the RAW Assignments are owned by the element, so that copies of the element do not refer to each other
+    return m_rpsarry.empty () ? 0 : const_cast<uint8_t *> (&m_rpsarry[0]);
 }
 
 RPS::RawAssignment
@@ -347,15 +347,21 @@ RPS::GetInformationFieldSize () const
 void
 RPS::SerializeInformationField (Buffer::Iterator start) const
 {
-  start.Write (m_rps, m_length);
+  if (m_length > 0)
+    {
+      start.Write (&m_rpsarry[0], m_length);
+    }
 }
 
 uint8_t
 RPS::DeserializeInformationField (Buffer::Iterator start, uint8_t length)
 {
   //static uint8_t m_rpsarry[12];
-  start.Read (m_rpsarry_temp, length);
-  m_rps = m_rpsarry_temp;
+  m_rpsarry.resize (length);
+  if (length > 0)
+    {
+      start.Read (&m_rpsarry[0], length);
+    }
   m_length = length;
   return length;
 }
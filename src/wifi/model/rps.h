@@ -127,10 +127,8 @@ public:
   uint8_t m_length;
 private:
   RPS::RawAssignment assignment; //!< RawAssignment subfield
-  uint8_t * m_rps; //! Support up to 10 RAW Assignment subfield
   //uint8_t m_rpsarry[12];
-    uint8_t m_rpsarry_temp[1200];
-  std::vector<uint8_t> m_rpsarry;
+  std::vector<uint8_t> m_rpsarry; //!< the RAW Assignments, as serialized
   
   //uint8_t m_length; //!< Total length of all RAW Assignments
 };
@@ -279,6 +279,7 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
             }
             //
             m_stations.push_back (m_sta); // should create a Dispose function?
+            m_stationIndex[*ci] = m_sta;
             //
             APId.clear ();
             APId.str ("");
@@ -294,31 +295,34 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
         }
     }
 
+    AidBitmap sensors;
+    for (std::vector<uint16_t>::iterator ci = m_sensorlist.begin(); ci != m_sensorlist.end(); ci++)
+    {
+        sensors.Set (*ci);
+    }
+
     bool disassoc;
     //for (StationsCI it = m_stations.begin(); it != m_stations.end(); it++)
     StationsCI itcheck = m_stations.begin();
     for (uint16_t i = 0; i < m_stations.size(); i++)
 
     {
-        disassoc = true;
-        for (std::vector<uint16_t>::iterator ci = m_sensorlist.begin(); ci != m_sensorlist.end(); ci++)
+        disassoc = !sensors.IsSet ((*itcheck)->GetAid ());
+        if (!disassoc && i < m_stations.size() - 1)
         {
-            if ((*itcheck)->GetAid ()  == *ci)
-             {
-                 disassoc = false;
-                 if (i < m_stations.size() - 1)
-                     itcheck++;  //avoid itcheck increase to m_sensorlist.end()
-                 break;
-             }
+            itcheck++;  //avoid itcheck increase to m_sensorlist.end()
         }
 
       if (disassoc == true)
         {
             NS_LOG_UNCOND ( "Aid " << (*itcheck)->GetAid () << " erased from m_stations since disassociated");
+            m_stationIndex.erase ((*itcheck)->GetAid ());
             m_stations.erase(itcheck);
         }
     }
 
+    ReceivedCount received = CountReceived (m_receivedAid);
+
 
 
     NS_LOG_UNCOND ("m_aidList.size() = " << m_aidList.size() << ", m_receivedAid = " << m_receivedAid.size () << ", m_stations.size() = " << m_stations.size() << ", currentId = " << currentId);
@@ -333,10 +337,7 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
          }
 
          m_receivedsuccess = false;
-         for (std::vector<uint16_t>::iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
-         {
-
-             if (*ci == *it)
+         if (received.find (*it) != received.end ())
               {
                 //NS_LOG_UNCOND ("stations of aid " << *it << " received");
                 stationTransmit->SetTransmissionSuccess (true);
@@ -381,7 +382,6 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
 
                 goto EstimateInterval;
               }
-         }
 
 
             //NS_LOG_UNCOND ("stations of aid " << *it << " not received");
@@ -414,22 +414,27 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
          uint16_t add=0;
      }
 
+    //the estimation itself is a separate pass over the sensors
+    std::vector<Sensor *> estimated;
+    AidBitmap listed;
     for (std::vector<uint16_t>::iterator it = m_aidList.begin(); it != m_aidList.end(); it++)
      {
         Sensor * stationTransmit = LookupSensorSta (*it);
         if (stationTransmit == nullptr)
           {
+            EstimateTransmissionIntervals (estimated, received);
             return;
           }
-
-        uint16_t m_numReceived = 0;
-        for (std::vector<uint16_t>::iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
+        if (listed.IsSet (*it))
           {
-            if (*ci == *it)
-             {
-                m_numReceived++;
-             }
+            //a sensor listed twice is estimated twice, in order
+            EstimateTransmissionIntervals (estimated, received);
+            estimated.clear ();
           }
+        listed.Set (*it);
+
+        ReceivedCount::const_iterator count = received.find (*it);
+        uint16_t m_numReceived = count == received.end () ? 0 : count->second;
 
         //NS_LOG_UNCOND ("stations of aid " << *it << " received " << m_numReceived << " packets");
 
@@ -443,27 +448,20 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
          outputfile << currentId << "\t" << "1" << "\t" << m_numReceived << "\t" << stationTransmit->GetTransInOneBeacon () << "\n";
          outputfile.close();
 
-         stationTransmit->SetNumPacketsReceived (m_numReceived);
-         stationTransmit->EstimateTransmissionInterval (currentId, m_beaconInterval);
+         estimated.push_back (stationTransmit);
      }
+    EstimateTransmissionIntervals (estimated, received);
+    estimated.clear ();
 
  for (std::vector<uint16_t>::iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
     {
-      uint16_t m_numReceived = 0;
-      bool match = false;
-      for (std::vector<uint16_t>::iterator it = m_aidList.begin(); it != m_aidList.end(); it++)
-         {
-             if (*ci == *it)
-              {
-                match = true;
-                break;
-              }
-         }
+      bool match = listed.IsSet (*ci);
 
         Sensor * stationTransmit = LookupSensorSta (*ci);
     if (stationTransmit != nullptr && !match)
         {
             m_aidList.push_back (*ci); //trick, avoid same receiveAid repeate several times
+            listed.Set (*ci);
              if (stationTransmit->GetEverSuccess () == false)
              {
                  stationTransmit->m_snesorUpdatInfo = (UpdateInfo){currentId-1,currentId-1,currentId-1,false,currentId-1,currentId-1,currentId-1,false};
@@ -487,13 +485,7 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
 
              //NS_LOG_UNCOND ("stations of aid " << *it << " received " << m_numReceived << " packets");
 
-            for (std::vector<uint16_t>::iterator ct = m_receivedAid.begin(); ct != m_receivedAid.end(); ct++)
-            {
-                if (*ci == *ct)
-                {
-                    m_numReceived++;
-                }
-            }
+            uint16_t m_numReceived = received[*ci];
 
              APId.clear ();
              APId.str ("");
@@ -505,13 +497,35 @@ S1gRawCtr::UdpateSensorStaInfo (std::vector<uint16_t> m_sensorlist, std::vector<
              outputfile << currentId << "\t" << "0" << "\t" << m_numReceived << "\t" << stationTransmit->GetTransInOneBeacon () << "\n";
              outputfile.close();
 
-             stationTransmit->SetNumPacketsReceived (m_numReceived);
-             stationTransmit->EstimateTransmissionInterval (currentId, m_beaconInterval);
+             estimated.push_back (stationTransmit);
         }
     }
+    EstimateTransmissionIntervals (estimated, received);
 
 }
 
+S1gRawCtr::ReceivedCount
+S1gRawCtr::CountReceived (const std::vector<uint16_t> &receivedAid)
+{
+  ReceivedCount received;
+  for (std::vector<uint16_t>::const_iterator ci = receivedAid.begin (); ci != receivedAid.end (); ci++)
+    {
+      received[*ci]++;
+    }
+  return received;
+}
+
+void
+S1gRawCtr::EstimateTransmissionIntervals (const std::vector<Sensor *> &sensors, const ReceivedCount &received)
+{
+  for (std::vector<Sensor *>::const_iterator it = sensors.begin (); it != sensors.end (); it++)
+    {
+      ReceivedCount::const_iterator count = received.find ((*it)->GetAid ());
+      (*it)->SetNumPacketsReceived (count == received.end () ? 0 : count->second);
+      (*it)->EstimateTransmissionInterval (currentId, m_beaconInterval);
+    }
+}
+
 void
 Sensor::SetNumPacketsReceived (uint16_t numReceived)
 {
@@ -867,6 +881,7 @@ S1gRawCtr::UdpateOffloadStaInfo (std::vector<uint16_t> m_OffloadList, std::vecto
               m_offloadSta->SetOffloadStaActive (true);
               m_offloadSta->IncreaseFailedTransmissionCount (0);
               m_offloadStations.push_back (m_offloadSta); // should create a Dispose function?
+              m_offloadStationIndex[*ci] = m_offloadSta;
               NS_LOG_UNCOND ("m_offloadStations.size () = " << m_offloadStations.size ());
 
               APId.clear ();
@@ -880,13 +895,12 @@ S1gRawCtr::UdpateOffloadStaInfo (std::vector<uint16_t> m_OffloadList, std::vecto
      }
 
     //update active offload stations' info.
+    ReceivedCount received = CountReceived (m_receivedAid);
     for (std::vector<uint16_t>::iterator it = m_aidOffloadList.begin(); it != m_aidOffloadList.end(); it++)
     {
         OffloadStation * OffloadStaTransmit = LookupOffloadSta (*it);
 
-        for (std::vector<uint16_t>::iterator ci = m_receivedAid.begin(); ci != m_receivedAid.end(); ci++)
-        {
-            if (*ci == *it)
+            if (received.find (*it) != received.end ())
             {
                 //NS_LOG_UNCOND ("stations of aid " << *it << " received, " << *ci);
                 //output to files.
@@ -903,7 +917,6 @@ S1gRawCtr::UdpateOffloadStaInfo (std::vector<uint16_t> m_OffloadList, std::vecto
                 OffloadStaTransmit->IncreaseFailedTransmissionCount (1);
                 goto FailedMax;
             }
-        }
 
         //output to files.
         //NS_LOG_UNCOND ("stations of aid " << *it << " not received");
@@ -1231,13 +1244,11 @@ S1gRawCtr::configureRAW ( )
 Sensor *
 S1gRawCtr::LookupSensorSta (uint16_t aid)
 {
-   for (StationsCI it = m_stations.begin(); it != m_stations.end(); it++)
-   {
-       if (aid == (*it)->GetAid ())
-        {
-           return (*it);
-        }
-   }
+   sgi::hash_map<uint16_t, Sensor *>::const_iterator it = m_stationIndex.find (aid);
+   if (it != m_stationIndex.end ())
+    {
+       return it->second;
+    }
     return nullptr;
 }
 
@@ -1245,12 +1256,10 @@ S1gRawCtr::LookupSensorSta (uint16_t aid)
 OffloadStation *
 S1gRawCtr::LookupOffloadSta (uint16_t aid)
 {
-    for (OffloadStationsCI it = m_offloadStations.begin(); it != m_offloadStations.end(); it++)
+    sgi::hash_map<uint16_t, OffloadStation *>::const_iterator it = m_offloadStationIndex.find (aid);
+    if (it != m_offloadStationIndex.end ())
     {
-        if (aid == (*it)->GetAid ())
-        {
-            return (*it);
-        }
+        return it->second;
     }
     return nullptr;
 }
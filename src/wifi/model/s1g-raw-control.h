@@ -29,6 +29,8 @@
 #include "supported-rates.h"
 #include "ns3/random-variable-stream.h"
 #include "rps.h"
+#include "aid-bitmap.h"
+#include "ns3/sgi-hashmap.h"
 
 namespace ns3 {
     
@@ -181,6 +183,26 @@ public:
   void SetSensorAllowedToSend (void);
   Sensor * LookupSensorSta (uint16_t aid);
   OffloadStation * LookupOffloadSta (uint16_t aid); //can be combined with function LookupSensorSta.
+
+  /// Number of packets received in the last beacon interval, indexed by AID
+  typedef sgi::hash_map<uint16_t, uint16_t> ReceivedCount;
+  /**
+   * \param receivedAid the AID of the sender of every packet received in the last beacon interval
+   *
+   * \return the number of packets received from every station
+   */
+  static ReceivedCount CountReceived (const std::vector<uint16_t> &receivedAid);
+  /**
+   * Estimate the transmission interval of the sensors from the packets
+   * received in the last beacon interval.
+   *
+   * The estimation of a sensor only reads and writes the sensor itself, so
+   * that the result does not depend on the order of the sensors.
+   *
+   * \param sensors the sensors to update
+   * \param received the number of packets received from every station
+   */
+  void EstimateTransmissionIntervals (const std::vector<Sensor *> &sensors, const ReceivedCount &received);
     
   std::vector<uint16_t>::iterator  LookupLastTransmission (uint16_t aid);
   
@@ -188,10 +210,12 @@ public:
     typedef std::vector<Sensor *> Stations;
     typedef std::vector<Sensor *>::iterator StationsCI;
     Stations m_stations;
+    sgi::hash_map<uint16_t, Sensor *> m_stationIndex; //!< m_stations indexed by AID
     
     typedef std::vector<OffloadStation *> OffloadStations;
     typedef std::vector<OffloadStation *>::iterator OffloadStationsCI;
     OffloadStations m_offloadStations;
+    sgi::hash_map<uint16_t, OffloadStation *> m_offloadStationIndex; //!< m_offloadStations indexed by AID
     
     
     uint16_t MaxSlotForSensor;
@@ -34,6 +34,7 @@
 #include "mac-tx-middle.h"
 #include "wifi-mac-header.h"
 #include "extension-headers.h"
+#include "raw-schedule.h"
 #include "msdu-aggregator.h"
 #include "amsdu-subframe-header.h"
 #include "mgt-headers.h"
@@ -370,7 +371,7 @@ StaWifiMac::SendPspollIfnecessary (void)
 		return 0;
 	}
 
-	void StaWifiMac::S1gTIMReceived(S1gBeaconHeader beacon)
+	void StaWifiMac::S1gTIMReceived(const S1gBeaconHeader &beacon)
 	{
 		m_TIM = beacon.GetTIM();
 
@@ -582,7 +583,7 @@ StaWifiMac::SendPspollIfnecessary (void)
 		GoToSleepCurrentTIM(beacon);
 	}
 
-	void StaWifiMac::GoToSleepNextTIM(S1gBeaconHeader beacon) //to do, merge with GoToSleepCurrentTIM
+	void StaWifiMac::GoToSleepNextTIM(const S1gBeaconHeader &beacon) //to do, merge with GoToSleepCurrentTIM
 	{
 		uint8_t BeaconNumForTIM;
 		if (m_selfBlock < m_BlockOffset) //not included in the page slice element
@@ -610,7 +611,7 @@ StaWifiMac::SendPspollIfnecessary (void)
 		//GoToSleep (MicroSeconds (beacon.GetBeaconCompatibility().GetBeaconInterval () * BeaconNumForTIM));
 	}
 
-	void StaWifiMac::GoToSleepCurrentTIM(S1gBeaconHeader beacon)
+	void StaWifiMac::GoToSleepCurrentTIM(const S1gBeaconHeader &beacon)
 	{
 		uint8_t BeaconNumForTIM;
 		if (m_selfBlock < m_BlockOffset) //not included in the page slice element
@@ -665,6 +666,27 @@ void StaWifiMac::GoToSleep (Time sleeptime)
 		}
 	}
 
+	const S1gBeaconHeader & StaWifiMac::DecodeS1gBeacon(Ptr<const Packet> packet)
+	{
+		// the copies of a beacon received by the stations share its uid;
+		// per thread, as the stations of different logical processes
+		// receive them concurrently
+		typedef std::map<uint64_t, S1gBeaconHeader> Beacons;
+		static thread_local Beacons threadBeacons;
+		Beacons *beacons = &threadBeacons;
+		Beacons::iterator it = beacons->find(packet->GetUid());
+		if (it == beacons->end())
+		{
+			if (beacons->size() >= MAX_DECODED_BEACONS)
+			{
+				beacons->erase(beacons->begin());
+			}
+			it = beacons->insert(std::make_pair(packet->GetUid(), S1gBeaconHeader())).first;
+			packet->PeekHeader(it->second);
+		}
+		return it->second;
+	}
+
 	void StaWifiMac::WakeUp(void)
 	{
 		if (m_low->GetPhy()->IsStateSleep())
@@ -1277,7 +1299,7 @@ StaWifiMac::Enqueue (Ptr<const Packet> packet, Mac48Address to)
 
 
 void 
-StaWifiMac::S1gBeaconReceived (S1gBeaconHeader beacon)
+StaWifiMac::S1gBeaconReceived (const S1gBeaconHeader &beacon)
 {
     //NS_LOG_UNCOND ( GetAddress () << " WILL Wake Up for slot " << m_statSlotStart);
     //in case station is receiving beacon, it does not go to sleep
@@ -1437,8 +1459,7 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
     }
   else if (hdr->IsS1gBeacon ())
     {
-      S1gBeaconHeader beacon;
-      packet->RemoveHeader (beacon);
+      const S1gBeaconHeader &beacon = DecodeS1gBeacon (packet);
       bool goodBeacon = false;
     if ((IsWaitAssocResp () || IsAssociated ()) && hdr->GetAddr3 () != GetBssid ()) // for debug
      {
@@ -1483,64 +1504,25 @@ StaWifiMac::Receive (Ptr<Packet> packet, const WifiMacHeader *hdr)
 
         
         UnsetInRAWgroup ();
-        uint8_t * rawassign;
-        rawassign = beacon.GetRPS().GetRawAssignment();
-        uint16_t raw_len = beacon.GetRPS().GetInformationFieldSize();
-        uint16_t rawAssignment_len = 6;
-        if (raw_len % rawAssignment_len !=0)
-          {
-             NS_ASSERT ("RAW configuration incorrect!");
-          }
-        uint8_t RAW_number = raw_len/rawAssignment_len;
-
-         uint16_t m_slotDurationCount=0;
-         uint16_t m_slotNum=0;
-         uint64_t m_currentRAW_start=0;
-         m_lastRawDurationus = MicroSeconds(0);
-    for (uint8_t raw_index=0; raw_index < RAW_number; raw_index++)
-      {
-        auto ass = beacon.GetRPS().GetRawAssigmentObj(raw_index);
-
-        if (ass.GetRawTypeIndex() == 4) // only support Generic Raw (paged STA RAW or not)
+        Ptr<const RawSchedule> schedule = beacon.GetRawSchedule ();
+        m_lastRawDurationus = schedule->GetDuration ();
+        if (schedule->GetNGroups () > 0)
           {
-            m_pagedStaRaw = true;
+            // the last RAW of the beacon sets the RAW type and slot parameters
+            const RawSchedule::Group &last = schedule->GetGroup (schedule->GetNGroups () - 1);
+            m_pagedStaRaw = last.rawTypeIndex == 4; // only support Generic Raw (paged STA RAW or not)
+            m_slotDuration = last.slotDuration;
+            m_crossSlotBoundaryAllowed = last.crossBoundary;
           }
-        else
+        uint8_t raw_index = schedule->GetLastGroupInPage (GetAID ());
+        if (raw_index != RawSchedule::NO_GROUP) //in the page indexed and in the AID range
           {
-            m_pagedStaRaw = false;
+            const RawSchedule::Group &group = schedule->GetGroup (raw_index);
+            uint16_t statRawSlot = (GetAID() & 0x07ff) % group.slotNum;
+            m_statSlotStart = group.start + group.slotDuration * statRawSlot;
+            SetInRAWgroup ();
+            m_currentslotDuration = group.slotDuration; //To support variable time duration among multiple RAWs
           }
-         m_currentRAW_start=m_currentRAW_start+(500 + m_slotDurationCount * 120)*m_slotNum;
-         m_slotDurationCount = ass.GetSlotDurationCount();
-         m_slotNum = ass.GetSlotNum();
-
-        m_slotDuration = MicroSeconds(500 + m_slotDurationCount * 120);
-        m_lastRawDurationus = m_lastRawDurationus + m_slotDuration * m_slotNum;
-        m_crossSlotBoundaryAllowed = ass.GetSlotCrossBoundary() == 0x0001;
-
-         if (ass.GetRawGroupPage() == ((GetAID() >> 11 ) & 0x0003)) //in the page indexed
-           {
-               uint16_t statsPerSlot = 0;
-               uint16_t statRawSlot = 0;
-
-               Ptr<UniformRandomVariable> m_rv = CreateObject<UniformRandomVariable> ();
-               uint16_t offset = m_rv->GetValue (0, 1023);
-               offset =0; // for test
-               statsPerSlot = (ass.GetRawGroupAIDEnd() - ass.GetRawGroupAIDStart() + 1)/m_slotNum;
-               //statRawSlot = ((GetAID() & 0x03ff)-raw_start)/statsPerSlot;
-               statRawSlot = ((GetAID() & 0x07ff)+offset)%m_slotNum;
-
-             if ((ass.GetRawGroupAIDStart() <= (GetAID() & 0x07ff)) && ((GetAID() & 0x07ff) <= ass.GetRawGroupAIDEnd()))
-               {
-                 m_statSlotStart = MicroSeconds((500 + m_slotDurationCount * 120)*statRawSlot+m_currentRAW_start);
-                 SetInRAWgroup ();
-                 m_currentslotDuration = m_slotDuration; //To support variable time duration among multiple RAWs
-
-                  // NS_LOG_UNCOND (Simulator::Now () << ", StaWifiMac:: GetAID() = " << GetAID() <<  ", m_statSlotStart=" << m_statSlotStart << ", m_lastRawDurationus = " << m_lastRawDurationus << ", m_currentslotDuration = " << m_currentslotDuration);
-                  //break; //break should not used if multiple RAW is supported
-               }
-               //NS_LOG_UNCOND (Simulator::Now () << ", StaWifiMac:: GetAID() = " << GetAID() << ", raw_start =" << raw_start << ", raw_end=" << raw_end << ", m_statSlotStart=" << m_statSlotStart << ", m_lastRawDurationus = " << m_lastRawDurationus << ", m_currentslotDuration = " << m_currentslotDuration);
-           }
-      }
          m_rawStart = true; //?
          if (this->IsAssociated())
                 S1gTIMReceived(beacon);
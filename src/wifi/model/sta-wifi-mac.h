@@ -225,8 +225,8 @@ private:
   Time GetEarlyWakeTime (void) const;
   void SendPspoll (void);
   void SendPspollIfnecessary (void);
-  void S1gBeaconReceived (S1gBeaconHeader beacon);
-  void S1gTIMReceived (S1gBeaconHeader beacon);
+  void S1gBeaconReceived (const S1gBeaconHeader &beacon);
+  void S1gTIMReceived (const S1gBeaconHeader &beacon);
 
   void StartRawbackoff (void);
   void OutsideRawStartBackoff (void);
@@ -253,9 +253,20 @@ private:
   TracedValue<uint16_t> nrOfTransmissionsDuringRAWSlot = 0;
   bool IsInPagebitmap (uint8_t block);
   
-  void GoToSleepNextTIM (S1gBeaconHeader beacon);
-  void GoToSleepCurrentTIM (S1gBeaconHeader beacon);
+  void GoToSleepNextTIM (const S1gBeaconHeader &beacon);
+  void GoToSleepCurrentTIM (const S1gBeaconHeader &beacon);
   void GoToSleep(Time  sleeptime); 
+  /**
+   * Decode a received S1G beacon once for all the stations receiving it:
+   * the last few decoded beacons are kept by packet uid.
+   *
+   * \param packet the beacon, without its MAC header
+   *
+   * \return the decoded beacon, valid until MAX_DECODED_BEACONS newer
+   *         beacons are decoded
+   */
+  static const S1gBeaconHeader & DecodeS1gBeacon (Ptr<const Packet> packet);
+  static const uint32_t MAX_DECODED_BEACONS = 16;
 
   Time m_lastRawDurationus;
   Time m_lastRawStart;
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "table-error-rate-model.h"
+#include "nist-error-rate-model.h"
+#include "ns3/double.h"
+#include "ns3/pointer.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("TableErrorRateModel");
+
+NS_OBJECT_ENSURE_REGISTERED (TableErrorRateModel);
+
+/// log(BER) stored for SNR values at which the exact model reports no error
+static const double LOG_BER_FLOOR = -690.0;
+
+TypeId
+TableErrorRateModel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::TableErrorRateModel")
+    .SetParent<ErrorRateModel> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<TableErrorRateModel> ()
+    .AddAttribute ("ExactModel",
+                   "The error rate model whose results are tabulated. "
+                   "A NistErrorRateModel is used if none is given.",
+                   PointerValue (),
+                   MakePointerAccessor (&TableErrorRateModel::SetExactModel,
+                                        &TableErrorRateModel::GetExactModel),
+                   MakePointerChecker<ErrorRateModel> ())
+    .AddAttribute ("MinSnr",
+                   "The lowest SNR (dB) of the tables. Lower SNRs are forwarded to the exact model.",
+                   DoubleValue (-10.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_minSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("MaxSnr",
+                   "The highest SNR (dB) of the tables. Higher SNRs are forwarded to the exact model.",
+                   DoubleValue (50.0),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_maxSnrDb),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Step",
+                   "The SNR step (dB) between two entries of the tables.",
+                   DoubleValue (0.01),
+                   MakeDoubleAccessor (&TableErrorRateModel::m_stepDb),
+                   MakeDoubleChecker<double> (1e-6))
+  ;
+  return tid;
+}
+
+TableErrorRateModel::TableErrorRateModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TableErrorRateModel::~TableErrorRateModel ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+TableErrorRateModel::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_exactModel = 0;
+  Flush ();
+  ErrorRateModel::DoDispose ();
+}
+
+void
+TableErrorRateModel::SetExactModel (Ptr<ErrorRateModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  m_exactModel = model;
+  Flush ();
+}
+
+Ptr<ErrorRateModel>
+TableErrorRateModel::GetExactModel (void) const
+{
+  return m_exactModel;
+}
+
+void
+TableErrorRateModel::Flush (void)
+{
+  m_tables.clear ();
+}
+
+void
+TableErrorRateModel::Precompute (WifiMode mode) const
+{
+  GetTable (mode);
+}
+
+const TableErrorRateModel::LogBerTable &
+TableErrorRateModel::GetTable (WifiMode mode) const
+{
+  uint32_t uid = mode.GetUid ();
+  if (uid >= m_tables.size ())
+    {
+      m_tables.resize (uid + 1);
+    }
+  LogBerTable &table = m_tables[uid];
+  if (!table.empty ())
+    {
+      return table;
+    }
+  if (m_exactModel == 0)
+    {
+      const_cast<TableErrorRateModel *> (this)->m_exactModel = CreateObject<NistErrorRateModel> ();
+    }
+  NS_LOG_DEBUG ("build table for mode " << mode);
+  uint32_t size = static_cast<uint32_t> (std::ceil ((m_maxSnrDb - m_minSnrDb) / m_stepDb)) + 1;
+  table.reserve (size);
+  for (uint32_t i = 0; i < size; i++)
+    {
+      double snr = std::pow (10.0, (m_minSnrDb + i * m_stepDb) / 10.0);
+      //the exact models all compute the chunk success rate as (1 - ber)^nbits
+      double ber = 1.0 - m_exactModel->GetChunkSuccessRate (mode, snr, 1);
+      table.push_back (ber > 0.0 ? std::max (std::log (ber), LOG_BER_FLOOR) : LOG_BER_FLOOR);
+    }
+  return table;
+}
+
+double
+TableErrorRateModel::GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const
+{
+  if (nbits == 0)
+    {
+      return 1.0;
+    }
+  const LogBerTable &table = GetTable (mode);
+  double index = snr > 0.0 ? (10.0 * std::log10 (snr) - m_minSnrDb) / m_stepDb : -1.0;
+  if (index < 0.0 || index >= table.size () - 1)
+    {
+      return m_exactModel->GetChunkSuccessRate (mode, snr, nbits);
+    }
+  uint32_t i = static_cast<uint32_t> (index);
+  double fraction = index - i;
+  double logBer = table[i] + fraction * (table[i + 1] - table[i]);
+  double ber = std::exp (logBer);
+  if (ber >= 1.0)
+    {
+      return 0.0;
+    }
+  return std::exp (nbits * std::log1p (-ber));
+}
+
+} //namespace ns3
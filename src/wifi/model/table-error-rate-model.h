@@ -0,0 +1,97 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef TABLE_ERROR_RATE_MODEL_H
+#define TABLE_ERROR_RATE_MODEL_H
+
+#include <stdint.h>
+#include <vector>
+#include "wifi-mode.h"
+#include "error-rate-model.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup wifi
+ *
+ * An error rate model which caches the behaviour of another (exact) error
+ * rate model. For every WifiMode it is used with, the model samples the
+ * per-bit error rate of the exact model on a dense grid of SNR values (in dB)
+ * and stores its logarithm. The success rate of a chunk is then obtained by
+ * linear interpolation in the table and computed as exp(nbits*log1p(-ber)),
+ * which avoids evaluating erfc and the union bounds of the convolutional
+ * codes for every chunk of every reception.
+ *
+ * SNR values outside of the table range are forwarded to the exact model.
+ */
+class TableErrorRateModel : public ErrorRateModel
+{
+public:
+  static TypeId GetTypeId (void);
+
+  TableErrorRateModel ();
+  virtual ~TableErrorRateModel ();
+
+  /**
+   * Set the exact error rate model whose results are tabulated.
+   * This flushes all the tables computed so far.
+   *
+   * \param model the exact error rate model
+   */
+  void SetExactModel (Ptr<ErrorRateModel> model);
+  /**
+   * \return the exact error rate model whose results are tabulated
+   */
+  Ptr<ErrorRateModel> GetExactModel (void) const;
+  /**
+   * Build the table of the given mode, if not done yet.
+   *
+   * \param mode the Wi-Fi mode
+   */
+  void Precompute (WifiMode mode) const;
+
+  virtual double GetChunkSuccessRate (WifiMode mode, double snr, uint32_t nbits) const;
+
+
+private:
+  virtual void DoDispose (void);
+
+  /**
+   * Table of log(BER) sampled every m_stepDb from m_minSnrDb.
+   */
+  typedef std::vector<double> LogBerTable;
+
+  /**
+   * \param mode the Wi-Fi mode
+   *
+   * \return the table for the given mode, building it if needed
+   */
+  const LogBerTable & GetTable (WifiMode mode) const;
+  /**
+   * Drop all the tables computed so far.
+   */
+  void Flush (void);
+
+  Ptr<ErrorRateModel> m_exactModel; //!< the exact error rate model
+  double m_minSnrDb;                //!< lowest SNR (dB) of the tables
+  double m_maxSnrDb;                //!< highest SNR (dB) of the tables
+  double m_stepDb;                  //!< SNR step (dB) between two table entries
+  mutable std::vector<LogBerTable> m_tables; //!< tables indexed by WifiMode uid
+};
+
+} //namespace ns3
+
+#endif /* TABLE_ERROR_RATE_MODEL_H */
@@ -222,7 +222,6 @@ TIM::SetPartialVBitmap (TIM::EncodedBlock block)
     subblock++;
     i++;
   }
-  m_partialVBitmap = m_partialVBitmap_arrary;
   NS_ASSERT ( m_length < 252);
 }
 
@@ -265,7 +264,8 @@ TIM::GetPageIndex(void) const
 uint8_t *
 TIM::GetPartialVBitmap (void) const
 {
-  return m_partialVBitmap;
+  //the bitmap is owned by the element, so that copies of the element do not refer to each other
+  return const_cast<uint8_t *> (m_partialVBitmap_arrary);
 }
 
 WifiInformationElementId
@@ -293,7 +293,7 @@ TIM::SerializeInformationField (Buffer::Iterator start) const
  if (m_BitmapControl || m_length != 0)
    {
      start.WriteU8 (m_BitmapControl);
-     start.Write (m_partialVBitmap, m_length);
+     start.Write (m_partialVBitmap_arrary, m_length);
      NS_LOG_DEBUG ("Bitmap Control field is " << (int)m_BitmapControl);
      NS_LOG_DEBUG ("Length of Partial Virtual Bitmap is " << (int)m_length);
    }
@@ -310,7 +310,6 @@ TIM::DeserializeInformationField (Buffer::Iterator start, uint8_t length)
 	  SetBitmapControl (start.ReadU8 ());
 	  start.Read (m_partialVBitmap_arrary, (length-3));
 	  m_length = length-3;
-	  m_partialVBitmap = m_partialVBitmap_arrary;
 
     }
   else
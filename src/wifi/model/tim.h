@@ -158,7 +158,6 @@ private:
   uint8_t m_PageIndex;
   TIM::EncodedBlock m_encodeblock; //!< encoded block subfield of partial Virtual Bitmap field
   uint8_t m_partialVBitmap_arrary[251]; // see 9.4.2.6.1
-  uint8_t * m_partialVBitmap;
 
   uint8_t * subblock; 
 };
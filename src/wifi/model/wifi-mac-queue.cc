@@ -20,9 +20,11 @@
  *          Mirko Banchi <mk.banchi@gmail.com>
  */
 
+#include <algorithm>
 #include "ns3/simulator.h"
 #include "ns3/packet.h"
 #include "ns3/uinteger.h"
+#include "ns3/assert.h"
 #include "wifi-mac-queue.h"
 #include "qos-blocked-destinations.h"
 
@@ -108,28 +110,33 @@ WifiMacQueue::Enqueue (Ptr<const Packet> packet, const WifiMacHeader &hdr)
     }
   Time now = Simulator::Now ();
   m_queue.push_back (Item (packet, hdr, now));
+  NotifyInserted (m_queue.back ());
   m_size++;
 }
 
 void
 WifiMacQueue::Cleanup (void)
 {
-  if (m_queue.empty ())
+  Time now = Simulator::Now ();
+  //nothing can have expired before the oldest packet
+  if (m_queue.empty () || m_oldest + m_maxDelay > now)
     {
       return;
     }
 
-  Time now = Simulator::Now ();
   uint32_t n = 0;
+  m_oldest = now;
   for (PacketQueueI i = m_queue.begin (); i != m_queue.end (); )
     {
       if (i->tstamp + m_maxDelay > now)
         {
+          m_oldest = std::min (m_oldest, i->tstamp);
           i++;
         }
       else
         {
     	  m_packetdropped(i->packet->Copy(), DropReason::MacQueueDelayExceeded);
+          NotifyRemoved (*i);
           i = m_queue.erase (i);
           n++;
         }
@@ -144,6 +151,7 @@ WifiMacQueue::Dequeue (WifiMacHeader *hdr)
   if (!m_queue.empty ())
     {
       Item i = m_queue.front ();
+      NotifyRemoved (i);
       m_queue.pop_front ();
       m_size--;
       *hdr = i.hdr;
@@ -183,6 +191,7 @@ WifiMacQueue::DequeueByTidAndAddress (WifiMacHeader *hdr, uint8_t tid,
                 {
                   packet = it->packet;
                   *hdr = it->hdr;
+                  NotifyRemoved (*it);
                   m_queue.erase (it);
                   m_size--;
                   break;
@@ -236,6 +245,20 @@ WifiMacQueue::PeekByAddress (WifiMacHeader::AddressType type, Mac48Address dest)
   return 0;
 }
 
+bool
+WifiMacQueue::HasPacketsTo (Mac48Address addr1)
+{
+  return GetNPacketsTo (addr1) > 0;
+}
+
+uint32_t
+WifiMacQueue::GetNPacketsTo (Mac48Address addr1)
+{
+  Cleanup ();
+  std::map<Mac48Address, uint32_t>::const_iterator it = m_nPacketsTo.find (addr1);
+  return it == m_nPacketsTo.end () ? 0 : it->second;
+}
+
 bool
 WifiMacQueue::IsEmpty (void)
 {
@@ -253,6 +276,7 @@ void
 WifiMacQueue::Flush (void)
 {
   m_queue.erase (m_queue.begin (), m_queue.end ());
+  m_nPacketsTo.clear ();
   m_size = 0;
 }
 
@@ -274,6 +298,27 @@ WifiMacQueue::GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQ
   return 0;
 }
 
+void
+WifiMacQueue::NotifyInserted (const Item &item)
+{
+  if (m_queue.size () == 1)
+    {
+      m_oldest = item.tstamp;
+    }
+  m_nPacketsTo[item.hdr.GetAddr1 ()]++;
+}
+
+void
+WifiMacQueue::NotifyRemoved (const Item &item)
+{
+  std::map<Mac48Address, uint32_t>::iterator it = m_nPacketsTo.find (item.hdr.GetAddr1 ());
+  NS_ASSERT (it != m_nPacketsTo.end () && it->second > 0);
+  if (--it->second == 0)
+    {
+      m_nPacketsTo.erase (it);
+    }
+}
+
 bool
 WifiMacQueue::Remove (Ptr<const Packet> packet)
 {
@@ -282,6 +327,7 @@ WifiMacQueue::Remove (Ptr<const Packet> packet)
     {
       if (it->packet == packet)
         {
+          NotifyRemoved (*it);
           m_queue.erase (it);
           m_size--;
           return true;
@@ -301,6 +347,7 @@ WifiMacQueue::PushFront (Ptr<const Packet> packet, const WifiMacHeader &hdr)
     }
   Time now = Simulator::Now ();
   m_queue.push_front (Item (packet, hdr, now));
+  NotifyInserted (m_queue.front ());
   m_size++;
 }
 
@@ -341,6 +388,7 @@ WifiMacQueue::DequeueFirstAvailable (WifiMacHeader *hdr, Time &timestamp,
           *hdr = it->hdr;
           timestamp = it->tstamp;
           packet = it->packet;
+          NotifyRemoved (*it);
           m_queue.erase (it);
           m_size--;
           return packet;
@@ -24,6 +24,7 @@
 #define WIFI_MAC_QUEUE_H
 
 #include <list>
+#include <map>
 #include <utility>
 #include "ns3/packet.h"
 #include "ns3/nstime.h"
@@ -149,6 +150,22 @@ public:
    * \return packet
    */
   Ptr<const Packet> PeekByAddress (WifiMacHeader::AddressType type, Mac48Address dest);
+  /**
+   * Return whether the queue holds packets for the given receiver, whatever
+   * their type and TID. The packets are counted per Addr1 as they enter
+   * and leave the queue, so that this does not scan the queue.
+   *
+   * \param addr1 the receiver address
+   *
+   * \return true if a packet with this Addr1 is queued, false otherwise
+   */
+  bool HasPacketsTo (Mac48Address addr1);
+  /**
+   * \param addr1 the receiver address
+   *
+   * \return the number of packets queued with this Addr1
+   */
+  uint32_t GetNPacketsTo (Mac48Address addr1);
   Ptr<const Packet> PeekByTidAndAddress (WifiMacHeader *hdr,
                                          uint8_t tid,
                                          WifiMacHeader::AddressType type,
@@ -275,11 +292,25 @@ protected:
    * \return the address
    */
   Mac48Address GetAddressForPacket (enum WifiMacHeader::AddressType type, PacketQueueI it);
+  /**
+   * Account for a packet entering the queue.
+   *
+   * \param item the queued packet
+   */
+  void NotifyInserted (const Item &item);
+  /**
+   * Account for a packet leaving the queue.
+   *
+   * \param item the packet removed from the queue
+   */
+  void NotifyRemoved (const Item &item);
 
   PacketQueue m_queue; //!< Packet (struct Item) queue
   uint32_t m_size;     //!< Current queue size
   uint32_t m_maxSize;  //!< Queue capacity
   Time m_maxDelay;     //!< Time to live for packets in the queue
+  Time m_oldest;       //!< lower bound of the timestamps of the queued packets
+  std::map<Mac48Address, uint32_t> m_nPacketsTo; //!< number of queued packets per Addr1
 
   TracedCallback<Ptr<const Packet>, DropReason> m_packetdropped;
 };
@@ -346,16 +346,16 @@ WifiPhyStateHelper::LogPreviousIdleAndCcaBusyStates (void)
       ccaBusyStart = Max (ccaBusyStart, m_startCcaBusy);
       ccaBusyStart = Max (ccaBusyStart, m_endSwitching);
       ccaBusyStart = Max(ccaBusyStart, m_endSleep);
-      m_stateLogger (ccaBusyStart, idleStart - ccaBusyStart, WifiPhy::CCA_BUSY);
+      NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, ccaBusyStart, idleStart - ccaBusyStart, WifiPhy::CCA_BUSY);
     }
-  m_stateLogger (idleStart, now - idleStart, WifiPhy::IDLE);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, idleStart, now - idleStart, WifiPhy::IDLE);
 }
 
 void
 WifiPhyStateHelper::SwitchToTx (Time txDuration, Ptr<const Packet> packet, double txPowerDbm,
                                 WifiTxVector txVector, WifiPreamble preamble)
 {
-  m_txTrace (packet, txVector.GetMode (), preamble, txVector.GetTxPowerLevel ());
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_txTrace, packet, txVector.GetMode (), preamble, txVector.GetTxPowerLevel ());
   Time now = Simulator::Now ();
   switch (GetState ())
     {
@@ -364,7 +364,7 @@ WifiPhyStateHelper::SwitchToTx (Time txDuration, Ptr<const Packet> packet, doubl
        * as its endRx event are cancelled by the caller.
        */
       m_rxing = false;
-      m_stateLogger (m_startRx, now - m_startRx, WifiPhy::RX);
+      NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, m_startRx, now - m_startRx, WifiPhy::RX);
       m_endRx = now;
       break;
     case WifiPhy::CCA_BUSY:
@@ -372,7 +372,7 @@ WifiPhyStateHelper::SwitchToTx (Time txDuration, Ptr<const Packet> packet, doubl
         Time ccaStart = Max (m_endRx, m_endTx);
         ccaStart = Max (ccaStart, m_startCcaBusy);
         ccaStart = Max (ccaStart, m_endSwitching);
-        m_stateLogger (ccaStart, now - ccaStart, WifiPhy::CCA_BUSY);
+        NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, ccaStart, now - ccaStart, WifiPhy::CCA_BUSY);
       } break;
     case WifiPhy::IDLE:
       LogPreviousIdleAndCcaBusyStates ();
@@ -383,7 +383,7 @@ WifiPhyStateHelper::SwitchToTx (Time txDuration, Ptr<const Packet> packet, doubl
       NS_FATAL_ERROR ("Invalid WifiPhy state.");
       break;
     }
-  m_stateLogger (now, txDuration, WifiPhy::TX);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, now, txDuration, WifiPhy::TX);
   m_previousStateChangeTime = now;
   m_endTx = now + txDuration;
   m_startTx = now;
@@ -406,7 +406,7 @@ WifiPhyStateHelper::SwitchToRx (Time rxDuration)
         Time ccaStart = Max (m_endRx, m_endTx);
         ccaStart = Max (ccaStart, m_startCcaBusy);
         ccaStart = Max (ccaStart, m_endSwitching);
-        m_stateLogger (ccaStart, now - ccaStart, WifiPhy::CCA_BUSY);
+        NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, ccaStart, now - ccaStart, WifiPhy::CCA_BUSY);
       } break;
     case WifiPhy::SWITCHING:
     case WifiPhy::RX:
@@ -434,7 +434,7 @@ WifiPhyStateHelper::SwitchToChannelSwitching (Time switchingDuration)
        * as its endRx event are cancelled by the caller.
        */
       m_rxing = false;
-      m_stateLogger (m_startRx, now - m_startRx, WifiPhy::RX);
+      NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, m_startRx, now - m_startRx, WifiPhy::RX);
       m_endRx = now;
       break;
     case WifiPhy::CCA_BUSY:
@@ -442,7 +442,7 @@ WifiPhyStateHelper::SwitchToChannelSwitching (Time switchingDuration)
         Time ccaStart = Max (m_endRx, m_endTx);
         ccaStart = Max (ccaStart, m_startCcaBusy);
         ccaStart = Max (ccaStart, m_endSwitching);
-        m_stateLogger (ccaStart, now - ccaStart, WifiPhy::CCA_BUSY);
+        NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, ccaStart, now - ccaStart, WifiPhy::CCA_BUSY);
       } break;
     case WifiPhy::IDLE:
       LogPreviousIdleAndCcaBusyStates ();
@@ -460,7 +460,7 @@ WifiPhyStateHelper::SwitchToChannelSwitching (Time switchingDuration)
       m_endCcaBusy = now;
     }
 
-  m_stateLogger (now, switchingDuration, WifiPhy::SWITCHING);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, now, switchingDuration, WifiPhy::SWITCHING);
   m_previousStateChangeTime = now;
   m_startSwitching = now;
   m_endSwitching = now + switchingDuration;
@@ -471,7 +471,7 @@ WifiPhyStateHelper::SwitchToChannelSwitching (Time switchingDuration)
 void
 WifiPhyStateHelper::SwitchFromRxEndOk (Ptr<Packet> packet, double snr, WifiTxVector txVector, enum WifiPreamble preamble)
 {
-  m_rxOkTrace (packet, snr, txVector.GetMode (), preamble);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_rxOkTrace, packet, snr, txVector.GetMode (), preamble);
   NotifyRxEndOk ();
   DoSwitchFromRx ();
   if (!m_rxOkCallback.IsNull ())
@@ -484,7 +484,7 @@ WifiPhyStateHelper::SwitchFromRxEndOk (Ptr<Packet> packet, double snr, WifiTxVec
 void
 WifiPhyStateHelper::SwitchFromRxEndError (Ptr<const Packet> packet, double snr)
 {
-  m_rxErrorTrace (packet, snr);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_rxErrorTrace, packet, snr);
   NotifyRxEndError ();
   DoSwitchFromRx ();
   if (!m_rxErrorCallback.IsNull ())
@@ -500,7 +500,7 @@ WifiPhyStateHelper::DoSwitchFromRx (void)
   NS_ASSERT (m_rxing);
 
   Time now = Simulator::Now ();
-  m_stateLogger (m_startRx, now - m_startRx, WifiPhy::RX);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, m_startRx, now - m_startRx, WifiPhy::RX);
   m_previousStateChangeTime = now;
   m_rxing = false;
 
@@ -549,7 +549,7 @@ WifiPhyStateHelper::SwitchToSleep (void)
         Time ccaStart = Max (m_endRx, m_endTx);
         ccaStart = Max (ccaStart, m_startCcaBusy);
         ccaStart = Max (ccaStart, m_endSwitching);
-        m_stateLogger (ccaStart, now - ccaStart, WifiPhy::CCA_BUSY);
+        NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, ccaStart, now - ccaStart, WifiPhy::CCA_BUSY);
       } break;
     case WifiPhy::RX:
     case WifiPhy::SWITCHING:
@@ -570,7 +570,7 @@ WifiPhyStateHelper::SwitchFromSleep (Time duration)
 {
     NS_ASSERT(IsStateSleep());
     Time now = Simulator::Now();
-    m_stateLogger(m_startSleep, now - m_startSleep, WifiPhy::SLEEP);
+    NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_stateLogger, m_startSleep, now - m_startSleep, WifiPhy::SLEEP);
     m_previousStateChangeTime = now;
     m_sleeping = false;
     m_endSleep = now;
@@ -50,6 +50,9 @@ WifiPhyListener::~WifiPhyListener ()
 
 NS_OBJECT_ENSURE_REGISTERED (WifiPhy);
 
+/// Number of cached transmission durations above which the cache is flushed
+static const uint32_t MAX_TX_DURATION_CACHE_SIZE = 65536;
+
 TypeId
 WifiPhy::GetTypeId (void)
 {
@@ -819,21 +822,101 @@ else
 Time
 WifiPhy::CalculateTxDuration (uint32_t size, WifiTxVector txvector, WifiPreamble preamble, double frequency, uint8_t packetType, uint8_t incFlag)
 {
+  if (packetType != 0)
+    {
+      //the duration of an MPDU in an A-MPDU depends on the MPDUs before it
+      return CalculatePlcpPreambleAndHeaderDuration (txvector, preamble)
+             + GetPayloadDuration (size, txvector, preamble, frequency, packetType, incFlag);
+    }
+  uint64_t key = GetTxDurationKey (size, txvector, preamble, frequency);
+  TxDurationCache::const_iterator it = m_txDurationCache.find (key);
+  if (it != m_txDurationCache.end ())
+    {
+      return it->second;
+    }
   Time duration = CalculatePlcpPreambleAndHeaderDuration (txvector, preamble)
     + GetPayloadDuration (size, txvector, preamble, frequency, packetType, incFlag);
+  if (m_txDurationCache.size () >= MAX_TX_DURATION_CACHE_SIZE)
+    {
+      m_txDurationCache.clear ();
+    }
+  m_txDurationCache.insert (std::make_pair (key, duration));
   return duration;
 }
 
+void
+WifiPhy::PrecomputeTxDuration (uint32_t size)
+{
+  NS_LOG_FUNCTION (this << size);
+  for (uint32_t i = 0; i < GetNModes (); i++)
+    {
+      WifiMode mode = GetMode (i);
+      std::vector<WifiPreamble> preambles;
+      switch (mode.GetModulationClass ())
+        {
+        case WIFI_MOD_CLASS_DSSS:
+          preambles.push_back (WIFI_PREAMBLE_LONG);
+          preambles.push_back (WIFI_PREAMBLE_SHORT);
+          break;
+        case WIFI_MOD_CLASS_OFDM:
+        case WIFI_MOD_CLASS_ERP_OFDM:
+          preambles.push_back (WIFI_PREAMBLE_LONG);
+          break;
+        case WIFI_MOD_CLASS_HT:
+          preambles.push_back (WIFI_PREAMBLE_HT_MF);
+          preambles.push_back (WIFI_PREAMBLE_HT_GF);
+          break;
+        case WIFI_MOD_CLASS_S1G:
+          preambles.push_back (WIFI_PREAMBLE_S1G_SHORT);
+          preambles.push_back (WIFI_PREAMBLE_S1G_LONG);
+          preambles.push_back (WIFI_PREAMBLE_S1G_1M);
+          break;
+        default:
+          continue;
+        }
+      WifiTxVector txVector (mode, 0, 0, false, 1, 0, false);
+      for (std::vector<WifiPreamble>::const_iterator j = preambles.begin (); j != preambles.end (); j++)
+        {
+          CalculateTxDuration (size, txVector, *j, GetFrequency (), 0, 0);
+        }
+    }
+}
+
+uint64_t
+WifiPhy::GetTxDurationKey (uint32_t size, WifiTxVector txvector, WifiPreamble preamble, double frequency)
+{
+  //the frequency only matters to tell the 2.4 GHz band apart (HT signal extension)
+  uint64_t band = (frequency >= 2400 && frequency <= 2500) ? 1 : 0;
+  uint32_t uid = txvector.GetMode ().GetUid ();
+  NS_ASSERT (uid <= 0xffff);
+  return static_cast<uint64_t> (size)
+         | (static_cast<uint64_t> (uid) << 32)
+         | (static_cast<uint64_t> (txvector.GetNss () & 0xf) << 48)
+         | (static_cast<uint64_t> (txvector.GetNess () & 0xf) << 52)
+         | (static_cast<uint64_t> (txvector.IsStbc () ? 1 : 0) << 56)
+         | (static_cast<uint64_t> (preamble & 0xf) << 57)
+         | (band << 61);
+}
+
+size_t
+WifiPhy::TxDurationKeyHash::operator() (uint64_t key) const
+{
+  //fold the mode and preamble bits onto the size bits
+  key ^= key >> 29;
+  key *= 0x9e3779b97f4a7c15ULL;
+  return static_cast<size_t> (key ^ (key >> 32));
+}
+
 void
 WifiPhy::NotifyTxBegin (Ptr<const Packet> packet)
 {
-  m_phyTxBeginTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyTxBeginTrace, packet);
 }
 
 void
 WifiPhy::NotifyTxEnd (Ptr<const Packet> packet)
 {
-  m_phyTxEndTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyTxEndTrace, packet);
 }
 
 void
@@ -841,40 +924,40 @@ WifiPhy::NotifyTxDrop (Ptr<const Packet> packet, DropReason reason)
 {
   // NS_LOG_INFO("lost: " << Simulator::Now ().GetSeconds () << " reason: " << reason);
   // NS_LOG_INFO("ARJOT");
-  m_phyTxDropTrace (packet);
-  m_phyTxDropWithDropReasonTrace (packet, reason);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyTxDropTrace, packet);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyTxDropWithDropReasonTrace, packet, reason);
 }
 
 void
 WifiPhy::NotifyRxBegin (Ptr<const Packet> packet)
 {
-  m_phyRxBeginTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyRxBeginTrace, packet);
 }
 
 void
 WifiPhy::NotifyRxEnd (Ptr<const Packet> packet)
 {
-  m_phyRxEndTrace (packet);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyRxEndTrace, packet);
 }
 
 void
 WifiPhy::NotifyRxDrop (Ptr<const Packet> packet, DropReason reason)
 {
   // NS_LOG_INFO("lost: " << Simulator::Now ().GetSeconds () << " reason: " << reason);
-  m_phyRxDropTrace (packet);
-  m_phyRxDropWithDropReasonTrace(packet, reason);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyRxDropTrace, packet);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyRxDropWithDropReasonTrace, packet, reason);
 }
 
 void
 WifiPhy::NotifyMonitorSniffRx (Ptr<const Packet> packet, uint16_t channelFreqMhz, uint16_t channelNumber, uint32_t rate, bool isShortPreamble, WifiTxVector txvector, double signalDbm, double noiseDbm)
 {
-  m_phyMonitorSniffRxTrace (packet, channelFreqMhz, channelNumber, rate, isShortPreamble, txvector, signalDbm, noiseDbm);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyMonitorSniffRxTrace, packet, channelFreqMhz, channelNumber, rate, isShortPreamble, txvector, signalDbm, noiseDbm);
 }
 
 void
 WifiPhy::NotifyMonitorSniffTx (Ptr<const Packet> packet, uint16_t channelFreqMhz, uint16_t channelNumber, uint32_t rate, bool isShortPreamble, WifiTxVector txvector)
 {
-  m_phyMonitorSniffTxTrace (packet, channelFreqMhz, channelNumber, rate, isShortPreamble, txvector);
+  NS_TRACE (NS3_TRACE_GROUP_WIFI_PHY, m_phyMonitorSniffTxTrace, packet, channelFreqMhz, channelNumber, rate, isShortPreamble, txvector);
 }
 
 
@@ -27,6 +27,7 @@
 #include "ns3/object.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
+#include "ns3/sgi-hashmap.h"
 #include "wifi-mode.h"
 #include "wifi-preamble.h"
 #include "wifi-phy-standard.h"
@@ -34,6 +35,16 @@
 #include "wifi-tx-vector.h"
 #include "drop-reason.h"
 
+/**
+ * Trace group of the traces of WifiPhy and WifiPhyStateHelper, see
+ * NS_TRACE: compiled out with --disable-trace-groups=wifi-phy.
+ */
+#ifdef NS3_DISABLE_TRACE_GROUP_WIFI_PHY
+#define NS3_TRACE_GROUP_WIFI_PHY false
+#else
+#define NS3_TRACE_GROUP_WIFI_PHY true
+#endif
+
 namespace ns3 {
 
 class WifiChannel;
@@ -300,6 +311,15 @@ public:
    * \return the total amount of time this PHY will stay busy for the transmission of these bytes.
    */
   Time CalculateTxDuration (uint32_t size, WifiTxVector txvector, enum WifiPreamble preamble, double frequency, uint8_t packetType, uint8_t incFlag);
+  /**
+   * Compute and cache the duration of a frame of the given size (not part of
+   * an A-MPDU) for every mode supported by this PHY and every preamble that
+   * can be used with it, so that later calls to CalculateTxDuration for
+   * that size are table lookups. This is typically used for control frames.
+   *
+   * \param size the number of bytes in the packet to send
+   */
+  void PrecomputeTxDuration (uint32_t size);
 
   /**
    * \param txvector the transmission parameters used for this packet
@@ -1883,6 +1903,36 @@ private:
    */
   TracedCallback<Ptr<const Packet>, uint16_t, uint16_t, uint32_t, bool, WifiTxVector> m_phyMonitorSniffTxTrace;
 
+  /**
+   * \param size the number of bytes in the packet to send
+   * \param txvector the transmission parameters used for this packet
+   * \param preamble the type of preamble to use for this packet
+   * \param frequency the channel center frequency (MHz)
+   *
+   * \return the key of the transmission duration cache, which packs all the
+   *         parameters the duration of a non A-MPDU frame depends on
+   */
+  static uint64_t GetTxDurationKey (uint32_t size, WifiTxVector txvector, WifiPreamble preamble, double frequency);
+
+  /**
+   * Hash function of the transmission duration cache keys.
+   */
+  struct TxDurationKeyHash
+  {
+    /**
+     * \param key the key to hash
+     * \return the hash of the key
+     */
+    size_t operator() (uint64_t key) const;
+  };
+
+  /**
+   * Transmission durations of non A-MPDU frames, indexed by GetTxDurationKey
+   */
+  typedef sgi::hash_map<uint64_t, Time, TxDurationKeyHash> TxDurationCache;
+
+  TxDurationCache m_txDurationCache; //!< cached transmission durations
+
   uint32_t m_totalAmpduNumSymbols; //!< Number of symbols previously transmitted for the MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
   uint32_t m_totalAmpduSize;       //!< Total size of the previously transmitted MPDUs in an A-MPDU, used for the computation of the number of symbols needed for the last MPDU in the A-MPDU
 };
@@ -31,6 +31,16 @@
 #include "ns3/nstime.h"
 #include "ns3/traced-callback.h"
 
+/**
+ * Trace group of the traces of YansWifiChannel, see NS_TRACE: compiled
+ * out with --disable-trace-groups=wifi-channel.
+ */
+#ifdef NS3_DISABLE_TRACE_GROUP_WIFI_CHANNEL
+#define NS3_TRACE_GROUP_WIFI_CHANNEL false
+#else
+#define NS3_TRACE_GROUP_WIFI_CHANNEL true
+#endif
+
 namespace ns3 {
 
 class NetDevice;
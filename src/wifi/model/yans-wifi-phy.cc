@@ -338,6 +338,7 @@ void
 YansWifiPhy::SetDevice (Ptr<NetDevice> device)
 {
   m_device = device;
+  m_nodeMobility = ObjectHandle<MobilityModel> ();
 }
 
 void
@@ -409,7 +410,11 @@ YansWifiPhy::GetMobility (void)
     }
   else
     {
-      return m_device->GetNode ()->GetObject<MobilityModel> ();
+      if (!m_nodeMobility.IsBound ())
+        {
+          m_nodeMobility = ObjectHandle<MobilityModel> (m_device->GetNode ());
+        }
+      return m_nodeMobility.Get ();
     }
 }
 
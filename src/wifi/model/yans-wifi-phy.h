@@ -27,6 +27,7 @@
 #include "ns3/event-id.h"
 #include "ns3/packet.h"
 #include "ns3/object.h"
+#include "ns3/object-handle.h"
 #include "ns3/traced-callback.h"
 #include "ns3/nstime.h"
 #include "ns3/ptr.h"
@@ -546,6 +547,7 @@ void Configure80211ah (void);
   uint16_t             m_channelNumber;  //!< Operating channel number
   Ptr<NetDevice>       m_device;         //!< Pointer to the device
   Ptr<MobilityModel>   m_mobility;       //!< Pointer to the mobility model
+  ObjectHandle<MobilityModel> m_nodeMobility; //!< Mobility model of the node, if m_mobility is not set
 
   uint32_t m_numberOfTransmitters;  //!< Number of transmitters
   uint32_t m_numberOfReceivers;     //!< Number of receivers
@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/aid-bitmap.h"
+
+using namespace ns3;
+
+/**
+ * Check the AID bitmap operations and the AID of a MAC address.
+ */
+class AidBitmapTest : public TestCase
+{
+public:
+  AidBitmapTest ();
+  virtual ~AidBitmapTest ();
+  virtual void DoRun (void);
+};
+
+AidBitmapTest::AidBitmapTest ()
+  : TestCase ("Check AidBitmap")
+{
+}
+
+AidBitmapTest::~AidBitmapTest ()
+{
+}
+
+void
+AidBitmapTest::DoRun (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (AidBitmap::GetAid (Mac48Address ("00:00:00:00:00:2a")), 42, "wrong AID");
+  NS_TEST_ASSERT_MSG_EQ (AidBitmap::GetAid (Mac48Address ("00:00:00:00:e1:05")), 0x0105, "wrong AID");
+
+  AidBitmap bitmap;
+  NS_TEST_ASSERT_MSG_EQ (bitmap.IsEmpty (), true, "new bitmap not empty");
+  NS_TEST_ASSERT_MSG_EQ (bitmap.IsSet (AidBitmap::MAX_AID), false, "AID set in a new bitmap");
+  bitmap.Set (1);
+  bitmap.Set (64);
+  bitmap.Set (AidBitmap::MAX_AID);
+  bitmap.Reset (2);
+  bitmap.Reset (5000);
+  NS_TEST_ASSERT_MSG_EQ (bitmap.GetCount (), 3, "wrong number of AIDs");
+  NS_TEST_ASSERT_MSG_EQ (bitmap.IsSet (1), true, "AID 1 not set");
+  NS_TEST_ASSERT_MSG_EQ (bitmap.IsSet (63), false, "AID 63 set");
+  NS_TEST_ASSERT_MSG_EQ (bitmap.IsSet (64), true, "AID 64 not set");
+  NS_TEST_ASSERT_MSG_EQ (bitmap.IsSet (AidBitmap::MAX_AID), true, "highest AID not set");
+
+  AidBitmap other;
+  other.Set (2);
+  other.Set (64);
+  bitmap.Reset (AidBitmap::MAX_AID);
+  bitmap.SetAll (other);
+  NS_TEST_ASSERT_MSG_EQ (bitmap.GetCount (), 3, "wrong number of AIDs after the union");
+  NS_TEST_ASSERT_MSG_EQ (bitmap.IsSet (2), true, "AID 2 not set by the union");
+  NS_TEST_ASSERT_MSG_EQ (other.GetCount (), 2, "union modified its operand");
+
+  bitmap.ResetAll ();
+  NS_TEST_ASSERT_MSG_EQ (bitmap.IsEmpty (), true, "bitmap not empty after ResetAll");
+}
+
+/**
+ * AID bitmap test suite
+ */
+class AidBitmapTestSuite : public TestSuite
+{
+public:
+  AidBitmapTestSuite ();
+};
+
+AidBitmapTestSuite::AidBitmapTestSuite ()
+  : TestSuite ("wifi-aid-bitmap", UNIT)
+{
+  AddTestCase (new AidBitmapTest, TestCase::QUICK);
+}
+
+static AidBitmapTestSuite g_aidBitmapTestSuite;
@@ -0,0 +1,118 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/pointer.h"
+#include "ns3/object-factory.h"
+#include "ns3/yans-wifi-phy.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/yans-error-rate-model.h"
+#include "ns3/table-error-rate-model.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("ErrorRateModelTest");
+
+/**
+ * Compare the chunk success rates of TableErrorRateModel with those of the
+ * exact model it tabulates, for all the S1G modes and a few legacy ones.
+ */
+class TableErrorRateModelTest : public TestCase
+{
+public:
+  /**
+   * \param exactModelType the TypeId name of the exact model
+   */
+  TableErrorRateModelTest (std::string exactModelType);
+  virtual ~TableErrorRateModelTest ();
+  virtual void DoRun (void);
+
+
+private:
+  std::string m_exactModelType;
+};
+
+TableErrorRateModelTest::TableErrorRateModelTest (std::string exactModelType)
+  : TestCase ("Check TableErrorRateModel against " + exactModelType),
+    m_exactModelType (exactModelType)
+{
+}
+
+TableErrorRateModelTest::~TableErrorRateModelTest ()
+{
+}
+
+void
+TableErrorRateModelTest::DoRun (void)
+{
+  std::vector<WifiMode> modes;
+  //1, 2 and 4 MHz S1G MCSs as configured by the PHY, plus MCS10
+  for (uint32_t width = 1; width <= 4; width *= 2)
+    {
+      Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+      phy->SetChannelWidth (width);
+      phy->ConfigureStandard (WIFI_PHY_STANDARD_80211ah);
+      for (uint32_t i = 0; i < phy->GetNModes (); i++)
+        {
+          modes.push_back (phy->GetMode (i));
+        }
+      phy->Dispose ();
+    }
+  modes.push_back (WifiPhy::GetOfdmRate150KbpsBW1MHz ());
+  modes.push_back (WifiPhy::GetOfdmRate6Mbps ());
+  modes.push_back (WifiPhy::GetOfdmRate54Mbps ());
+
+  ObjectFactory factory;
+  factory.SetTypeId (m_exactModelType);
+  Ptr<ErrorRateModel> exact = factory.Create<ErrorRateModel> ();
+  Ptr<TableErrorRateModel> table = CreateObject<TableErrorRateModel> ();
+  table->SetAttribute ("ExactModel", PointerValue (exact));
+
+  const uint32_t sizes[] = {1, 8 * 14, 8 * 100, 8 * 1500};
+  for (std::vector<WifiMode>::const_iterator mode = modes.begin (); mode != modes.end (); mode++)
+    {
+      for (double snrDb = -5.03; snrDb < 45.0; snrDb += 0.37)
+        {
+          double snr = std::pow (10.0, snrDb / 10.0);
+          for (uint32_t i = 0; i < sizeof (sizes) / sizeof (sizes[0]); i++)
+            {
+              double expected = exact->GetChunkSuccessRate (*mode, snr, sizes[i]);
+              double actual = table->GetChunkSuccessRate (*mode, snr, sizes[i]);
+              NS_TEST_ASSERT_MSG_EQ_TOL (actual, expected, 1e-3, "mode=" << *mode << " snr=" << snrDb << "dB nbits=" << sizes[i]);
+            }
+        }
+    }
+}
+
+/**
+ * Error rate model test suite
+ */
+class ErrorRateModelTestSuite : public TestSuite
+{
+public:
+  ErrorRateModelTestSuite ();
+};
+
+ErrorRateModelTestSuite::ErrorRateModelTestSuite ()
+  : TestSuite ("wifi-error-rate-models", UNIT)
+{
+  AddTestCase (new TableErrorRateModelTest ("ns3::NistErrorRateModel"), TestCase::QUICK);
+  AddTestCase (new TableErrorRateModelTest ("ns3::YansErrorRateModel"), TestCase::QUICK);
+}
+
+static ErrorRateModelTestSuite g_errorRateModelTestSuite;
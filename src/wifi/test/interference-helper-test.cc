@@ -0,0 +1,271 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include <algorithm>
+#include "ns3/test.h"
+#include "ns3/interference-helper.h"
+#include "ns3/nist-error-rate-model.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * Check the SNR, PER and energy duration computed by InterferenceHelper
+ * from its running power totals against a direct computation which sums
+ * the power of the overlapping events, as the list-based implementation
+ * did.
+ */
+class InterferenceHelperRunningPowerTest : public TestCase
+{
+public:
+  InterferenceHelperRunningPowerTest ();
+  virtual ~InterferenceHelperRunningPowerTest ();
+  virtual void DoRun (void);
+
+private:
+  /// An event added to the helper
+  struct Reference
+  {
+    Time start;   //!< start of the event
+    Time end;     //!< end of the event
+    double power; //!< power of the event (W)
+  };
+
+  /**
+   * Add an event to the helper and to the references.
+   *
+   * \param duration the duration of the event
+   * \param power the power of the event (W)
+   * \param receive whether the event is received
+   */
+  void AddEvent (Time duration, double power, bool receive);
+  /**
+   * Check the SNR and PER of the event being received, and end its reception.
+   */
+  void CheckReception (void);
+  /**
+   * Check the duration until the power on the medium falls below a threshold.
+   *
+   * \param energyW the threshold (W)
+   */
+  void CheckEnergyDuration (double energyW);
+
+  /**
+   * \param at the time
+   * \param exclude the index of an event to leave out, or the number of events
+   *
+   * \return the power of the events on the medium right after the time
+   */
+  double GetPower (Time at, uint32_t exclude) const;
+  /**
+   * \param signal the power of the signal (W)
+   * \param noiseInterference the power of the noise and the interference (W)
+   * \param mode the mode of the signal
+   *
+   * \return the SNR
+   */
+  double GetSnr (double signal, double noiseInterference, WifiMode mode) const;
+
+  InterferenceHelper m_helper;              //!< the helper under test
+  Ptr<ErrorRateModel> m_errorRateModel;     //!< the error rate model
+  WifiTxVector m_txVector;                  //!< the TXVECTOR of the events
+  std::vector<Reference> m_references;      //!< the events added so far
+  Ptr<InterferenceHelper::Event> m_rxEvent; //!< the event being received
+  uint32_t m_rxIndex;                       //!< the index of the event being received
+  uint32_t m_nChecks;                       //!< number of checks run
+};
+
+InterferenceHelperRunningPowerTest::InterferenceHelperRunningPowerTest ()
+  : TestCase ("Check InterferenceHelper against a direct sum of the overlapping events"),
+    m_rxIndex (0),
+    m_nChecks (0)
+{
+}
+
+InterferenceHelperRunningPowerTest::~InterferenceHelperRunningPowerTest ()
+{
+}
+
+void
+InterferenceHelperRunningPowerTest::AddEvent (Time duration, double power, bool receive)
+{
+  Ptr<InterferenceHelper::Event> event = m_helper.Add (1000, m_txVector, WIFI_PREAMBLE_LONG, duration, power);
+  Reference reference;
+  reference.start = Simulator::Now ();
+  reference.end = Simulator::Now () + duration;
+  reference.power = power;
+  m_references.push_back (reference);
+  if (receive)
+    {
+      m_rxEvent = event;
+      m_rxIndex = m_references.size () - 1;
+      m_helper.NotifyRxStart ();
+    }
+}
+
+double
+InterferenceHelperRunningPowerTest::GetPower (Time at, uint32_t exclude) const
+{
+  double power = 0.0;
+  for (uint32_t i = 0; i < m_references.size (); i++)
+    {
+      if (i != exclude && m_references[i].start <= at && at < m_references[i].end)
+        {
+          power += m_references[i].power;
+        }
+    }
+  return power;
+}
+
+double
+InterferenceHelperRunningPowerTest::GetSnr (double signal, double noiseInterference, WifiMode mode) const
+{
+  double noiseFloor = m_helper.GetNoiseFigure () * 1.3803e-23 * 290.0 * mode.GetBandwidth ();
+  return signal / (noiseFloor + noiseInterference);
+}
+
+void
+InterferenceHelperRunningPowerTest::CheckReception (void)
+{
+  const Reference &rx = m_references[m_rxIndex];
+  WifiMode mode = m_txVector.GetMode ();
+  WifiMode headerMode = WifiPhy::GetPlcpHeaderMode (mode, WIFI_PREAMBLE_LONG);
+  Time payloadStart = rx.start + WifiPhy::GetPlcpPreambleDuration (mode, WIFI_PREAMBLE_LONG)
+    + WifiPhy::GetPlcpHeaderDuration (mode, WIFI_PREAMBLE_LONG);
+
+  //the interference changes at every start and end of another event
+  std::vector<Time> changes;
+  changes.push_back (rx.start);
+  for (uint32_t i = 0; i < m_references.size (); i++)
+    {
+      if (i == m_rxIndex)
+        {
+          continue;
+        }
+      if (m_references[i].start > rx.start && m_references[i].start < rx.end)
+        {
+          changes.push_back (m_references[i].start);
+        }
+      if (m_references[i].end > rx.start && m_references[i].end < rx.end)
+        {
+          changes.push_back (m_references[i].end);
+        }
+    }
+  std::sort (changes.begin (), changes.end ());
+  changes.push_back (rx.end);
+
+  double psr = 1.0;
+  for (uint32_t i = 0; i + 1 < changes.size (); i++)
+    {
+      Time previous = std::max (changes[i], payloadStart);
+      if (changes[i + 1] <= previous)
+        {
+          continue;
+        }
+      double snr = GetSnr (rx.power, GetPower (changes[i], m_rxIndex), mode);
+      uint64_t nbits = (uint64_t)(mode.GetPhyRate () * (changes[i + 1] - previous).GetSeconds ());
+      psr *= m_errorRateModel->GetChunkSuccessRate (mode, snr, (uint32_t)nbits);
+    }
+
+  InterferenceHelper::SnrPer payload = m_helper.CalculatePlcpPayloadSnrPer (m_rxEvent);
+  double snr = GetSnr (rx.power, GetPower (rx.start, m_rxIndex), mode);
+  NS_TEST_ASSERT_MSG_EQ_TOL (payload.snr, snr, snr * 1e-9, "wrong payload SNR");
+  NS_TEST_ASSERT_MSG_EQ_TOL (payload.per, 1 - psr, 1e-12, "wrong payload PER");
+  InterferenceHelper::SnrPer header = m_helper.CalculatePlcpHeaderSnrPer (m_rxEvent);
+  snr = GetSnr (rx.power, GetPower (rx.start, m_rxIndex), headerMode);
+  NS_TEST_ASSERT_MSG_EQ_TOL (header.snr, snr, snr * 1e-9, "wrong header SNR");
+  m_helper.NotifyRxEnd ();
+  m_rxEvent = 0;
+  m_nChecks++;
+}
+
+void
+InterferenceHelperRunningPowerTest::CheckEnergyDuration (double energyW)
+{
+  Time now = Simulator::Now ();
+  std::vector<Time> changes;
+  for (uint32_t i = 0; i < m_references.size (); i++)
+    {
+      changes.push_back (m_references[i].start);
+      changes.push_back (m_references[i].end);
+    }
+  std::sort (changes.begin (), changes.end ());
+  Time end = changes.back ();
+  for (uint32_t i = 0; i < changes.size (); i++)
+    {
+      if (changes[i] >= now && GetPower (changes[i], m_references.size ()) < energyW)
+        {
+          end = changes[i];
+          break;
+        }
+    }
+  Time expected = end > now ? end - now : MicroSeconds (0);
+  NS_TEST_ASSERT_MSG_EQ (m_helper.GetEnergyDuration (energyW), expected, "wrong energy duration");
+  m_nChecks++;
+}
+
+void
+InterferenceHelperRunningPowerTest::DoRun (void)
+{
+  m_errorRateModel = CreateObject<NistErrorRateModel> ();
+  m_helper.SetErrorRateModel (m_errorRateModel);
+  m_helper.SetNoiseFigure (5.0);
+  m_txVector.SetMode (WifiPhy::GetOfdmRate6Mbps ());
+
+  //an event received over two interferers, one of them shorter
+  Simulator::Schedule (MicroSeconds (0), &InterferenceHelperRunningPowerTest::AddEvent, this, MicroSeconds (300), 1e-9, false);
+  Simulator::Schedule (MicroSeconds (50), &InterferenceHelperRunningPowerTest::AddEvent, this, MicroSeconds (400), 20e-9, true);
+  Simulator::Schedule (MicroSeconds (120), &InterferenceHelperRunningPowerTest::AddEvent, this, MicroSeconds (100), 8e-9, false);
+  Simulator::Schedule (MicroSeconds (200), &InterferenceHelperRunningPowerTest::CheckEnergyDuration, this, 22e-9);
+  Simulator::Schedule (MicroSeconds (200), &InterferenceHelperRunningPowerTest::CheckEnergyDuration, this, 20.5e-9);
+  Simulator::Schedule (MicroSeconds (200), &InterferenceHelperRunningPowerTest::CheckEnergyDuration, this, 1e-10);
+  //an interferer starting before the end of the reception and lasting after it
+  Simulator::Schedule (MicroSeconds (440), &InterferenceHelperRunningPowerTest::AddEvent, this, MicroSeconds (100), 3e-9, false);
+  Simulator::Schedule (MicroSeconds (450), &InterferenceHelperRunningPowerTest::CheckReception, this);
+  //the changes before now are dropped outside of a reception
+  Simulator::Schedule (MicroSeconds (460), &InterferenceHelperRunningPowerTest::CheckEnergyDuration, this, 1e-9);
+  Simulator::Schedule (MicroSeconds (460), &InterferenceHelperRunningPowerTest::CheckEnergyDuration, this, 4e-9);
+  //a reception starting over that interferer
+  Simulator::Schedule (MicroSeconds (470), &InterferenceHelperRunningPowerTest::AddEvent, this, MicroSeconds (200), 20e-9, true);
+  Simulator::Schedule (MicroSeconds (500), &InterferenceHelperRunningPowerTest::AddEvent, this, MicroSeconds (50), 5.5e-9, false);
+  Simulator::Schedule (MicroSeconds (520), &InterferenceHelperRunningPowerTest::CheckEnergyDuration, this, 21.5e-9);
+  Simulator::Schedule (MicroSeconds (670), &InterferenceHelperRunningPowerTest::CheckReception, this);
+  Simulator::Schedule (MicroSeconds (700), &InterferenceHelperRunningPowerTest::CheckEnergyDuration, this, 1e-9);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_nChecks, 9, "not all the checks were run");
+  m_errorRateModel = 0;
+}
+
+/**
+ * InterferenceHelper test suite
+ */
+class InterferenceHelperTestSuite : public TestSuite
+{
+public:
+  InterferenceHelperTestSuite ();
+};
+
+InterferenceHelperTestSuite::InterferenceHelperTestSuite ()
+  : TestSuite ("wifi-interference-helper", UNIT)
+{
+  AddTestCase (new InterferenceHelperRunningPowerTest, TestCase::QUICK);
+}
+
+static InterferenceHelperTestSuite g_interferenceHelperTestSuite;
@@ -0,0 +1,169 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <sstream>
+#include "ns3/log.h"
+#include "ns3/test.h"
+#include "ns3/raw-group-optimizer.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("RawGroupOptimizerTest");
+
+/**
+ * Check the groupings computed by RawGroupOptimizer.
+ */
+class RawGroupOptimizerTest : public TestCase
+{
+public:
+  RawGroupOptimizerTest ();
+  virtual ~RawGroupOptimizerTest ();
+  virtual void DoRun (void);
+
+
+private:
+  /**
+   * Check that the RAW groups of a grouping are contiguous and cover
+   * the AIDs from first to last.
+   *
+   * \param rpsv the grouping
+   * \param first the first AID
+   * \param last the last AID
+   */
+  void CheckCoverage (const RPSVector &rpsv, uint16_t first, uint16_t last);
+  /**
+   * Delete the RPS elements of a grouping.
+   *
+   * \param rpsv the grouping
+   */
+  void Release (RPSVector &rpsv);
+};
+
+RawGroupOptimizerTest::RawGroupOptimizerTest ()
+  : TestCase ("Check RAW groupings of RawGroupOptimizer")
+{
+}
+
+RawGroupOptimizerTest::~RawGroupOptimizerTest ()
+{
+}
+
+void
+RawGroupOptimizerTest::CheckCoverage (const RPSVector &rpsv, uint16_t first, uint16_t last)
+{
+  NS_TEST_ASSERT_MSG_EQ (rpsv.rpsset.size (), 1, "a single RPS is expected");
+  RPS *rps = rpsv.rpsset[0];
+  uint16_t next = first;
+  uint64_t duration = 0;
+  for (uint32_t i = 0; i < rps->GetNumberOfRawGroups (); i++)
+    {
+      RPS::RawAssignment raw = rps->GetRawAssigmentObj (i);
+      NS_TEST_ASSERT_MSG_EQ (raw.GetRawGroupAIDStart (), next, "groups are not contiguous");
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (raw.GetRawGroupAIDEnd (), raw.GetRawGroupAIDStart (), "empty group");
+      next = raw.GetRawGroupAIDEnd () + 1;
+      duration += 500 + 120 * raw.GetSlotDurationCount ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (next, last + 1, "groups do not cover all stations");
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (duration, 102400, "RAW groups longer than the beacon interval");
+}
+
+void
+RawGroupOptimizerTest::Release (RPSVector &rpsv)
+{
+  for (RPSVector::RPSlist::iterator it = rpsv.rpsset.begin (); it != rpsv.rpsset.end (); ++it)
+    {
+      delete *it;
+    }
+  rpsv.rpsset.clear ();
+}
+
+void
+RawGroupOptimizerTest::DoRun (void)
+{
+  RawGroupOptimizer optimizer;
+  optimizer.SetBeaconInterval (102400);
+  optimizer.SetTransmissionDuration (2000);
+
+  //a few light stations: no need to split them
+  for (uint16_t aid = 1; aid <= 5; aid++)
+    {
+      optimizer.AddStation (aid, 0.1);
+    }
+  RPSVector rpsv = optimizer.Optimize ();
+  CheckCoverage (rpsv, 1, 5);
+  NS_TEST_ASSERT_MSG_EQ (optimizer.GetNGroups (), 1, "light load should use a single group");
+  NS_TEST_ASSERT_MSG_EQ_TOL (optimizer.GetExpectedSuccesses (), 0.5, 1e-9, "all packets should be delivered");
+  Release (rpsv);
+
+  //many saturated stations: splitting them reduces collisions
+  optimizer.Clear ();
+  for (uint16_t aid = 1; aid <= 200; aid++)
+    {
+      optimizer.AddStation (aid, 1.0);
+    }
+  rpsv = optimizer.Optimize ();
+  CheckCoverage (rpsv, 1, 200);
+  NS_TEST_ASSERT_MSG_GT (optimizer.GetNGroups (), 1, "heavy load should use several groups");
+  double single = RawGroupOptimizer::GetSlotSuccesses (200, 200 * (1 - std::exp (-1.0)), 102400 - 2200 - 160, 2000, 52, 15);
+  NS_TEST_ASSERT_MSG_GT (optimizer.GetExpectedSuccesses (), single, "grouping should beat a single group");
+  Release (rpsv);
+
+  //stations added out of order, with one heavy station
+  optimizer.Clear ();
+  for (uint16_t aid = 40; aid >= 11; aid--)
+    {
+      optimizer.AddStation (aid, aid == 20 ? 10.0 : 0.5);
+    }
+  rpsv = optimizer.Optimize ();
+  CheckCoverage (rpsv, 11, 40);
+
+  //the configuration file can be read back by the simulation scripts
+  std::ostringstream os;
+  RawGroupOptimizer::PrintRawConfig (os, rpsv);
+  std::istringstream is (os.str ());
+  uint32_t nRps, nRaw;
+  is >> nRps >> nRaw;
+  NS_TEST_ASSERT_MSG_EQ (nRps, 1, "wrong number of RPS");
+  NS_TEST_ASSERT_MSG_EQ (nRaw, optimizer.GetNGroups (), "wrong number of RAW groups");
+  uint32_t control, cross, format, count, slots, page, start, end;
+  is >> control >> cross >> format >> count >> slots >> page >> start >> end;
+  NS_TEST_ASSERT_MSG_EQ (start, 11, "wrong first AID");
+  NS_TEST_ASSERT_MSG_EQ (count, rpsv.rpsset[0]->GetRawAssigmentObj (0).GetSlotDurationCount (), "wrong slot duration count");
+  Release (rpsv);
+
+  //no station, no RPS
+  optimizer.Clear ();
+  rpsv = optimizer.Optimize ();
+  NS_TEST_ASSERT_MSG_EQ (rpsv.rpsset.size (), 0, "no RPS expected without stations");
+}
+
+/**
+ * RAW group optimizer test suite
+ */
+class RawGroupOptimizerTestSuite : public TestSuite
+{
+public:
+  RawGroupOptimizerTestSuite ();
+};
+
+RawGroupOptimizerTestSuite::RawGroupOptimizerTestSuite ()
+  : TestSuite ("wifi-raw-group-optimizer", UNIT)
+{
+  AddTestCase (new RawGroupOptimizerTest, TestCase::QUICK);
+}
+
+static RawGroupOptimizerTestSuite g_rawGroupOptimizerTestSuite;
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/raw-schedule.h"
+#include "ns3/extension-headers.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * Check the RAW slots decoded by RawSchedule.
+ */
+class RawScheduleTest : public TestCase
+{
+public:
+  RawScheduleTest ();
+  virtual ~RawScheduleTest ();
+  virtual void DoRun (void);
+};
+
+RawScheduleTest::RawScheduleTest ()
+  : TestCase ("Check RAW slots decoded by RawSchedule")
+{
+}
+
+RawScheduleTest::~RawScheduleTest ()
+{
+}
+
+void
+RawScheduleTest::DoRun (void)
+{
+  //AIDs 1-10 (2 slots), 11-30 (3 slots), 5-8 again (page 1, 1 slot)
+  uint32_t aidStart[] = {1, 11, 5};
+  uint32_t aidEnd[] = {10, 30, 8};
+  uint32_t page[] = {0, 0, 1};
+  uint32_t slotNum[] = {2, 3, 1};
+  uint32_t count[] = {10, 20, 30};
+  RPS rps;
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      RPS::RawAssignment raw;
+      raw.SetRawControl (0);
+      raw.SetSlotCrossBoundary (i == 1 ? 1 : 0);
+      raw.SetSlotFormat (1);
+      raw.SetSlotDurationCount (count[i]);
+      raw.SetSlotNum (slotNum[i]);
+      raw.SetRawGroup ((aidEnd[i] << 13) | (aidStart[i] << 2) | page[i]);
+      rps.SetRawAssignment (raw);
+    }
+
+  Ptr<const RawSchedule> schedule = RawSchedule::Get (rps);
+  NS_TEST_ASSERT_MSG_EQ (schedule->GetNGroups (), 3, "wrong number of RAW groups");
+  //2 * 1700 + 3 * 2900 + 1 * 4100 us
+  NS_TEST_ASSERT_MSG_EQ (schedule->GetDuration (), MicroSeconds (16200), "wrong RAW duration");
+  NS_TEST_ASSERT_MSG_EQ (schedule->GetGroup (1).start, MicroSeconds (3400), "wrong RAW start");
+  NS_TEST_ASSERT_MSG_EQ (schedule->GetGroup (1).crossBoundary, true, "wrong cross slot boundary");
+  NS_TEST_ASSERT_MSG_EQ (schedule->GetGroup (2).slotDuration, MicroSeconds (4100), "wrong slot duration");
+
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) schedule->GetFirstGroup (6), 0, "AID 6 is first in RAW 0");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) schedule->GetFirstGroup (20), 1, "AID 20 is first in RAW 1");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) schedule->GetFirstGroup (31), RawSchedule::NO_GROUP, "AID 31 is in no RAW");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) schedule->GetLastGroupInPage (6), 0, "AID 6 of page 0 is in RAW 0");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) schedule->GetLastGroupInPage (2048 | 6), 2, "AID 6 of page 1 is in RAW 2");
+  NS_TEST_ASSERT_MSG_EQ ((uint32_t) schedule->GetLastGroupInPage (2048 | 20), RawSchedule::NO_GROUP, "AID 20 of page 1 is in no RAW");
+
+  //the same RPS elements share their schedule
+  RPS copy = rps;
+  NS_TEST_ASSERT_MSG_EQ (RawSchedule::Get (copy), schedule, "schedule not shared");
+  //copies own their RAW assignments
+  RPS *original = new RPS (rps);
+  RPS copyOfCopy = *original;
+  delete original;
+  NS_TEST_ASSERT_MSG_EQ (RawSchedule::Get (copyOfCopy), schedule, "copy depends on its original");
+
+  //a received beacon decodes to the same schedule
+  S1gBeaconHeader beacon;
+  TIM tim;
+  tim.SetDTIMCount (1); //no page slice element
+  tim.SetDTIMPeriod (2);
+  tim.SetBitmapControl (0);
+  beacon.SetTIM (tim);
+  AuthenticationCtrl auth;
+  auth.SetControlType (false);
+  auth.SetThreshold (100);
+  beacon.SetAuthCtrl (auth);
+  beacon.SetRPS (rps);
+  Ptr<Packet> packet = Create<Packet> ();
+  packet->AddHeader (beacon);
+  S1gBeaconHeader received;
+  packet->RemoveHeader (received);
+  NS_TEST_ASSERT_MSG_EQ (received.GetRawSchedule (), schedule, "wrong schedule of the received beacon");
+  NS_TEST_ASSERT_MSG_EQ (received.GetRawSchedule (), received.GetRawSchedule (), "schedule decoded twice");
+
+  //the schedules only depend on the RPS element, so they outlive the simulation
+  Simulator::Destroy ();
+  NS_TEST_ASSERT_MSG_EQ (RawSchedule::Get (rps), schedule, "schedule not kept by the thread");
+}
+
+/**
+ * RAW schedule test suite
+ */
+class RawScheduleTestSuite : public TestSuite
+{
+public:
+  RawScheduleTestSuite ();
+};
+
+RawScheduleTestSuite::RawScheduleTestSuite ()
+  : TestSuite ("wifi-raw-schedule", UNIT)
+{
+  AddTestCase (new RawScheduleTest, TestCase::QUICK);
+}
+
+static RawScheduleTestSuite g_rawScheduleTestSuite;
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/s1g-raw-control.h"
+
+using namespace ns3;
+
+/**
+ * Check the sensor bookkeeping of S1gRawCtr: station lookups, received
+ * packet counts and removal of the disassociated stations.
+ */
+class S1gRawCtrSensorUpdateTest : public TestCase
+{
+public:
+  S1gRawCtrSensorUpdateTest ();
+  virtual ~S1gRawCtrSensorUpdateTest ();
+  virtual void DoRun (void);
+};
+
+S1gRawCtrSensorUpdateTest::S1gRawCtrSensorUpdateTest ()
+  : TestCase ("Check sensor updates of S1gRawCtr")
+{
+}
+
+S1gRawCtrSensorUpdateTest::~S1gRawCtrSensorUpdateTest ()
+{
+}
+
+void
+S1gRawCtrSensorUpdateTest::DoRun (void)
+{
+  std::string path = CreateTempDirFilename ("sensor-");
+  S1gRawCtr ctr;
+  uint16_t sensors[] = {1, 2, 3};
+  ctr.UdpateSensorStaInfo (std::vector<uint16_t> (sensors, sensors + 3), std::vector<uint16_t> (), path);
+  NS_TEST_ASSERT_MSG_EQ (ctr.m_stations.size (), 3, "wrong number of sensors");
+  NS_TEST_ASSERT_MSG_NE (ctr.LookupSensorSta (2), 0, "sensor 2 not found");
+  NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (4), 0, "unknown sensor found");
+
+  //1 and 2 allowed to send, two packets received from 1 and one from 3
+  ctr.m_aidList.push_back (1);
+  ctr.m_aidList.push_back (2);
+  uint16_t received[] = {1, 3, 1};
+  ctr.UdpateSensorStaInfo (std::vector<uint16_t> (sensors, sensors + 3), std::vector<uint16_t> (received, received + 3), path);
+  NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (1)->GetTransmissionSuccess (), true, "sensor 1 not received");
+  NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (1)->GetNumPacketsReceived (), 2, "wrong packet count of sensor 1");
+  NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (2)->GetTransmissionSuccess (), false, "sensor 2 received");
+  NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (2)->GetNumPacketsReceived (), 0, "wrong packet count of sensor 2");
+  NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (3)->GetTransmissionSuccess (), true, "sensor 3 not received");
+  NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (3)->GetNumPacketsReceived (), 1, "wrong packet count of sensor 3");
+  NS_TEST_ASSERT_MSG_EQ (ctr.m_aidList.size (), 3, "sensor 3 not added to the senders");
+
+  //2 disassociated
+  ctr.m_aidList.clear ();
+  uint16_t remaining[] = {1, 3};
+  ctr.UdpateSensorStaInfo (std::vector<uint16_t> (remaining, remaining + 2), std::vector<uint16_t> (), path);
+  NS_TEST_ASSERT_MSG_EQ (ctr.m_stations.size (), 2, "disassociated sensor not removed");
+  NS_TEST_ASSERT_MSG_EQ (ctr.LookupSensorSta (2), 0, "disassociated sensor found");
+  NS_TEST_ASSERT_MSG_NE (ctr.LookupSensorSta (3), 0, "sensor 3 not found");
+}
+
+/**
+ * S1G RAW control test suite
+ */
+class S1gRawCtrTestSuite : public TestSuite
+{
+public:
+  S1gRawCtrTestSuite ();
+};
+
+S1gRawCtrTestSuite::S1gRawCtrTestSuite ()
+  : TestSuite ("wifi-s1g-raw-control", UNIT)
+{
+  AddTestCase (new S1gRawCtrSensorUpdateTest, TestCase::QUICK);
+}
+
+static S1gRawCtrTestSuite g_s1gRawCtrTestSuite;
@@ -0,0 +1,159 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <vector>
+#include "ns3/test.h"
+#include "ns3/yans-wifi-phy.h"
+
+using namespace ns3;
+
+/**
+ * Check that the transmission durations cached by a PHY stay right when
+ * the calls alternate between parameters which only differ by the
+ * preamble, the spatial streams, STBC, the band or the S1G mode, so that
+ * two of them sharing a cache entry would be caught.
+ */
+class TxDurationCacheTest : public TestCase
+{
+public:
+  TxDurationCacheTest ();
+  virtual ~TxDurationCacheTest ();
+  virtual void DoRun (void);
+
+private:
+  /// Parameters of a transmission duration
+  struct Transmission
+  {
+    uint32_t size;          //!< size of the frame (bytes)
+    WifiTxVector txVector;  //!< TXVECTOR of the frame
+    WifiPreamble preamble;  //!< preamble of the frame
+    double frequency;       //!< channel center frequency (MHz)
+    Time duration;          //!< duration computed by a PHY without cached durations
+  };
+
+  /**
+   * Add a transmission to check.
+   *
+   * \param size the size of the frame (bytes)
+   * \param mode the mode of the frame
+   * \param nss the number of spatial streams
+   * \param stbc whether STBC is used
+   * \param preamble the preamble of the frame
+   * \param frequency the channel center frequency (MHz)
+   *
+   * \return the duration of the transmission
+   */
+  Time Add (uint32_t size, WifiMode mode, uint8_t nss, bool stbc, WifiPreamble preamble, double frequency);
+
+  std::vector<Transmission> m_transmissions; //!< the transmissions to check
+};
+
+TxDurationCacheTest::TxDurationCacheTest ()
+  : TestCase ("Check cached transmission durations of alternating parameters")
+{
+}
+
+TxDurationCacheTest::~TxDurationCacheTest ()
+{
+}
+
+Time
+TxDurationCacheTest::Add (uint32_t size, WifiMode mode, uint8_t nss, bool stbc, WifiPreamble preamble, double frequency)
+{
+  Transmission transmission;
+  transmission.size = size;
+  transmission.txVector = WifiTxVector (mode, 0, 0, false, nss, 0, stbc);
+  transmission.preamble = preamble;
+  transmission.frequency = frequency;
+  //a new PHY has no cached duration yet
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  transmission.duration = phy->CalculateTxDuration (size, transmission.txVector, preamble, frequency, 0, 0);
+  m_transmissions.push_back (transmission);
+  return transmission.duration;
+}
+
+void
+TxDurationCacheTest::DoRun (void)
+{
+  static const double CHANNEL_1_MHZ = 2412.0;
+  static const double CHANNEL_36_MHZ = 5180.0;
+  static const double S1G_MHZ = 900.0;
+  uint32_t sizes[] = {14, 1500};
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      uint32_t size = sizes[i];
+      //preambles of DSSS
+      Time dsssLong = Add (size, WifiPhy::GetDsssRate11Mbps (), 1, false, WIFI_PREAMBLE_LONG, CHANNEL_1_MHZ);
+      Time dsssShort = Add (size, WifiPhy::GetDsssRate11Mbps (), 1, false, WIFI_PREAMBLE_SHORT, CHANNEL_1_MHZ);
+      NS_TEST_EXPECT_MSG_NE (dsssLong, dsssShort, "preambles of the same duration");
+      Add (size, WifiPhy::GetOfdmRate6Mbps (), 1, false, WIFI_PREAMBLE_LONG, CHANNEL_36_MHZ);
+      Add (size, WifiPhy::GetOfdmRate54Mbps (), 1, false, WIFI_PREAMBLE_LONG, CHANNEL_36_MHZ);
+      //HT preambles, spatial streams, STBC and bands
+      WifiMode ht = WifiPhy::GetOfdmRate6_5MbpsBW20MHz ();
+      Time mf = Add (size, ht, 1, false, WIFI_PREAMBLE_HT_MF, CHANNEL_36_MHZ);
+      Time gf = Add (size, ht, 1, false, WIFI_PREAMBLE_HT_GF, CHANNEL_36_MHZ);
+      Time mf2 = Add (size, ht, 2, false, WIFI_PREAMBLE_HT_MF, CHANNEL_36_MHZ);
+      Time mfStbc = Add (size, ht, 1, true, WIFI_PREAMBLE_HT_MF, CHANNEL_36_MHZ);
+      Time mf24 = Add (size, ht, 1, false, WIFI_PREAMBLE_HT_MF, CHANNEL_1_MHZ);
+      Add (size, ht, 2, true, WIFI_PREAMBLE_HT_GF, CHANNEL_1_MHZ);
+      NS_TEST_EXPECT_MSG_NE (mf, gf, "HT preambles of the same duration");
+      NS_TEST_EXPECT_MSG_NE (mf, mf2, "spatial streams of the same duration");
+      NS_TEST_EXPECT_MSG_NE (mf, mfStbc, "STBC of the same duration");
+      NS_TEST_EXPECT_MSG_NE (mf, mf24, "bands of the same duration");
+      //S1G modes and preambles
+      Time s1g1m = Add (size, WifiPhy::GetOfdmRate300KbpsBW1MHz (), 1, false, WIFI_PREAMBLE_S1G_1M, S1G_MHZ);
+      Time s1gShort = Add (size, WifiPhy::GetOfdmRate650KbpsBW2MHz (), 1, false, WIFI_PREAMBLE_S1G_SHORT, S1G_MHZ);
+      Time s1gLong = Add (size, WifiPhy::GetOfdmRate650KbpsBW2MHz (), 1, false, WIFI_PREAMBLE_S1G_LONG, S1G_MHZ);
+      Add (size, WifiPhy::GetOfdmRate650KbpsBW2MHz (), 2, false, WIFI_PREAMBLE_S1G_SHORT, S1G_MHZ);
+      Add (size, WifiPhy::GetOfdmRate1_3MbpsBW2MHz (), 1, false, WIFI_PREAMBLE_S1G_SHORT, S1G_MHZ);
+      NS_TEST_EXPECT_MSG_NE (s1gShort, s1gLong, "S1G preambles of the same duration");
+      NS_TEST_EXPECT_MSG_NE (s1g1m, s1gShort, "S1G modes of the same duration");
+    }
+
+  //the calls of a single PHY alternate between all the transmissions,
+  //in order, in reverse order and then in order again
+  Ptr<YansWifiPhy> phy = CreateObject<YansWifiPhy> ();
+  uint32_t n = m_transmissions.size ();
+  for (uint32_t round = 0; round < 3; round++)
+    {
+      for (uint32_t i = 0; i < n; i++)
+        {
+          const Transmission &t = m_transmissions[round == 1 ? n - 1 - i : i];
+          Time duration = phy->CalculateTxDuration (t.size, t.txVector, t.preamble, t.frequency, 0, 0);
+          NS_TEST_EXPECT_MSG_EQ (duration, t.duration, "wrong cached duration of " << t.size << " bytes, mode "
+                                 << t.txVector.GetMode () << ", nss " << (uint32_t) t.txVector.GetNss ()
+                                 << ", stbc " << t.txVector.IsStbc () << ", preamble " << t.preamble
+                                 << ", " << t.frequency << " MHz, round " << round);
+        }
+    }
+}
+
+/**
+ * Transmission duration cache test suite
+ */
+class TxDurationCacheTestSuite : public TestSuite
+{
+public:
+  TxDurationCacheTestSuite ();
+};
+
+TxDurationCacheTestSuite::TxDurationCacheTestSuite ()
+  : TestSuite ("wifi-tx-duration-cache", UNIT)
+{
+  AddTestCase (new TxDurationCacheTest, TestCase::QUICK);
+}
+
+static TxDurationCacheTestSuite g_txDurationCacheTestSuite;
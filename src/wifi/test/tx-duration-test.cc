@@ -143,6 +143,15 @@ TxDurationTest::CheckTxDuration (uint32_t size, WifiMode payloadMode, WifiPreamb
                 << std::endl;
       return false;
     }
+  //Second computation is served by the duration cache of the PHY
+  if (((double)phy->CalculateTxDuration (size, txVector, preamble, testedFrequency, 0, 0).GetNanoSeconds ()) / 1000 != calculatedDurationMicroSeconds)
+    {
+      std::cerr << " size=" << size
+                << " mode=" << payloadMode
+                << " preamble=" << preamble
+                << " cached duration differs" << std::endl;
+      return false;
+    }
   if (payloadMode.GetModulationClass () == WIFI_MOD_CLASS_HT)
     {
       //Durations vary depending on frequency; test also 2.4 GHz (bug 1971)
@@ -0,0 +1,110 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/wifi-mac-queue.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+
+using namespace ns3;
+
+/**
+ * Check the per-receiver packet counts of WifiMacQueue used to build the
+ * TIM, including when packets expire.
+ */
+class WifiMacQueueReceiverCountTest : public TestCase
+{
+public:
+  WifiMacQueueReceiverCountTest ();
+  virtual ~WifiMacQueueReceiverCountTest ();
+  virtual void DoRun (void);
+
+private:
+  /// Check the counts once the packets have expired
+  void CheckExpired (void);
+
+  Ptr<WifiMacQueue> m_queue; //!< the queue under test
+  Mac48Address m_a;          //!< first receiver
+  Mac48Address m_b;          //!< second receiver
+};
+
+WifiMacQueueReceiverCountTest::WifiMacQueueReceiverCountTest ()
+  : TestCase ("Check per-receiver packet counts of WifiMacQueue"),
+    m_a ("00:00:00:00:00:01"),
+    m_b ("00:00:00:00:00:02")
+{
+}
+
+WifiMacQueueReceiverCountTest::~WifiMacQueueReceiverCountTest ()
+{
+}
+
+void
+WifiMacQueueReceiverCountTest::CheckExpired (void)
+{
+  NS_TEST_ASSERT_MSG_EQ (m_queue->HasPacketsTo (m_a), false, "expired packet to A still counted");
+  NS_TEST_ASSERT_MSG_EQ (m_queue->GetNPacketsTo (m_b), 1, "packet to B expired too early");
+}
+
+void
+WifiMacQueueReceiverCountTest::DoRun (void)
+{
+  m_queue = CreateObject<WifiMacQueue> ();
+  m_queue->SetMaxDelay (MilliSeconds (10));
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_DATA);
+  hdr.SetAddr1 (m_a);
+  m_queue->Enqueue (Create<Packet> (10), hdr);
+  m_queue->Enqueue (Create<Packet> (10), hdr);
+  hdr.SetAddr1 (m_b);
+  Ptr<Packet> toB = Create<Packet> (10);
+  m_queue->Enqueue (toB, hdr);
+  NS_TEST_ASSERT_MSG_EQ (m_queue->GetNPacketsTo (m_a), 2, "wrong number of packets to A");
+  NS_TEST_ASSERT_MSG_EQ (m_queue->GetNPacketsTo (m_b), 1, "wrong number of packets to B");
+
+  WifiMacHeader dequeuedHdr;
+  m_queue->Dequeue (&dequeuedHdr);
+  NS_TEST_ASSERT_MSG_EQ (m_queue->GetNPacketsTo (m_a), 1, "dequeued packet still counted");
+  m_queue->Remove (toB);
+  NS_TEST_ASSERT_MSG_EQ (m_queue->HasPacketsTo (m_b), false, "removed packet still counted");
+
+  //the packet to A expires at 10 ms, the one pushed back to B at 15 ms
+  Simulator::Schedule (MilliSeconds (5), &WifiMacQueue::PushFront, m_queue, toB, hdr);
+  Simulator::Schedule (MilliSeconds (12), &WifiMacQueueReceiverCountTest::CheckExpired, this);
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  m_queue->Flush ();
+  NS_TEST_ASSERT_MSG_EQ (m_queue->HasPacketsTo (m_b), false, "flushed packet still counted");
+  m_queue = 0;
+}
+
+/**
+ * WifiMacQueue test suite
+ */
+class WifiMacQueueTestSuite : public TestSuite
+{
+public:
+  WifiMacQueueTestSuite ();
+};
+
+WifiMacQueueTestSuite::WifiMacQueueTestSuite ()
+  : TestSuite ("wifi-mac-queue", UNIT)
+{
+  AddTestCase (new WifiMacQueueReceiverCountTest, TestCase::QUICK);
+}
+
+static WifiMacQueueTestSuite g_wifiMacQueueTestSuite;
@@ -23,6 +23,7 @@
 #include <iostream>
 #include <sstream>
 #include <string>
+#include <vector>
 #include <stdlib.h> // for exit ()
 
 using namespace ns3;
@@ -254,6 +255,75 @@ benchC (uint32_t n)
 }
 
 
+static void
+benchE (uint32_t n)
+{
+  BenchHeader<13> mac;
+  BenchTag<4> tag;
+  uint8_t payload[20] = {0};
+
+  // a LoRa uplink: small payload, received by 4 gateways
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (payload, sizeof (payload));
+    p->AddHeader (mac);
+    p->AddPacketTag (tag);
+    for (uint32_t j = 0; j < 4; j++) {
+      Ptr<Packet> o = p->Copy ();
+      o->RemovePacketTag (tag);
+      o->RemoveHeader (mac);
+    }
+  }
+}
+
+static void
+benchF (uint32_t n)
+{
+  BenchHeader<26> mac;
+  BenchHeader<8> llc;
+  BenchHeader<20> ipv4;
+  BenchHeader<8> udp;
+  BenchTag<16> tag;
+
+  // a Wi-Fi frame with a 100 bytes payload, received by 1 station
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (100);
+    p->AddHeader (udp);
+    p->AddHeader (ipv4);
+    p->AddHeader (llc);
+    p->AddHeader (mac);
+    p->AddPacketTag (tag);
+    Ptr<Packet> o = p->Copy ();
+    o->RemovePacketTag (tag);
+    o->RemoveHeader (mac);
+    o->RemoveHeader (llc);
+    o->RemoveHeader (ipv4);
+    o->RemoveHeader (udp);
+  }
+}
+
+
+static void
+benchG (uint32_t n)
+{
+  BenchHeader<13> mac;
+  BenchTag<4> tag;
+  std::vector<Ptr<Packet> > queue (1000);
+
+  // small packets, 1000 of them in flight in a queue
+  for (uint32_t i = 0; i < n; i++) {
+    Ptr<Packet> p = Create<Packet> (20);
+    p->AddHeader (mac);
+    p->AddPacketTag (tag);
+    Ptr<Packet> &queued = queue[i % queue.size ()];
+    if (queued) {
+      queued->RemovePacketTag (tag);
+      queued->RemoveHeader (mac);
+    }
+    queued = p->Copy ();
+  }
+}
+
+
 static void
 runBench (void (*bench) (uint32_t), uint32_t n, char const *name)
 {
@@ -301,6 +371,9 @@ int main (int argc, char *argv[])
   runBench (&benchB, n, "Just add headers");
   runBench (&benchC, n, "Remove by func call");
   runBench (&benchD, n, "Intermixed add/remove headers and tags");
+  runBench (&benchE, n, "Small packet copied to 4 receivers");
+  runBench (&benchF, n, "Small frame, add/remove 4 headers and a tag");
+  runBench (&benchG, n, "Small packets, 1000 in flight");
 
   return 0;
 }
@@ -0,0 +1,40 @@
+#!/usr/bin/env bash
+#
+# This program is free software; you can redistribute it and/or modify
+# it under the terms of the GNU General Public License version 2 as
+# published by the Free Software Foundation;
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program; if not, write to the Free Software
+# Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+#
+
+#
+# Capture the delays of the events scheduled by a program, to replay
+# them against every scheduler with bench-simulator:
+#
+#   ./waf shell
+#   utils/capture-event-times.sh "complete-network-interference" > lora.txt
+#   utils/capture-event-times.sh "test --simulationTime=10" > s1g.txt
+#   build/utils/ns3-dev-bench-simulator-debug --file=lora.txt --all
+#
+# The program is run through waf with the DefaultSimulatorImpl function
+# logs enabled, so it needs a debug build and the default time
+# resolution (ns). The delays are printed in seconds, one per line.
+#
+
+if [ $# -ne 1 ]; then
+  echo "usage: $(basename $0) \"<program> [arguments]\"" >&2
+  exit 1
+fi
+
+cd $(dirname $0)/..
+NS_LOG="DefaultSimulatorImpl=level_function" ./waf --run "$1" 2>&1 >/dev/null |
+  awk -F '[(,)]' '
+    /DefaultSimulatorImpl:Schedule\(/            { printf "%.9f\n", $3 / 1e9 }
+    /DefaultSimulatorImpl:ScheduleWithContext\(/ { printf "%.9f\n", $4 / 1e9 }'
@@ -0,0 +1,234 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+/*
+ * Decode an event trace written by ns3::EventTrace, one output per event
+ * type named <output>-<component>-<event>:
+ *
+ *  - by default a CSV file (.csv) with a header line, the time in the
+ *    unit of the simulation (e.g. time_ns), the node and the fields;
+ *  - with --columnar, one file per column holding the raw values in the
+ *    byte order of the machine (.<column>), and a .columns file listing
+ *    the columns and their numpy type, e.g. for numpy.fromfile.
+ */
+
+#include <cerrno>
+#include <cinttypes>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <vector>
+
+#include "ns3/core-module.h"
+
+using namespace ns3;
+
+/** The outputs of an event type. */
+struct Output
+{
+  const EventTrace::Type *type;  //!< The event type.
+  std::vector<FILE *> files;     //!< The CSV file, or a file per column.
+};
+
+/**
+ * \param [in] unit A time unit.
+ * \return Its suffix.
+ */
+static std::string
+UnitName (Time::Unit unit)
+{
+  static const char *names[] = { "y", "d", "h", "min", "s", "ms", "us", "ns", "ps", "fs" };
+  return names[unit];
+}
+
+/**
+ * \param [in] filename The file name.
+ * \param [in] mode The fopen mode.
+ * \return The open file.
+ */
+static FILE *
+OpenOutput (std::string filename, const char *mode)
+{
+  FILE *file = std::fopen (filename.c_str (), mode);
+  if (file == 0)
+    {
+      std::cerr << "Unable to open " << filename << ": " << std::strerror (errno) << std::endl;
+      std::exit (1);
+    }
+  return file;
+}
+
+/**
+ * Open the outputs of an event type and write their headers.
+ * \param [in] prefix The prefix of the file names.
+ * \param [in] type The event type.
+ * \param [in] unit The time unit.
+ * \param [in] columnar Whether to write a file per column.
+ * \return The outputs.
+ */
+static Output
+OpenOutputs (std::string prefix, const EventTrace::Type *type, Time::Unit unit, bool columnar)
+{
+  Output output;
+  output.type = type;
+  std::string base = prefix + "-" + type->componentName + "-" + type->name;
+  std::string time = "time_" + UnitName (unit);
+  if (!columnar)
+    {
+      FILE *file = OpenOutput (base + ".csv", "w");
+      std::fprintf (file, "%s,node", time.c_str ());
+      for (uint32_t i = 0; i < type->fields.size (); i++)
+        {
+          std::fprintf (file, ",%s", type->fields[i].name.c_str ());
+        }
+      std::fprintf (file, "\n");
+      output.files.push_back (file);
+      return output;
+    }
+
+  FILE *columns = OpenOutput (base + ".columns", "w");
+  std::fprintf (columns, "%s int64\nnode uint32\n", time.c_str ());
+  output.files.push_back (OpenOutput (base + "." + time, "wb"));
+  output.files.push_back (OpenOutput (base + ".node", "wb"));
+  for (uint32_t i = 0; i < type->fields.size (); i++)
+    {
+      const EventTrace::Field &field = type->fields[i];
+      std::fprintf (columns, "%s %s\n", field.name.c_str (),
+                    field.kind == 'i' ? "int64" : field.kind == 'u' ? "uint64" : "float64");
+      output.files.push_back (OpenOutput (base + "." + field.name, "wb"));
+    }
+  std::fclose (columns);
+  return output;
+}
+
+/**
+ * \param [in] output The outputs of the event type of the record.
+ * \param [in] record The record.
+ */
+static void
+WriteCsv (const Output &output, const EventTrace::Record &record)
+{
+  FILE *file = output.files[0];
+  std::fprintf (file, "%" PRId64 ",%" PRIu32, record.time, record.node);
+  for (uint32_t i = 0; i < output.type->fields.size (); i++)
+    {
+      uint64_t bits = record.fields[i];
+      switch (output.type->fields[i].kind)
+        {
+        case 'i':
+          std::fprintf (file, ",%" PRId64, static_cast<int64_t> (bits));
+          break;
+        case 'u':
+          std::fprintf (file, ",%" PRIu64, bits);
+          break;
+        default:
+          {
+            double value;
+            std::memcpy (&value, &bits, sizeof (value));
+            std::fprintf (file, ",%.17g", value);
+          }
+        }
+    }
+  std::fprintf (file, "\n");
+}
+
+/**
+ * \param [in] output The outputs of the event type of the record.
+ * \param [in] record The record.
+ */
+static void
+WriteColumns (const Output &output, const EventTrace::Record &record)
+{
+  std::fwrite (&record.time, sizeof (record.time), 1, output.files[0]);
+  std::fwrite (&record.node, sizeof (record.node), 1, output.files[1]);
+  for (uint32_t i = 0; i < output.type->fields.size (); i++)
+    {
+      std::fwrite (&record.fields[i], sizeof (record.fields[i]), 1, output.files[2 + i]);
+    }
+}
+
+int main (int argc, char *argv[])
+{
+  std::string input;
+  std::string prefix;
+  bool columnar = false;
+
+  CommandLine cmd;
+  cmd.Usage ("Decode an event trace to a CSV file, or to a file per column, per event type.");
+  cmd.AddValue ("input", "the event trace", input);
+  cmd.AddValue ("output", "the prefix of the output files (default: the input)", prefix);
+  cmd.AddValue ("columnar", "write a binary file per column rather than CSV", columnar);
+  cmd.Parse (argc, argv);
+
+  if (input == "")
+    {
+      std::cerr << "No --input" << std::endl;
+      return 1;
+    }
+  if (prefix == "")
+    {
+      prefix = input;
+    }
+
+  EventTraceReader reader;
+  if (!reader.Open (input))
+    {
+      std::cerr << "Unable to read the event trace " << input << std::endl;
+      return 1;
+    }
+
+  std::map<uint16_t, Output> outputs;
+  EventTrace::Record record;
+  uint64_t nRecords = 0;
+  while (reader.Read (record))
+    {
+      std::map<uint16_t, Output>::iterator i = outputs.find (record.type);
+      if (i == outputs.end ())
+        {
+          const EventTrace::Type *type = reader.GetType (record.type);
+          if (type == 0)
+            {
+              std::cerr << "Record of unknown event type " << record.type << std::endl;
+              return 1;
+            }
+          i = outputs.insert (std::make_pair (record.type,
+                                              OpenOutputs (prefix, type, reader.GetResolution (),
+                                                           columnar))).first;
+        }
+      if (columnar)
+        {
+          WriteColumns (i->second, record);
+        }
+      else
+        {
+          WriteCsv (i->second, record);
+        }
+      nRecords++;
+    }
+
+  for (std::map<uint16_t, Output>::iterator i = outputs.begin (); i != outputs.end (); i++)
+    {
+      for (uint32_t j = 0; j < i->second.files.size (); j++)
+        {
+          std::fclose (i->second.files[j]);
+        }
+      std::cout << i->second.type->componentName << "/" << i->second.type->name << std::endl;
+    }
+  std::cout << nRecords << " records" << std::endl;
+  return 0;
+}